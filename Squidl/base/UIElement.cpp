@@ -1,13 +1,137 @@
 // squidl/base/UIElement.cpp
 #include "Squidl/base/UIElement.h"
+#include "Squidl/renderers/QuadBatch.h" // For QuadBatch::destroyTexture
 #include "Squidl/utils/Logger.h" // For logging
 
 namespace Squidl::Base {
 
+    namespace {
+        std::uint32_t geometryGeneration = 0;
+        std::uint32_t captureGeneration = 0;
+    } // namespace
+
+    std::uint32_t UIElement::getGeometryGeneration() {
+        return geometryGeneration;
+    }
+
+    std::uint32_t UIElement::getCaptureGeneration() {
+        return captureGeneration;
+    }
+
+    void UIElement::setPointerCapture(bool value) {
+        if (pointerCapture != value) {
+            pointerCapture = value;
+            ++captureGeneration;
+        }
+    }
 
     void UIElement::setRect(const Squidl::Utils::UIRect &newRect) {
+        const Squidl::Utils::UIRect oldRect = rect;
         rect = newRect;
         applyConstraints(); // Apply constraints after setting new rect
+        rectChanged(oldRect);
+        layoutValid = true; // Leaf elements have nothing else to arrange
+    }
+
+    void UIElement::rectChanged(const Squidl::Utils::UIRect &oldRect) {
+        if (rect != oldRect) {
+            ++geometryGeneration;
+            invalidateRect(oldRect);
+            invalidateRect(rect);
+        }
+    }
+
+    UIElement::~UIElement() {
+        if (layerTexture)
+            Squidl::Renderers::QuadBatch::destroyTexture(layerTexture);
+    }
+
+    bool UIElement::draw(Squidl::Core::UIContext &ctx,
+                         Squidl::Core::IRenderer &renderer) {
+        if (!cachedLayer || layerDrawing)
+            return update(ctx, renderer);
+        if (!renderer.isRectVisible(rect))
+            return layerResult;
+
+        if (layerTexture && (layerSize.w != rect.w || layerSize.h != rect.h)) {
+            Squidl::Renderers::QuadBatch::destroyTexture(layerTexture);
+            layerTexture = nullptr;
+        }
+        if (!layerTexture) {
+            layerTexture = renderer.createLayerTexture(rect.w, rect.h);
+            layerSize = {rect.w, rect.h};
+            layerValid = false;
+            if (!layerTexture)
+                return update(ctx, renderer); // Draw directly instead
+        }
+
+        if (!layerValid) {
+            if (!renderer.beginLayer(layerTexture, rect))
+                return update(ctx, renderer);
+            layerDrawing = true;
+            layerResult = update(ctx, renderer);
+            layerDrawing = false;
+            renderer.endLayer();
+            layerValid = true;
+        }
+
+        const SDL_Rect dest = rect;
+        renderer.drawTexture(layerTexture, nullptr, &dest);
+        return layerResult;
+    }
+
+    void UIElement::setCachedLayer(bool value) {
+        if (cachedLayer == value)
+            return;
+        cachedLayer = value;
+        layerValid = false;
+        if (!value && layerTexture) {
+            Squidl::Renderers::QuadBatch::destroyTexture(layerTexture);
+            layerTexture = nullptr;
+        }
+        invalidate();
+    }
+
+    Squidl::Utils::Size UIElement::measure() {
+        if (!measureValid) {
+            autosize();
+            desiredSize = {rect.w, rect.h};
+            measureValid = true;
+        }
+        return desiredSize;
+    }
+
+    void UIElement::invalidateMeasure() {
+        measureValid = false;
+        layoutValid = false;
+        if (auto p = getParent())
+            p->invalidateMeasure();
+    }
+
+    void UIElement::invalidateRect(const Squidl::Utils::UIRect &area) {
+        if (area.isEmpty())
+            return;
+        if (!layerDrawing)
+            layerValid = false;
+        if (auto p = getParent()) {
+            p->invalidateRect(area);
+        } else {
+            damage = damage.united(area);
+        }
+    }
+
+    bool UIElement::isPointVisible(int x, int y) const {
+        for (auto p = getParent(); p; p = p->getParent()) {
+            if (p->clipsChildren() && !p->getRect().contains(x, y))
+                return false;
+        }
+        return true;
+    }
+
+    Squidl::Utils::UIRect UIElement::takeDamage() {
+        Squidl::Utils::UIRect taken = damage;
+        damage = Squidl::Utils::UIRect();
+        return taken;
     }
 
     Squidl::Utils::UIRect UIElement::getLocalRect() const {
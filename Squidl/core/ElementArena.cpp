@@ -0,0 +1,104 @@
+// squidl/core/ElementArena.cpp
+#include "Squidl/core/ElementArena.h"
+#include "Squidl/utils/Logger.h" // For logging
+#include <new>                   // For ::operator new with alignment
+
+namespace Squidl::Core {
+
+    namespace {
+        thread_local ElementArena *g_currentArena = nullptr;
+    } // namespace
+
+    std::shared_ptr<ElementArena> ElementArena::create(std::size_t blockSize) {
+        // Конструктор закрыт, поэтому не make_shared
+        return std::shared_ptr<ElementArena>(new ElementArena(blockSize));
+    }
+
+    ElementArena::ElementArena(std::size_t blockSize)
+        : m_blockSize(blockSize < MaxPooledSize ? MaxPooledSize : blockSize) {
+        // Начало блока выровнено по Granularity, размер блока тоже
+        m_blockSize = (m_blockSize + Granularity - 1) / Granularity * Granularity;
+    }
+
+    ElementArena::~ElementArena() {
+        if (m_bytesInUse != 0) {
+            // Не должно случаться: каждый элемент держит пул через аллокатор
+            SQUIDL_LOG_ERROR << "ElementArena: Destroyed with " << m_bytesInUse
+                             << " bytes still in use.";
+        }
+        if (g_currentArena == this)
+            g_currentArena = nullptr;
+    }
+
+    void *ElementArena::allocate(std::size_t size, std::size_t alignment) {
+        if (!isPooled(size, alignment)) {
+            ++m_allocations;
+            if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+                return ::operator new(size, std::align_val_t(alignment));
+            return ::operator new(size);
+        }
+
+        const std::size_t cls = size == 0 ? 0 : (size - 1) / Granularity;
+        const std::size_t rounded = (cls + 1) * Granularity;
+        ++m_allocations;
+        m_bytesInUse += rounded;
+
+        if (FreeNode *node = m_freeLists[cls]) {
+            m_freeLists[cls] = node->next;
+            return node;
+        }
+
+        if (m_remaining < rounded) {
+            // Остаток текущего блока раздаём в списки, чтобы не терять его
+            while (m_remaining >= Granularity) {
+                const std::size_t piece =
+                    m_remaining > MaxPooledSize ? MaxPooledSize : m_remaining;
+                const std::size_t pieceClass = piece / Granularity - 1;
+                auto *spare = reinterpret_cast<FreeNode *>(m_cursor);
+                spare->next = m_freeLists[pieceClass];
+                m_freeLists[pieceClass] = spare;
+                m_cursor += (pieceClass + 1) * Granularity;
+                m_remaining -= (pieceClass + 1) * Granularity;
+            }
+            // new[] выделяет с выравниванием не меньше Granularity
+            static_assert(__STDCPP_DEFAULT_NEW_ALIGNMENT__ >= Granularity);
+            m_blocks.emplace_back(new unsigned char[m_blockSize]);
+            m_cursor = m_blocks.back().get();
+            m_remaining = m_blockSize;
+            m_bytesReserved += m_blockSize;
+        }
+
+        void *p = m_cursor;
+        m_cursor += rounded;
+        m_remaining -= rounded;
+        return p;
+    }
+
+    void ElementArena::deallocate(void *p, std::size_t size,
+                                  std::size_t alignment) noexcept {
+        if (!p)
+            return;
+        if (!isPooled(size, alignment)) {
+            if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+                ::operator delete(p, std::align_val_t(alignment));
+            else
+                ::operator delete(p);
+            return;
+        }
+        const std::size_t cls = size == 0 ? 0 : (size - 1) / Granularity;
+        m_bytesInUse -= (cls + 1) * Granularity;
+        auto *node = static_cast<FreeNode *>(p);
+        node->next = m_freeLists[cls];
+        m_freeLists[cls] = node;
+    }
+
+    ElementArena *ElementArena::current() { return g_currentArena; }
+
+    ElementArena::Scope::Scope(ElementArena &arena)
+        : m_previous(g_currentArena) {
+        g_currentArena = &arena;
+    }
+
+    ElementArena::Scope::~Scope() { g_currentArena = m_previous; }
+
+} // namespace Squidl::Core
@@ -0,0 +1,214 @@
+// squidl/core/ElementStore.cpp
+#include "Squidl/core/ElementStore.h"
+#include "Squidl/utils/Logger.h"   // For logging
+#include "Squidl/utils/Profiler.h" // For SQUIDL_PROFILE_ZONE
+#include <algorithm>               // For std::clamp
+#include <utility>                 // For std::move
+
+namespace Squidl::Core {
+
+    using Squidl::Utils::Color;
+    using Squidl::Utils::UIRect;
+
+    ElementId ElementStore::add(ElementId parent, const UIRect &localRect) {
+        if (parent != InvalidElementId && !contains(parent)) {
+            SQUIDL_LOG_ERROR << "ElementStore: Unknown parent " << parent
+                             << ".";
+            return InvalidElementId;
+        }
+        const auto id = static_cast<ElementId>(m_parents.size());
+        m_parents.push_back(parent);
+        m_localRects.push_back(localRect);
+        m_worldRects.emplace_back();
+        m_bgColors.push_back({100, 100, 100, 255});
+        m_borderColors.push_back({0, 0, 0, 255});
+        m_textColors.push_back({0, 0, 0, 255});
+        m_opacity.push_back(1.0f);
+        m_effectiveOpacity.push_back(1.0f);
+        m_flags.push_back(static_cast<std::uint8_t>(FlatFlags::Visible |
+                                                    FlatFlags::Dirty));
+        m_texts.emplace_back();
+        m_textSizes.emplace_back(-1, -1);
+        m_layoutDirty = true;
+        return id;
+    }
+
+    void ElementStore::reserve(std::size_t count) {
+        m_parents.reserve(count);
+        m_localRects.reserve(count);
+        m_worldRects.reserve(count);
+        m_bgColors.reserve(count);
+        m_borderColors.reserve(count);
+        m_textColors.reserve(count);
+        m_opacity.reserve(count);
+        m_effectiveOpacity.reserve(count);
+        m_flags.reserve(count);
+        m_texts.reserve(count);
+        m_textSizes.reserve(count);
+    }
+
+    void ElementStore::clear() {
+        m_damage = m_damage.united(getBounds());
+        m_parents.clear();
+        m_localRects.clear();
+        m_worldRects.clear();
+        m_bgColors.clear();
+        m_borderColors.clear();
+        m_textColors.clear();
+        m_opacity.clear();
+        m_effectiveOpacity.clear();
+        m_flags.clear();
+        m_texts.clear();
+        m_textSizes.clear();
+        m_layoutDirty = false;
+    }
+
+    void ElementStore::markDirty(ElementId id) {
+        m_flags[id] |= static_cast<std::uint8_t>(FlatFlags::Dirty);
+        m_layoutDirty = true;
+    }
+
+    void ElementStore::setLocalRect(ElementId id, const UIRect &rect) {
+        if (contains(id) && m_localRects[id] != rect) {
+            m_localRects[id] = rect;
+            markDirty(id);
+        }
+    }
+
+    void ElementStore::setBackgroundColor(ElementId id, Color color) {
+        if (contains(id) && m_bgColors[id] != color) {
+            m_bgColors[id] = color;
+            markDirty(id);
+        }
+    }
+
+    void ElementStore::setBorderColor(ElementId id, Color color) {
+        if (contains(id) && m_borderColors[id] != color) {
+            m_borderColors[id] = color;
+            markDirty(id);
+        }
+    }
+
+    void ElementStore::setTextColor(ElementId id, Color color) {
+        if (contains(id) && m_textColors[id] != color) {
+            m_textColors[id] = color;
+            markDirty(id);
+        }
+    }
+
+    void ElementStore::setOpacity(ElementId id, float opacity) {
+        opacity = std::clamp(opacity, 0.0f, 1.0f);
+        if (contains(id) && m_opacity[id] != opacity) {
+            m_opacity[id] = opacity;
+            markDirty(id);
+        }
+    }
+
+    void ElementStore::setVisible(ElementId id, bool visible) {
+        if (contains(id) && hasFlag(m_flags[id], FlatFlags::Visible) != visible) {
+            m_flags[id] ^= static_cast<std::uint8_t>(FlatFlags::Visible);
+            markDirty(id);
+        }
+    }
+
+    void ElementStore::setBorder(ElementId id, bool border) {
+        if (contains(id) && hasFlag(m_flags[id], FlatFlags::Border) != border) {
+            m_flags[id] ^= static_cast<std::uint8_t>(FlatFlags::Border);
+            markDirty(id);
+        }
+    }
+
+    void ElementStore::setText(ElementId id, std::string text) {
+        if (contains(id) && m_texts[id] != text) {
+            m_texts[id] = std::move(text);
+            m_textSizes[id] = {-1, -1};
+            markDirty(id);
+        }
+    }
+
+    void ElementStore::arrangeGrid(ElementId first, std::size_t count,
+                                   int columns, Squidl::Utils::Size cell,
+                                   int spacing, Squidl::Utils::Point offset) {
+        if (!contains(first) || count > size() - first) {
+            SQUIDL_LOG_ERROR << "ElementStore: arrangeGrid range out of bounds.";
+            return;
+        }
+        columns = std::max(1, columns);
+        for (std::size_t i = 0; i < count; ++i) {
+            const int col = static_cast<int>(i % columns);
+            const int row = static_cast<int>(i / columns);
+            setLocalRect(first + static_cast<ElementId>(i),
+                         {offset.x + col * (cell.w + spacing),
+                          offset.y + row * (cell.h + spacing), cell.w,
+                          cell.h});
+        }
+    }
+
+    void ElementStore::updateLayout(Squidl::Utils::Point origin) {
+        if (!m_layoutDirty && origin.x == m_origin.x && origin.y == m_origin.y)
+            return;
+        SQUIDL_PROFILE_ZONE("ElementStore::updateLayout");
+        m_origin = origin;
+
+        constexpr auto shownBit = static_cast<std::uint8_t>(FlatFlags::Shown);
+        constexpr auto dirtyBit = static_cast<std::uint8_t>(FlatFlags::Dirty);
+        const std::size_t count = m_parents.size();
+        for (std::size_t i = 0; i < count; ++i) {
+            const ElementId parent = m_parents[i];
+            const UIRect &local = m_localRects[i];
+            UIRect world;
+            bool shown = hasFlag(m_flags[i], FlatFlags::Visible);
+            float alpha = m_opacity[i];
+            // Родитель предшествует ребёнку, его значения уже посчитаны
+            if (parent == InvalidElementId) {
+                world = {origin.x + local.x, origin.y + local.y, local.w,
+                         local.h};
+            } else {
+                const UIRect &p = m_worldRects[parent];
+                world = {p.x + local.x, p.y + local.y, local.w, local.h};
+                shown = shown && (m_flags[parent] & shownBit) != 0;
+                alpha *= m_effectiveOpacity[parent];
+            }
+
+            const std::uint8_t flags = m_flags[i];
+            const bool wasShown = (flags & shownBit) != 0;
+            if ((flags & dirtyBit) || wasShown != shown ||
+                world != m_worldRects[i] || alpha != m_effectiveOpacity[i]) {
+                if (wasShown)
+                    m_damage = m_damage.united(m_worldRects[i]);
+                if (shown)
+                    m_damage = m_damage.united(world);
+            }
+            m_worldRects[i] = world;
+            m_effectiveOpacity[i] = alpha;
+            m_flags[i] = static_cast<std::uint8_t>(
+                (flags & ~(shownBit | dirtyBit)) | (shown ? shownBit : 0));
+        }
+        m_layoutDirty = false;
+    }
+
+    ElementId ElementStore::hitTest(int x, int y) const {
+        constexpr auto shownBit = static_cast<std::uint8_t>(FlatFlags::Shown);
+        for (std::size_t i = m_parents.size(); i-- > 0;) {
+            if ((m_flags[i] & shownBit) && m_worldRects[i].contains(x, y))
+                return static_cast<ElementId>(i);
+        }
+        return InvalidElementId;
+    }
+
+    UIRect ElementStore::takeDamage() {
+        const UIRect result = m_damage;
+        m_damage = UIRect();
+        return result;
+    }
+
+    UIRect ElementStore::getBounds() const {
+        UIRect bounds;
+        for (std::size_t i = 0; i < m_parents.size(); ++i) {
+            if (hasFlag(m_flags[i], FlatFlags::Shown))
+                bounds = bounds.united(m_worldRects[i]);
+        }
+        return bounds;
+    }
+
+} // namespace Squidl::Core
@@ -1,9 +1,18 @@
 // squidl/core/EventDispatcher.cpp
 #include "Squidl/core/EventDispatcher.h"
-#include "Squidl/utils/Logger.h" // For logging
+#include "Squidl/utils/Logger.h"   // For logging
+#include "Squidl/utils/Profiler.h" // For SQUIDL_PROFILE_ZONE
+#include <algorithm>               // For std::sort, std::unique
+#include <functional>              // For std::greater
 
 namespace Squidl::Core {
 
+    namespace {
+        constexpr EventType BucketTypes[] = {
+            EventType::MouseEvent, EventType::KeyboardEvent,
+            EventType::TextInputEvent, EventType::ResizeEvent};
+    } // namespace
+
     EventDispatcher::EventDispatcher() {
         SQUIDL_LOG_DEBUG << "EventDispatcher: Initialized.";
     }
@@ -16,18 +25,24 @@ namespace Squidl::Core {
             return;
         }
         // Проверяем, не добавлен ли уже этот элемент
-        for (const auto &listener_weak_ptr : listeners) {
-            if (auto listener_shared_ptr = listener_weak_ptr.lock()) {
-                if (listener_shared_ptr == element) {
-                    SQUIDL_LOG_DEBUG << "EventDispatcher: element already added as listener.";
-                    return;
-                }
-            }
+        auto found = registered.find(element.get());
+        if (found != registered.end() && !found->second.expired()) {
+            SQUIDL_LOG_DEBUG
+                << "EventDispatcher: element already added as listener.";
+            return;
         }
-        listeners.push_back(element);
-        SQUIDL_LOG_DEBUG
-            << "EventDispatcher: Element added as listener. Total number of listeners: "
-            << listeners.size();
+        registered[element.get()] = element;
+
+        const EventMask mask = element->getEventMask();
+        for (EventType type : BucketTypes) {
+            if (hasFlag(mask, toEventMask(type)))
+                buckets[type].elements.push_back(element);
+        }
+        if (hasFlag(mask, EventMask::Mouse))
+            mouseListenersChanged();
+        SQUIDL_LOG_DEBUG << "EventDispatcher: Element added as listener. "
+                            "Total number of listeners: "
+                         << registered.size();
     }
 
     void EventDispatcher::removeListener(
@@ -37,49 +52,314 @@ namespace Squidl::Core {
                 << "EventDispatcher: Trying to remove undefined listener.";
             return;
         }
-        listeners.erase(
-            std::remove_if(listeners.begin(), listeners.end(),
-                           [&](const std::weak_ptr<Squidl::Base::UIElement>
-                                   &listener_weak_ptr) {
-                               if (auto listener_shared_ptr =
-                                       listener_weak_ptr.lock()) {
-                                   return listener_shared_ptr == element;
-                               }
-                               return true; // Удаляем "мертвые" указатели сразу
-                           }),
-            listeners.end());
+        if (focus.lock() == element)
+            clearFocus();
+
+        registered.erase(element.get());
+        for (auto &[type, bucket] : buckets) {
+            auto &elements = bucket.elements;
+            elements.erase(
+                std::remove_if(elements.begin(), elements.end(),
+                               [&](const std::weak_ptr<Squidl::Base::UIElement>
+                                       &listener_weak_ptr) {
+                                   if (auto listener_shared_ptr =
+                                           listener_weak_ptr.lock()) {
+                                       return listener_shared_ptr == element;
+                                   }
+                                   return true; // Удаляем "мертвые" указатели
+                                                // сразу
+                               }),
+                elements.end());
+            bucket.hasExpired = false;
+        }
+        mouseListenersChanged();
         SQUIDL_LOG_DEBUG
             << "EventDispatcher: LIstener removed. Total number of listeners: "
-            << listeners.size();
+            << registered.size();
+    }
+
+    void EventDispatcher::setFocus(
+        std::shared_ptr<Squidl::Base::UIElement> element) {
+        auto previous = focus.lock();
+        if (previous == element)
+            return;
+        if (element && !element->isFocusable()) {
+            SQUIDL_LOG_WARNING
+                << "EventDispatcher: Element can not receive focus.";
+            return;
+        }
+        focus = element;
+        if (previous)
+            previous->onFocusChanged(false);
+        if (element)
+            element->onFocusChanged(true);
     }
 
     void EventDispatcher::dispatchEvent(UIEvent &event) {
-        cleanupListeners(); // Очищаем мертвые указатели перед рассылкой
+        SQUIDL_PROFILE_ZONE_OBJ("EventDispatcher::dispatchEvent", this);
+        if (event.type == EventType::MouseEvent) {
+            dispatchMouseEvent(static_cast<MouseEvent &>(event));
+            return;
+        }
 
+        auto found = buckets.find(event.type);
+        if (found == buckets.end())
+            return; // Никто не подписан на этот тип событий
+
+        // Клавиатура и текст идут сразу элементу в фокусе
+        if (event.type == EventType::KeyboardEvent ||
+            event.type == EventType::TextInputEvent) {
+            if (auto focused = focus.lock()) {
+                if (hasFlag(focused->getEventMask(), toEventMask(event.type)))
+                    focused->onEvent(event);
+                return;
+            }
+        }
+
+        dispatchToBucket(event, found->second);
+        cleanupBucket(event.type, found->second);
+    }
+
+    void EventDispatcher::dispatchToBucket(UIEvent &event, Bucket &bucket) {
         // Проходим по слушателям в обратном порядке, чтобы элементы,
         // которые находятся поверх других, могли обработать событие первыми.
         // Это важно для корректной обработки кликов (например, кнопка поверх
         // фона).
-        for (auto it = listeners.rbegin(); it != listeners.rend(); ++it) {
+        // Обработчики могут добавлять и удалять слушателей, поэтому
+        // получатели фиксируются до рассылки
+        auto receivers = takeDeliveryBuffer();
+        const auto &elements = bucket.elements;
+        for (auto it = elements.rbegin(); it != elements.rend(); ++it) {
+            if (auto listener_shared_ptr = it->lock()) {
+                receivers.push_back(std::move(listener_shared_ptr));
+            } else {
+                bucket.hasExpired = true;
+            }
+        }
+        deliver(event, receivers);
+        returnDeliveryBuffer(std::move(receivers));
+    }
+
+    std::size_t EventDispatcher::deliver(
+        UIEvent &event,
+        const std::vector<std::shared_ptr<Squidl::Base::UIElement>>
+            &receivers) {
+        std::size_t delivered = 0;
+        for (const auto &listener : receivers) {
             if (event.handled) { // Если событие уже обработано, прекращаем
                                  // рассылку
                 break;
             }
-            if (auto listener_shared_ptr = it->lock()) {
-                listener_shared_ptr->onEvent(event);
-            }
+            // Удалённые во время рассылки элементы событие уже не получают
+            if (registered.find(listener.get()) == registered.end())
+                continue;
+            listener->onEvent(event);
+            ++delivered;
         }
+        return delivered;
     }
 
-    void EventDispatcher::cleanupListeners() {
-        listeners.erase(
-            std::remove_if(listeners.begin(), listeners.end(),
+    std::vector<std::shared_ptr<Squidl::Base::UIElement>>
+    EventDispatcher::takeDeliveryBuffer() {
+        // Вложенная рассылка из обработчика получит пустой буфер
+        auto buffer = std::move(deliveryBuffer);
+        deliveryBuffer.clear();
+        return buffer;
+    }
+
+    void EventDispatcher::returnDeliveryBuffer(
+        std::vector<std::shared_ptr<Squidl::Base::UIElement>> buffer) {
+        buffer.clear();
+        if (buffer.capacity() > deliveryBuffer.capacity())
+            deliveryBuffer = std::move(buffer);
+    }
+
+    void EventDispatcher::cleanupBucket(EventType type, Bucket &bucket) {
+        if (!bucket.hasExpired)
+            return;
+        bucket.hasExpired = false;
+        auto &elements = bucket.elements;
+        elements.erase(
+            std::remove_if(elements.begin(), elements.end(),
                            [](const std::weak_ptr<Squidl::Base::UIElement>
                                   &listener_weak_ptr) {
                                return listener_weak_ptr
                                    .expired(); // Удаляем просроченные weak_ptr
                            }),
-            listeners.end());
+            elements.end());
+        for (auto it = registered.begin(); it != registered.end();) {
+            it = it->second.expired() ? registered.erase(it) : std::next(it);
+        }
+        // Индексы в сетке ссылаются на позиции в корзине мыши
+        if (type == EventType::MouseEvent)
+            mouseListenersChanged();
+    }
+
+    void EventDispatcher::dispatchMouseEvent(MouseEvent &event) {
+        Bucket &mouse = buckets[EventType::MouseEvent];
+        auto &listeners = mouse.elements;
+
+        if (gridDirty ||
+            gridGeneration != Squidl::Base::UIElement::getGeometryGeneration())
+            rebuildHitGrid();
+        if (capturedDirty || capturedGeneration !=
+                                 Squidl::Base::UIElement::getCaptureGeneration())
+            rebuildCaptured();
+
+        collectHits(event.position.x, event.position.y, hits);
+        // Нажатие кнопки мыши переносит фокус до доставки события
+        if (event.mouseEventType == MouseEventType::ButtonPressed)
+            updateFocusOnPress();
+
+        // Кандидаты: элементы под курсором, с захватом указателя и бывшие
+        // под курсором (им нужно увидеть уход мыши)
+        targets.assign(hits.begin(), hits.end());
+        targets.insert(targets.end(), captured.begin(), captured.end());
+        if (hoveredStale) {
+            hoveredIndices.clear();
+            for (std::uint32_t i = 0; i < listeners.size(); ++i) {
+                auto element = listeners[i].lock();
+                for (const auto &weak : hovered) {
+                    if (element && weak.lock() == element) {
+                        hoveredIndices.push_back(i);
+                        break;
+                    }
+                }
+            }
+            hoveredStale = false;
+        }
+        targets.insert(targets.end(), hoveredIndices.begin(),
+                       hoveredIndices.end());
+
+        // Сохраняем прежний порядок: последние добавленные слушатели (те,
+        // что лежат поверх) получают событие первыми
+        std::sort(targets.begin(), targets.end(), std::greater<>());
+        targets.erase(std::unique(targets.begin(), targets.end()),
+                      targets.end());
+
+        hovered.clear();
+        for (std::uint32_t index : hits) {
+            hovered.push_back(listeners[index]);
+        }
+        hoveredIndices.assign(hits.begin(), hits.end());
+
+        // Индексы перестают быть верными, если обработчик изменит список
+        // слушателей, поэтому получатели фиксируются до рассылки
+        auto receivers = takeDeliveryBuffer();
+        for (std::uint32_t index : targets) {
+            if (auto listener_shared_ptr = listeners[index].lock()) {
+                receivers.push_back(std::move(listener_shared_ptr));
+            } else {
+                mouse.hasExpired = true;
+            }
+        }
+        lastMouseTargets = deliver(event, receivers);
+        returnDeliveryBuffer(std::move(receivers));
+        cleanupBucket(EventType::MouseEvent, mouse);
+    }
+
+    void EventDispatcher::updateFocusOnPress() {
+        const auto &listeners = buckets[EventType::MouseEvent].elements;
+        // hits отсортированы не по порядку, ищем верхний фокусируемый
+        std::shared_ptr<Squidl::Base::UIElement> target;
+        std::uint32_t targetIndex = 0;
+        for (std::uint32_t index : hits) {
+            auto element = listeners[index].lock();
+            if (element && element->isFocusable() &&
+                (!target || index > targetIndex)) {
+                target = element;
+                targetIndex = index;
+            }
+        }
+        setFocus(target);
+    }
+
+    void EventDispatcher::rebuildHitGrid() {
+        const auto &listeners = buckets[EventType::MouseEvent].elements;
+        gridDirty = false;
+        gridGeneration = Squidl::Base::UIElement::getGeometryGeneration();
+        gridCells.clear();
+        largeElements.clear();
+
+        std::vector<Squidl::Utils::UIRect> rects(listeners.size());
+        gridBounds = Squidl::Utils::UIRect();
+        for (std::size_t i = 0; i < listeners.size(); ++i) {
+            if (auto element = listeners[i].lock()) {
+                rects[i] = element->getRect();
+                gridBounds = gridBounds.united(rects[i]);
+            }
+        }
+        if (gridBounds.isEmpty()) {
+            gridCols = gridRows = 0;
+            return;
+        }
+
+        // Увеличиваем ячейку, пока сетка не уложится в лимит
+        cellSize = 64;
+        while (static_cast<long long>((gridBounds.w + cellSize - 1) /
+                                      cellSize) *
+                   ((gridBounds.h + cellSize - 1) / cellSize) >
+               MaxGridCells) {
+            cellSize *= 2;
+        }
+        gridCols = (gridBounds.w + cellSize - 1) / cellSize;
+        gridRows = (gridBounds.h + cellSize - 1) / cellSize;
+        gridCells.resize(static_cast<std::size_t>(gridCols) * gridRows);
+
+        for (std::uint32_t i = 0; i < rects.size(); ++i) {
+            const Squidl::Utils::UIRect &r = rects[i];
+            if (r.isEmpty())
+                continue; // В пустой прямоугольник нельзя попасть
+            const int c0 = (r.x - gridBounds.x) / cellSize;
+            const int r0 = (r.y - gridBounds.y) / cellSize;
+            const int c1 = (r.x + r.w - 1 - gridBounds.x) / cellSize;
+            const int r1 = (r.y + r.h - 1 - gridBounds.y) / cellSize;
+            if ((c1 - c0 + 1) * (r1 - r0 + 1) > MaxCellsPerElement) {
+                largeElements.push_back(i);
+                continue;
+            }
+            for (int row = r0; row <= r1; ++row)
+                for (int col = c0; col <= c1; ++col)
+                    gridCells[row * gridCols + col].push_back(i);
+        }
+        SQUIDL_LOG_DEBUG << "EventDispatcher: Hit grid rebuilt (" << gridCols
+                         << "x" << gridRows << " cells of " << cellSize
+                         << "px, " << largeElements.size()
+                         << " large elements).";
+    }
+
+    void EventDispatcher::rebuildCaptured() {
+        const auto &listeners = buckets[EventType::MouseEvent].elements;
+        capturedDirty = false;
+        capturedGeneration = Squidl::Base::UIElement::getCaptureGeneration();
+        captured.clear();
+        for (std::uint32_t i = 0; i < listeners.size(); ++i) {
+            auto element = listeners[i].lock();
+            if (element && element->hasPointerCapture())
+                captured.push_back(i);
+        }
+    }
+
+    void EventDispatcher::collectHits(int x, int y,
+                                      std::vector<std::uint32_t> &out) {
+        const auto &listeners = buckets[EventType::MouseEvent].elements;
+        out.clear();
+        // Ячейки грубые, поэтому каждый кандидат проверяется по
+        // актуальному прямоугольнику
+        const auto test = [&](std::uint32_t index) {
+            auto element = listeners[index].lock();
+            if (element && element->getRect().contains(x, y) &&
+                element->isPointVisible(x, y))
+                out.push_back(index);
+        };
+        for (std::uint32_t index : largeElements)
+            test(index);
+        if (gridCols > 0 && gridBounds.contains(x, y)) {
+            const int col = (x - gridBounds.x) / cellSize;
+            const int row = (y - gridBounds.y) / cellSize;
+            for (std::uint32_t index : gridCells[row * gridCols + col])
+                test(index);
+        }
     }
 
 } // namespace Squidl::Core
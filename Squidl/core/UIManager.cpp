@@ -6,6 +6,7 @@
 #include "Squidl/renderers/SDL2Renderer.h" // For concrete SDL2Renderer
 #include "Squidl/utils/Color.h"            // For Squidl::Utils::Color
 #include "Squidl/utils/Logger.h"           // For logging
+#include "Squidl/utils/Profiler.h"         // For SQUIDL_PROFILE_ZONE
 
 namespace Squidl::Core {
 
@@ -15,6 +16,7 @@ namespace Squidl::Core {
 
     UIManager::~UIManager() {
         SQUIDL_LOG_DEBUG << "UIManager: Деинициализация.";
+        releaseCanvas();
         // m_uiRenderer будет удален автоматически unique_ptr
         // m_rootElement будет удален автоматически shared_ptr
         // SDL_Renderer и SDL_Window не управляются UIManager, поэтому не
@@ -32,8 +34,12 @@ namespace Squidl::Core {
         m_sdlWindow = window;
         m_sdlRenderer = renderer;
         m_rootElement = initialRootElement;
-        m_uiRenderer =
+        auto sdl2Renderer =
             std::make_unique<Squidl::Renderers::SDL2Renderer>(m_sdlRenderer);
+        m_sdl2Renderer = sdl2Renderer.get();
+        m_uiRenderer = std::move(sdl2Renderer);
+        m_recorder = std::make_unique<Squidl::Renderers::RecordingRenderer>(
+            *m_uiRenderer);
 
         int w, h;
         SDL_GetWindowSize(m_sdlWindow, &w, &h);
@@ -46,9 +52,23 @@ namespace Squidl::Core {
     }
 
     void UIManager::handleSDLEvent(const SDL_Event &sdlEvent) {
+        SQUIDL_PROFILE_ZONE_OBJ("UIManager::handleSDLEvent", this);
         m_context.handleEvent(
             sdlEvent); // Обновляем внутреннее состояние UIContext
 
+        // Содержимое окна могло быть потеряно (изменение размера, перекрытие,
+        // сброс рендер-таргетов) - следующий кадр нужно отрисовать полностью
+        if (m_recorder && (sdlEvent.type == SDL_WINDOWEVENT ||
+                           sdlEvent.type == SDL_RENDER_TARGETS_RESET ||
+                           sdlEvent.type == SDL_RENDER_DEVICE_RESET)) {
+            m_recorder->invalidate();
+        }
+        // Текстуры-цели теряют содержимое (или сами текстуры) при сбросе
+        if (sdlEvent.type == SDL_RENDER_TARGETS_RESET ||
+            sdlEvent.type == SDL_RENDER_DEVICE_RESET) {
+            releaseCanvas();
+        }
+
         // Создаем UIEvent и рассылаем его через EventDispatcher
         // Mouse Events
         if (sdlEvent.type == SDL_MOUSEMOTION) {
@@ -105,16 +125,129 @@ namespace Squidl::Core {
         }
     }
 
-    void UIManager::updateAndRender() {
+    bool UIManager::updateAndRender() {
+        SQUIDL_PROFILE_ZONE_OBJ("UIManager::updateAndRender", this);
         m_context.beginFrame(); // Сброс временных флагов в контексте
 
-        // Очистка экрана
-        m_uiRenderer->clearScreen(Squidl::Utils::Color(20, 20, 20, 255));
+        if (!m_uiRenderer)
+            return false;
+
+        // В режиме удержания кадр записывается, а не рисуется сразу
+        const bool retained = m_retainedMode && m_recorder;
+        IRenderer &renderer =
+            retained ? static_cast<IRenderer &>(*m_recorder) : *m_uiRenderer;
+        if (retained)
+            m_recorder->beginFrame();
+
+        // Перекомпоновка только если содержимое или ограничения изменились;
+        // setRect пройдёт лишь по ветвям с устаревшей раскладкой. Идёт до
+        // сбора повреждений, чтобы сдвинутые элементы попали в этот кадр
+        if (m_rootElement && !m_rootElement->isLayoutValid()) {
+            SQUIDL_PROFILE_ZONE_OBJ("UIManager::layout", this);
+            m_rootElement->measure();
+            m_rootElement->setRect(m_rootElement->getRect());
+        }
+
+        const Squidl::Utils::Color clearColor(20, 20, 20, 255);
+        const bool dirtyRects = m_dirtyRectMode && ensureCanvas();
+        Squidl::Utils::UIRect damage;
+        if (dirtyRects) {
+            damage = m_rootElement ? m_rootElement->takeDamage()
+                                   : Squidl::Utils::UIRect();
+            if (m_fullRepaint) {
+                damage = {0, 0, m_canvasW, m_canvasH};
+                m_fullRepaint = false;
+            }
+            damage = damage.intersection({0, 0, m_canvasW, m_canvasH});
+
+            // Рисуем в холст и только внутри повреждённой области. Пустая
+            // область полностью блокирует отрисовку, но update() всё равно
+            // вызывается ради логики элементов (мигание курсора и т.п.)
+            SDL_SetRenderTarget(m_sdlRenderer, m_canvas);
+            m_sdl2Renderer->setBaseClipRect(damage);
+            // SDL_RenderClear игнорирует область отсечения
+            if (!damage.isEmpty())
+                renderer.drawFilledRect(damage, clearColor);
+        } else {
+            // Очистка экрана
+            renderer.clearScreen(clearColor);
+        }
 
         // Обновление и отрисовка корневого элемента и всех его детей
         if (m_rootElement) {
-            m_rootElement->update(m_context, *m_uiRenderer);
+            m_rootElement->draw(m_context, renderer);
+        }
+
+        // Воспроизводим кадр, только если он отличается от предыдущего
+        const bool drawn = retained ? m_recorder->endFrame() : true;
+        // Отправляем накопленные рендерером пакеты до показа или копирования
+        // холста
+        m_uiRenderer->flush();
+        if (!dirtyRects)
+            return drawn;
+
+        m_sdl2Renderer->resetBaseClipRect();
+        SDL_SetRenderTarget(m_sdlRenderer, nullptr);
+        // Задний буфер после показа не определён, поэтому холст копируется
+        // целиком; возвращаем, изменилось ли его содержимое
+        SDL_RenderCopy(m_sdlRenderer, m_canvas, nullptr, nullptr);
+        return drawn && !damage.isEmpty();
+    }
+
+    void UIManager::setDirtyRectMode(bool enabled) {
+        if (m_dirtyRectMode == enabled)
+            return;
+        m_dirtyRectMode = enabled;
+        m_fullRepaint = true;
+        if (!enabled)
+            releaseCanvas();
+        SQUIDL_LOG_DEBUG << "UIManager: Режим повреждённых областей "
+                         << (enabled ? "включен." : "выключен.");
+    }
+
+    bool UIManager::ensureCanvas() {
+        if (!m_sdlRenderer || !m_sdl2Renderer)
+            return false;
+
+        int w = 0, h = 0;
+        if (SDL_GetRendererOutputSize(m_sdlRenderer, &w, &h) != 0 || w <= 0 ||
+            h <= 0)
+            return false;
+        if (m_canvas && w == m_canvasW && h == m_canvasH)
+            return true;
+
+        releaseCanvas();
+        m_canvas = SDL_CreateTexture(m_sdlRenderer, SDL_PIXELFORMAT_ARGB8888,
+                                     SDL_TEXTUREACCESS_TARGET, w, h);
+        if (!m_canvas) {
+            SQUIDL_LOG_ERROR << "UIManager: Не удалось создать холст: "
+                             << SDL_GetError();
+            return false;
         }
+        SDL_SetTextureBlendMode(m_canvas, SDL_BLENDMODE_NONE);
+        m_canvasW = w;
+        m_canvasH = h;
+        m_fullRepaint = true;
+        return true;
+    }
+
+    void UIManager::releaseCanvas() {
+        if (m_canvas) {
+            SDL_DestroyTexture(m_canvas);
+            m_canvas = nullptr;
+        }
+        m_canvasW = m_canvasH = 0;
+        m_fullRepaint = true;
+    }
+
+    void UIManager::setRetainedMode(bool enabled) {
+        if (m_retainedMode == enabled)
+            return;
+        m_retainedMode = enabled;
+        if (m_recorder)
+            m_recorder->invalidate();
+        SQUIDL_LOG_DEBUG << "UIManager: Режим удержания кадра "
+                         << (enabled ? "включен." : "выключен.");
     }
 
     void
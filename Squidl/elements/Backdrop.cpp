@@ -1,6 +1,9 @@
 // squidl/elements/Backdrop.cpp
 #include "Squidl/elements/Backdrop.h"
+#include "Squidl/managers/TextureManager.h" // For background loading
+#include "Squidl/renderers/QuadBatch.h" // For QuadBatch::destroyTexture
 #include "Squidl/utils/Logger.h" // For logging
+#include "Squidl/utils/Profiler.h" // For SQUIDL_PROFILE_ZONE
 #include <SDL_image.h>           // For IMG_LoadTexture
 
 namespace Squidl::Elements {
@@ -13,24 +16,35 @@ namespace Squidl::Elements {
 
     Backdrop::~Backdrop() {
         if (ownsTexture && texture) {
-            SDL_DestroyTexture(texture);
+            Squidl::Renderers::QuadBatch::destroyTexture(texture);
             texture = nullptr;
         }
     }
 
     void Backdrop::setTexture(SDL_Texture *tex, bool owns) {
         if (ownsTexture && texture) {
-            SDL_DestroyTexture(texture);
+            Squidl::Renderers::QuadBatch::destroyTexture(texture);
         }
         texture = tex;
         ownsTexture = owns;
+        hasSourceRect = false;
+        managedTexture.reset();
+        invalidate();
+    }
+
+    void Backdrop::setTextureRegion(SDL_Texture *tex, const SDL_Rect &srcRect) {
+        setTexture(tex, false);
+        sourceRect = srcRect;
+        hasSourceRect = true;
     }
 
     void Backdrop::setTextureFromFile(SDL_Renderer *renderer,
                                       const std::string &path) {
         if (ownsTexture && texture) {
-            SDL_DestroyTexture(texture);
+            Squidl::Renderers::QuadBatch::destroyTexture(texture);
         }
+        managedTexture.reset();
+        hasSourceRect = false;
         texture = IMG_LoadTexture(renderer, path.c_str());
         if (!texture) {
             SQUIDL_LOG_ERROR << "Backdrop: Failed to load texture from file '"
@@ -39,15 +53,39 @@ namespace Squidl::Elements {
         } else {
             ownsTexture = true;
         }
+        invalidate();
+    }
+
+    void Backdrop::setTextureFromFile(Squidl::Managers::TextureManager &textures,
+                                      const std::string &path) {
+        if (ownsTexture && texture) {
+            Squidl::Renderers::QuadBatch::destroyTexture(texture);
+        }
+        texture = nullptr;
+        ownsTexture = false;
+        hasSourceRect = false;
+        // Redraw once the texture arrives; the Backdrop may be gone by then
+        std::weak_ptr<UIElement> self = weak_from_this();
+        managedTexture = textures.load(
+            path, [self](Squidl::Managers::TextureResource &) {
+                if (auto element = self.lock())
+                    element->invalidate();
+            });
+        invalidate();
     }
 
     bool Backdrop::update(Squidl::Core::UIContext &ctx,
                           Squidl::Core::IRenderer &renderer) {
+        SQUIDL_PROFILE_ZONE_OBJ("Backdrop::update", this);
         // Update anchored position if managed by layout
         if (isManagedByLayout()) {
             updateAnchoredRect(getParent()->getRect());
         }
 
+        // Nothing to draw outside the current clip rect
+        if (!renderer.isRectVisible(rect))
+            return false;
+
         updateBackdrop(ctx, renderer); // Draw the backdrop itself
 
         // Children are not handled by Backdrop's update, but by Layout if it's
@@ -79,11 +117,20 @@ namespace Squidl::Elements {
         SDL_Color bgCol = getBackgroundColor();
         bgCol.a = static_cast<Uint8>(bgCol.a *
                                      getOpacity()); // Apply element's opacity
-        renderer.drawFilledRect(currentRect, bgCol);
+        // A transparent background would only split texture batches
+        if (bgCol.a > 0)
+            renderer.drawFilledRect(currentRect, bgCol);
 
-        // Draw texture if present
-        if (texture) {
-            renderer.drawTexture(texture, nullptr, &currentRect, getOpacity());
+        // Draw texture if present; a pending managed texture leaves the
+        // background as its placeholder, a loaded one supplies the mip
+        // level closest to the rect
+        SDL_Texture *tex =
+            managedTexture
+                ? managedTexture->getForSize(currentRect.w, currentRect.h)
+                : texture;
+        if (tex) {
+            renderer.drawTexture(tex, hasSourceRect ? &sourceRect : nullptr,
+                                 &currentRect, getOpacity());
         }
 
         // Draw border if not borderless and border opacity > 0
@@ -1,3 +1,4 @@
+#include "Squidl/core/ElementArena.h" // For makeElement
 #include "Squidl/core/IRenderer.h"
 #include "Squidl/core/UIAlignment.h"
 #include "Squidl/core/UIContext.h"
@@ -7,6 +8,7 @@
 #include "Squidl/utils/Color.h"
 #include "Squidl/utils/Logger.h"
 #include "Squidl/utils/UIRect.h"
+#include "Squidl/utils/Profiler.h" // For SQUIDL_PROFILE_ZONE
 #include <SDL_ttf.h>
 #include <algorithm>
 #include <sstream>
@@ -15,8 +17,8 @@ namespace Squidl::Elements {
 
     Button::Button(std::string labelText, int x, int y, int w, int h,
                    TTF_Font *font, bool isBorderless)
-        : label(std::make_shared<Squidl::Elements::Label>(labelText, x, y, w, h,
-                                                          font)) {
+        : label(Squidl::Core::makeElement<Squidl::Elements::Label>(
+              labelText, x, y, w, h, font)) {
         setRect(Squidl::Utils::UIRect(x, y, w, h));
         borderless = isBorderless;
         setFont(font);
@@ -29,6 +31,7 @@ namespace Squidl::Elements {
     void Button::setLabelText(const std::string &text) {
         if (label)
             label->setText(text);
+        invalidate();
     }
 
     // Обработка событий в отдельном методе
@@ -38,6 +41,10 @@ namespace Squidl::Elements {
             return;
         }
 
+        const bool wasHovered = hovered;
+        const bool wasPressed = pressed;
+        const bool wasSelected = selected;
+
         // Проверяем, является ли событие событием мыши
         if (event.type == Squidl::Core::EventType::MouseEvent) {
             auto &mouseEvent = static_cast<Squidl::Core::MouseEvent &>(event);
@@ -52,12 +59,14 @@ namespace Squidl::Elements {
                     Squidl::Core::MouseEventType::ButtonPressed &&
                 mouseOver && mouseEvent.button == SDL_BUTTON_LEFT) {
                 pressed = true;
+                setPointerCapture(true); // Отпускание вне кнопки тоже придёт
                 event.handled = true; // Останавливаем распространение
             }
             if (mouseEvent.mouseEventType ==
                     Squidl::Core::MouseEventType::ButtonReleased &&
                 pressed && mouseOver && mouseEvent.button == SDL_BUTTON_LEFT) {
                 pressed = false;
+                setPointerCapture(false);
                 SQUIDL_LOG_INFO << "Button clicked!";
                 if (toggleMode) {
                     selected = !selected;
@@ -72,23 +81,40 @@ namespace Squidl::Elements {
                        pressed) {
                 // Если мышь отпустили за пределами кнопки
                 pressed = false;
+                setPointerCapture(false);
             }
         }
+
+        // Перерисовываем кнопку только при смене визуального состояния
+        if (hovered != wasHovered || pressed != wasPressed ||
+            selected != wasSelected) {
+            invalidate();
+        }
     }
 
     bool Button::update(Squidl::Core::UIContext &ctx,
                         Squidl::Core::IRenderer &renderer) {
+        SQUIDL_PROFILE_ZONE_OBJ("Button::update", this);
 
         // Логика нажатия и ховера теперь находится в onEvent
-        if (!enabled) {
+        if (!enabled && pressed) {
             pressed = false;
+            setPointerCapture(false);
+            invalidate();
         }
 
+        // Вне области отсечения кнопка не рисуется, но состояние сохраняется
+        if (!renderer.isRectVisible(rect))
+            return hovered || pressed;
+
         updateBackdrop(ctx, renderer);
 
         if (label) {
             label->setRect(getRect());
             label->update(ctx, renderer);
+            // The internal label has no parent, forward its damage
+            if (label->hasDamage())
+                invalidateRect(label->takeDamage());
         }
 
         return hovered || pressed;
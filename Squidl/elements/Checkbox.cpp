@@ -2,6 +2,7 @@
 #include <SDL.h>
 #include <Squidl/core/UIEvent.h>
 #include <Squidl/utils/Logger.h>
+#include <Squidl/utils/Profiler.h> // For SQUIDL_PROFILE_ZONE
 
 namespace Squidl::Elements {
 
@@ -27,6 +28,9 @@ namespace Squidl::Elements {
 
     // Checkbox.cpp :: update
     bool Checkbox::update(Core::UIContext &ctx, Core::IRenderer &renderer) {
+        SQUIDL_PROFILE_ZONE_OBJ("Checkbox::update", this);
+        if (!renderer.isRectVisible(rect))
+            return false;
         updateBackdrop(ctx, renderer);
 
         auto box = calcBoxRect();
@@ -59,6 +63,7 @@ namespace Squidl::Elements {
 
             if (inBox || inLabel) {
                 mIsChecked = !mIsChecked;
+                invalidate();
                 if (mToggleCallback)
                     mToggleCallback(mIsChecked);
                 event.handled = true;
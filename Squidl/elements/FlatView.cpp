@@ -0,0 +1,166 @@
+// squidl/elements/FlatView.cpp
+#include "Squidl/elements/FlatView.h"
+#include "Squidl/core/UIContext.h"
+#include "Squidl/core/UIEvent.h"
+#include "Squidl/elements/Backdrop.h"
+#include "Squidl/utils/Profiler.h" // For SQUIDL_PROFILE_ZONE
+#include <SDL_ttf.h>
+
+namespace Squidl::Elements {
+
+    using Squidl::Core::ElementId;
+    using Squidl::Core::FlatFlags;
+    using Squidl::Utils::Color;
+    using Squidl::Utils::UIRect;
+
+    FlatView::FlatView(int x, int y, int w, int h, TTF_Font *font) {
+        padding = 0;
+        setRect(UIRect(x, y, w, h));
+        setFont(font);
+        setBackgroundColor(Color(0, 0, 0, 0));
+        setBorderless(true);
+    }
+
+    void FlatView::commit() {
+        if (!m_store.isLayoutDirty())
+            return;
+        m_store.updateLayout(contentOrigin());
+        const UIRect damage = m_store.takeDamage();
+        if (!damage.isEmpty())
+            invalidateRect(damage.intersection(rect));
+
+        // Our desired size follows the cells only when the view sizes itself
+        const UIRect bounds = m_store.getBounds();
+        if (bounds != m_cellBounds) {
+            m_cellBounds = bounds;
+            if (isManagedByChilds())
+                invalidateMeasure();
+        }
+    }
+
+    void FlatView::setRect(const UIRect &newRect) {
+        UIElement::setRect(newRect);
+        // A moved view moves every cell; rectChanged already repainted it
+        m_store.updateLayout(contentOrigin());
+        m_store.takeDamage();
+        m_cellBounds = m_store.getBounds();
+    }
+
+    void FlatView::setFont(TTF_Font *f) {
+        if (font != f) {
+            // Cached text sizes belong to the old font
+            for (auto &size : m_store.getTextSizes())
+                size = {-1, -1};
+        }
+        UIElement::setFont(f);
+    }
+
+    void FlatView::autosize() {
+        if (!isManagedByChilds())
+            return;
+        m_store.updateLayout(contentOrigin());
+        m_store.takeDamage();
+        const UIRect bounds = m_store.getBounds();
+        const int w = bounds.isEmpty() ? padding.left + padding.right
+                                       : bounds.x + bounds.w - rect.x +
+                                             padding.right;
+        const int h = bounds.isEmpty() ? padding.top + padding.bottom
+                                       : bounds.y + bounds.h - rect.y +
+                                             padding.bottom;
+        const UIRect oldRect = rect;
+        rect.w = w;
+        rect.h = h;
+        applyConstraints();
+        rectChanged(oldRect);
+    }
+
+    bool FlatView::update(Squidl::Core::UIContext &ctx,
+                          Squidl::Core::IRenderer &renderer) {
+        SQUIDL_PROFILE_ZONE_OBJ("FlatView::update", this);
+        // Changes made without commit() are picked up one frame late
+        commit();
+        updateBackdrop(ctx, renderer);
+
+        const auto &worldRects = m_store.getWorldRects();
+        const auto &flags = m_store.getFlags();
+        const auto &opacities = m_store.getEffectiveOpacities();
+        const auto &bgColors = m_store.getBackgroundColors();
+        const auto &borderColors = m_store.getBorderColors();
+        const auto &textColors = m_store.getTextColors();
+        const auto &texts = m_store.getTexts();
+        auto &textSizes = m_store.getTextSizes();
+        const float viewOpacity = getOpacity();
+
+        renderer.pushClipRect(rect);
+        const std::size_t count = worldRects.size();
+        for (std::size_t i = 0; i < count; ++i) {
+            if (!Squidl::Core::hasFlag(flags[i], FlatFlags::Shown))
+                continue;
+            const UIRect &r = worldRects[i];
+            if (!renderer.isRectVisible(r))
+                continue;
+            const float alpha = opacities[i] * viewOpacity;
+
+            Color bg = bgColors[i];
+            bg.a = static_cast<Uint8>(bg.a * alpha);
+            if (bg.a > 0)
+                renderer.drawFilledRect(r, bg);
+            if (Squidl::Core::hasFlag(flags[i], FlatFlags::Border)) {
+                Color bc = borderColors[i];
+                bc.a = static_cast<Uint8>(bc.a * alpha);
+                renderer.drawOutlineRect(r, bc);
+            }
+
+            if (!font || texts[i].empty())
+                continue;
+            Squidl::Utils::Size &ts = textSizes[i];
+            if (ts.w < 0 &&
+                TTF_SizeUTF8(font, texts[i].c_str(), &ts.w, &ts.h) != 0) {
+                ts = {0, 0};
+            }
+            Color tc = textColors[i];
+            tc.a = static_cast<Uint8>(tc.a * alpha);
+            renderer.drawText(font, texts[i], tc,
+                              {r.x + m_textInset, r.y + (r.h - ts.h) / 2, ts.w,
+                               ts.h});
+        }
+        renderer.popClipRect();
+        return false;
+    }
+
+    void FlatView::onEvent(Squidl::Core::UIEvent &event) {
+        if (event.type != Squidl::Core::EventType::MouseEvent ||
+            !m_onCellClicked)
+            return;
+        auto &me = static_cast<Squidl::Core::MouseEvent &>(event);
+        if (me.mouseEventType != Squidl::Core::MouseEventType::ButtonPressed ||
+            me.button != SDL_BUTTON_LEFT ||
+            !rect.contains(me.position.x, me.position.y))
+            return;
+        const ElementId id = m_store.hitTest(me.position.x, me.position.y);
+        if (id != Squidl::Core::InvalidElementId) {
+            m_onCellClicked(id);
+            event.handled = true;
+        }
+    }
+
+    void FlatView::updateBackdrop(Squidl::Core::UIContext &ctx,
+                                  Squidl::Core::IRenderer &renderer) {
+        if (backdrop) {
+            backdrop->setRect(rect);
+            backdrop->setOpacity(opacity);
+            backdrop->update(ctx, renderer);
+            return;
+        }
+        Color bg = getBackgroundColor();
+        bg.a = static_cast<Uint8>(bg.a * getOpacity());
+        if (bg.a > 0)
+            renderer.drawFilledRect(rect, bg);
+        if (!isBorderless() && getBorderOpacity() > 0.0f) {
+            Color bc = getBorderColor();
+            bc.a = static_cast<Uint8>(bc.a * getBorderOpacity());
+            renderer.drawOutlineRect(rect, bc);
+        }
+    }
+
+} // namespace Squidl::Elements
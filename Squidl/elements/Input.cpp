@@ -1,8 +1,10 @@
 // Input.cpp
 #include "Squidl/elements/Input.h"
+#include "Squidl/core/ElementArena.h" // For makeElement
 #include "Squidl/core/IRenderer.h"
 #include "Squidl/core/UIContext.h"
 #include "Squidl/utils/Logger.h"
+#include "Squidl/utils/Profiler.h" // For SQUIDL_PROFILE_ZONE
 #include <SDL_ttf.h>
 #include <algorithm> // Для std::min, std::max
 
@@ -17,7 +19,8 @@ namespace Squidl::Elements {
         setBorderColor(Squidl::Utils::Color(0, 0, 0, 255)); // Черная рамка
         setBorderless(false);
 
-        label = std::make_shared<Squidl::Elements::Label>("", x, y, w, h, font);
+        label = Squidl::Core::makeElement<Squidl::Elements::Label>(
+            "", x, y, w, h, font);
         label->setHorizontalAlignment(Squidl::Core::HorizontalAlign::Left);
         label->setVerticalAlignment(Squidl::Core::VerticalAlign::Center);
         // Устанавливаем отступы для текста внутри поля ввода
@@ -67,26 +70,14 @@ namespace Squidl::Elements {
             if (mouseEvent.mouseEventType ==
                     Squidl::Core::MouseEventType::ButtonPressed &&
                 mouseEvent.button == SDL_BUTTON_LEFT) {
-                if (mouseOver) {
-                    if (!focused) {
-                        focused = true;
-                        SDL_StartTextInput(); // Начинаем принимать текстовый
-                                              // ввод
-                        SQUIDL_LOG_INFO << "Input gained focus.";
-                    }
+                // Фокус уже выставлен EventDispatcher до доставки клика
+                if (mouseOver && focused) {
                     // Устанавливаем позицию курсора по клику
                     cursorPosition = getCharIndexAt(mouseEvent.position.x);
                     cursorTimer = SDL_GetTicks(); // Сброс таймера курсора
                     showCursor = true;    // Показать курсор сразу после клика
                     adjustTextOffset();   // Корректируем смещение текста
                     event.handled = true; // Событие обработано
-                } else {
-                    if (focused) {
-                        focused = false;
-                        SDL_StopTextInput(); // Останавливаем прием текстового
-                                             // ввода
-                        SQUIDL_LOG_INFO << "Input lost focus.";
-                    }
                 }
                 updateLabelTextAndColor(); // Обновляем цвет, если фокус
                                            // изменился
@@ -161,8 +152,28 @@ namespace Squidl::Elements {
         }
     }
 
+    void Input::setFocused(bool value) {
+        if (focused == value)
+            return;
+        focused = value;
+        if (focused) {
+            SDL_StartTextInput(); // Начинаем принимать текстовый ввод
+            SQUIDL_LOG_INFO << "Input gained focus.";
+        } else {
+            SDL_StopTextInput(); // Останавливаем прием текстового ввода
+            SQUIDL_LOG_INFO << "Input lost focus.";
+        }
+        invalidate(); // Меняется цвет рамки
+    }
+
+    void Input::onFocusChanged(bool value) {
+        setFocused(value);
+        updateLabelTextAndColor(); // Плейсхолдер скрывается при фокусе
+    }
+
     bool Input::update(Squidl::Core::UIContext &ctx,
                        Squidl::Core::IRenderer &renderer) {
+        SQUIDL_PROFILE_ZONE_OBJ("Input::update", this);
         Squidl::Utils::UIRect currentRect = getRect();
         bool hovered = currentRect.contains(ctx.getMouseX(), ctx.getMouseY());
 
@@ -187,8 +198,12 @@ namespace Squidl::Elements {
         // Обновляем и отрисовываем метку. Метка будет отрисовывать свой текст
         // в пределах назначенного ей UIRect, применяя textOffsetX.
         label->update(ctx, renderer);
+        // Внутренняя метка не имеет родителя, передаём её повреждения выше
+        if (label->hasDamage())
+            invalidateRect(label->takeDamage());
 
         // Логика мигания курсора
+        Squidl::Utils::UIRect cursorRect;
         if (focused) {
             Uint32 currentTime = SDL_GetTicks();
             if (currentTime - cursorTimer > 500) { // Мигать каждые 500 мс
@@ -218,13 +233,20 @@ namespace Squidl::Elements {
 
                 if (cursorX >= visibleAreaStart && cursorX <= visibleAreaEnd) {
                     // Отрисовка курсора
-                    Squidl::Utils::UIRect cursorRect = {
-                        cursorX, labelContentRect.y+5, 2, labelContentRect.h-10};
+                    cursorRect = {cursorX, labelContentRect.y + 5, 2,
+                                  labelContentRect.h - 10};
                     renderer.drawFilledRect(cursorRect, cursorColor);
                 }
             }
         }
 
+        // Мигание или перемещение курсора перерисовывает только его область
+        if (cursorRect != lastCursorRect) {
+            invalidateRect(lastCursorRect);
+            invalidateRect(cursorRect);
+            lastCursorRect = cursorRect;
+        }
+
         return focused ||
                hovered; // Возвращаем true, если элемент в фокусе или наведен
     }
@@ -5,6 +5,7 @@
 #include "Squidl/utils/Color.h"  // For Squidl::Utils::Color
 #include "Squidl/utils/Logger.h" // For logging
 #include "Squidl/utils/UIRect.h" // For Squidl::Utils::UIRect
+#include "Squidl/utils/Profiler.h" // For SQUIDL_PROFILE_ZONE
 #include <SDL.h>
 #include <SDL_ttf.h>
 #include <algorithm> // For std::clamp
@@ -34,16 +35,25 @@ namespace Squidl::Elements { // <--- НАЧАЛО ПРОСТРАНСТВА ИМ
         paddingBottom = 5;
     }
 
-    void Label::setText(std::string t) { text = t; }
+    void Label::setText(std::string t) {
+        if (text != t) {
+            text = std::move(t);
+            m_linesValid = false;
+            invalidate();
+            invalidateAutosize();
+        }
+    }
 
     std::string Label::getText() const { return text; }
 
     // Реализация autosize с учетом отступов
     void Label::autosize() {
+        const UIRect oldRect = rect;
         if (!font || text.empty()) {
             rect.w = 0;
             rect.h = 0;
             applyConstraints();
+            rectChanged(oldRect);
             return;
         }
 
@@ -60,10 +70,12 @@ namespace Squidl::Elements { // <--- НАЧАЛО ПРОСТРАНСТВА ИМ
             rect.h = textHeight + paddingTop + paddingBottom;
         }
         applyConstraints();
+        rectChanged(oldRect);
     }
 
     bool Label::update(Squidl::Core::UIContext &ctx,
                        Squidl::Core::IRenderer &renderer) {
+        SQUIDL_PROFILE_ZONE_OBJ("Label::update", this);
         // Обновляем позицию привязки, если управляется макетом
         if (isManagedByLayout()) {
             // Убедимся, что родительский элемент существует и является
@@ -73,18 +85,16 @@ namespace Squidl::Elements { // <--- НАЧАЛО ПРОСТРАНСТВА ИМ
             }
         }
 
+        // Метка целиком вне текущей области отсечения - рисовать нечего
+        if (!renderer.isRectVisible(rect))
+            return false;
+
         updateBackdrop(ctx, renderer); // Отрисовываем фон и рамку
 
         if (!font || text.empty())
             return false;
 
-        std::vector<std::string> lines;
-        std::istringstream stream(getText());
-        std::string line;
-        while (std::getline(stream, line,
-                            '\n')) { // Разделяем по символу новой строки
-            lines.push_back(line);
-        }
+        const std::vector<TextLine> &lines = getLines();
 
         // Вычисляем общую высоту, необходимую для текста
         int lineHeight = TTF_FontHeight(font);
@@ -117,18 +127,18 @@ namespace Squidl::Elements { // <--- НАЧАЛО ПРОСТРАНСТВА ИМ
         // область содержимого.
         UIRect clippingRect = getRect();
 
-        // Устанавливаем область отсечения рендерера перед отрисовкой текста
-        // Предполагается, что IRenderer предоставляет эти методы.
-        renderer.setClipRect(clippingRect);
+        // Добавляем область отсечения в стек рендерера: она пересекается с
+        // отсечением родителя (например, ScrollView), а не заменяет его
+        renderer.pushClipRect(clippingRect);
 
         // Отрисовываем каждую строку
-        for (const auto &lineText : lines) {
+        for (const auto &line : lines) {
+            const std::string &lineText = line.text;
             // Начальное смещение xOffset для текста, относительно
             // clippingRect.x Это то место, где текст *начинался бы*, если бы не
             // было горизонтального выравнивания или смещения текста.
             int xOffset = clippingRect.x;
-            int line_width_actual = 0;
-            TTF_SizeUTF8(font, lineText.c_str(), &line_width_actual, nullptr);
+            const int line_width_actual = line.width;
 
             // Применяем горизонтальное выравнивание в пределах ширины
             // clippingRect
@@ -163,12 +173,32 @@ namespace Squidl::Elements { // <--- НАЧАЛО ПРОСТРАНСТВА ИМ
             yOffset += lineHeight; // Переходим на следующую строку
         }
 
-        // Сбрасываем область отсечения рендерера после отрисовки текста
-        renderer.resetClipRect();
+        // Возвращаем область отсечения родителя
+        renderer.popClipRect();
 
         return false; // Метка обычно не потребляет события
     }
 
+    const std::vector<Label::TextLine> &Label::getLines() {
+        if (m_linesValid && m_linesFont == font)
+            return m_lines;
+
+        m_lines.clear();
+        std::istringstream stream(text);
+        std::string line;
+        while (std::getline(stream, line,
+                            '\n')) { // Разделяем по символу новой строки
+            TextLine measured;
+            measured.text = line;
+            if (font)
+                TTF_SizeUTF8(font, line.c_str(), &measured.width, nullptr);
+            m_lines.push_back(std::move(measured));
+        }
+        m_linesFont = font;
+        m_linesValid = true;
+        return m_lines;
+    }
+
     void Label::updateBackdrop(Squidl::Core::UIContext &ctx,
                                Squidl::Core::IRenderer &renderer) {
         UIRect currentRect = getRect(); // <--- Теперь возвращает UIRect
@@ -190,16 +220,22 @@ namespace Squidl::Elements { // <--- НАЧАЛО ПРОСТРАНСТВА ИМ
     // Методы для установки и получения отступов
     void Label::setPadding(int p) {
         paddingLeft = paddingRight = paddingTop = paddingBottom = p;
+        invalidate();
+        invalidateAutosize();
     }
     void Label::setPadding(int horizontal, int vertical) {
         paddingLeft = paddingRight = horizontal;
         paddingTop = paddingBottom = vertical;
+        invalidate();
+        invalidateAutosize();
     }
     void Label::setPadding(int left, int top, int right, int bottom) {
         paddingLeft = left;
         paddingTop = top;
         paddingRight = right;
         paddingBottom = bottom;
+        invalidate();
+        invalidateAutosize();
     }
 
 } // namespace Squidl::Elements
@@ -4,6 +4,7 @@
 #include <Squidl/elements/ToggleSwitch.h>
 #include <Squidl/utils/UIRect.h>
 #include <Squidl/utils/Logger.h>
+#include <Squidl/utils/Profiler.h> // For SQUIDL_PROFILE_ZONE
 
 namespace Squidl::Elements {
 
@@ -79,6 +80,10 @@ namespace Squidl::Elements {
 
     bool ToggleSwitch::update(Squidl::Core::UIContext &ctx,
                               Squidl::Core::IRenderer &renderer) {
+        SQUIDL_PROFILE_ZONE_OBJ("ToggleSwitch::update", this);
+        // за пределами области отсечения рисовать нечего
+        if (!renderer.isRectVisible(rect))
+            return true;
         // рисуем фон элемента (обычный bg/бордер, не тело свитча)
         updateBackdrop(ctx, renderer);
 
@@ -117,11 +122,13 @@ namespace Squidl::Elements {
         if (mouseEvent.mouseEventType == Core::MouseEventType::ButtonPressed &&
             hoveredLocal && mouseEvent.button == SDL_BUTTON_LEFT) {
             pressed = true;
+            setPointerCapture(true); // отпускание вне тела тоже придёт
             event.handled = true;
         }
         if (mouseEvent.mouseEventType == Core::MouseEventType::ButtonReleased &&
             hoveredLocal && pressed && mouseEvent.button == SDL_BUTTON_LEFT) {
             pressed = false;
+            setPointerCapture(false);
             setState(!mIsOn);
             event.handled = true;
         } else if (mouseEvent.mouseEventType ==
@@ -129,6 +136,7 @@ namespace Squidl::Elements {
                    pressed) {
             // отпустили вне — сброс
             pressed = false;
+            setPointerCapture(false);
         }
     }
 
@@ -151,6 +159,7 @@ namespace Squidl::Elements {
     void ToggleSwitch::setState(bool isOn) {
         if (mIsOn != isOn) {
             mIsOn = isOn;
+            invalidate();
             // setBackgroundColor(mIsOn ? mOnColor : mOffColor);
 
             // Call the callback if it exists
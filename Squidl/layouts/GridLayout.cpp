@@ -1,5 +1,6 @@
 #include "Squidl/layouts/GridLayout.h"
 #include "Squidl/elements/Backdrop.h"
+#include "Squidl/utils/Profiler.h" // For SQUIDL_PROFILE_ZONE
 #include <algorithm>
 
 using namespace Squidl;
@@ -14,15 +15,16 @@ namespace Squidl::Layouts {
     }
 
     void GridLayout::setRect(const Utils::UIRect &newRect) {
+        // Nothing to arrange if neither the rect nor the children changed
+        if (layoutValid && newRect == rect)
+            return;
+
+        const Utils::UIRect oldRect = rect;
         rect = newRect;
+        rectChanged(oldRect);
 
         const int innerW = std::max(0, rect.w - padding.pWidthSum());
 
-        for (auto &child : children) {
-            if (child)
-                child->autosize();
-        }
-
         const int gapsX = std::max(0, columns - 1);
         const int cellW =
             (columns > 0) ? std::max(0, (innerW - gapsX * spacing) / columns)
@@ -37,7 +39,9 @@ namespace Squidl::Layouts {
                 continue;
             ch->setManagedByLayout(true);
 
-            auto c = ch->getRect();
+            // Desired size: the rect may still hold the aligned slot from
+            // the previous arrange
+            const Utils::Size c = ch->measure();
             const int childMH = ch->margin.left + ch->margin.right;
             const int childMV = ch->margin.top + ch->margin.bottom;
 
@@ -67,10 +71,14 @@ namespace Squidl::Layouts {
         }
 
         applyConstraints();
+        layoutValid = true;
     }
 
     bool GridLayout::update(Core::UIContext &ctx, Core::IRenderer &renderer) {
-        if (backdrop) {
+        SQUIDL_PROFILE_ZONE_OBJ("GridLayout::update", this);
+        if (!renderer.isRectVisible(rect)) {
+            // Only the background is culled: children may overflow the rect
+        } else if (backdrop) {
             updateBackdrop(ctx, renderer);
         } else {
             Utils::Color col = getBackgroundColor();
@@ -87,7 +95,7 @@ namespace Squidl::Layouts {
         bool any = false;
         for (auto &ch : children) {
             if (ch)
-                any |= ch->update(ctx, renderer);
+                any |= ch->draw(ctx, renderer);
         }
         return any;
     }
@@ -105,7 +113,7 @@ namespace Squidl::Layouts {
         if (!isManagedByChilds()) {
             for (auto &ch : children)
                 if (ch)
-                    ch->autosize();
+                    ch->measure();
             applyConstraints();
             return;
         }
@@ -119,8 +127,7 @@ namespace Squidl::Layouts {
         for (auto &ch : children) {
             if (!ch)
                 continue;
-            ch->autosize();
-            auto c = ch->getRect();
+            const Utils::Size c = ch->measure();
 
             maxCellW = std::max(maxCellW, c.w);
 
@@ -1,6 +1,7 @@
 // HBoxLayout.cpp
 #include "Squidl/layouts/HBoxLayout.h"
 #include "Squidl/elements/Backdrop.h"
+#include "Squidl/utils/Profiler.h" // For SQUIDL_PROFILE_ZONE
 
 using namespace Squidl;
 
@@ -9,7 +10,13 @@ namespace Squidl::Layouts {
     HBoxLayout::HBoxLayout(int spacing_) { spacing = spacing_; }
 
     void HBoxLayout::setRect(const Utils::UIRect &newRect) {
+        // Nothing to arrange if neither the rect nor the children changed
+        if (layoutValid && newRect == rect)
+            return;
+
+        const Utils::UIRect oldRect = rect;
         rect = newRect;
+        rectChanged(oldRect);
 
         const int availW = rect.w - padding.pWidthSum();
         const int availH = rect.h - padding.pHeightSum();
@@ -39,7 +46,9 @@ namespace Squidl::Layouts {
             if (!ch->isManagedByLayout())
                 continue;
 
-            auto c = ch->getRect();
+            // Desired size: the rect may still hold a stretched slot from
+            // the previous arrange
+            const Utils::Size c = ch->measure();
             int cw = (getHorizontalAlign() == Core::HorizontalAlign::Stretch)
                          ? stretchSlotW
                          : c.w;
@@ -89,10 +98,14 @@ namespace Squidl::Layouts {
             ch->setRect({cx, cy, cw, chH});
             childX += cw + ch->margin.left + ch->margin.right + spacing;
         }
+        layoutValid = true;
     }
 
     bool HBoxLayout::update(Core::UIContext &ctx, Core::IRenderer &renderer) {
-        if (backdrop) {
+        SQUIDL_PROFILE_ZONE_OBJ("HBoxLayout::update", this);
+        if (!renderer.isRectVisible(rect)) {
+            // Only the background is culled: children may overflow the rect
+        } else if (backdrop) {
             updateBackdrop(ctx, renderer);
         } else {
             auto col = getBackgroundColor();
@@ -107,7 +120,7 @@ namespace Squidl::Layouts {
         }
         bool any = false;
         for (auto &ch : children)
-            any |= ch->update(ctx, renderer);
+            any |= ch->draw(ctx, renderer);
         return any;
     }
 
@@ -131,8 +144,7 @@ namespace Squidl::Layouts {
         int maxH = 0;
         int i = 0;
         for (auto &ch : children) {
-            ch->autosize();
-            auto c = ch->getRect();
+            const Utils::Size c = ch->measure();
             totalW += c.w + ch->margin.left + ch->margin.right;
             if (i++ < (int)children.size() - 1)
                 totalW += spacing;
@@ -4,6 +4,7 @@
 #include "Squidl/utils/Color.h"    // For Squidl::Utils::Color
 #include "Squidl/utils/Logger.h"   // For logging
 #include "Squidl/utils/UIRect.h"   // For Squidl::Utils::UIRect
+#include "Squidl/utils/Profiler.h" // For SQUIDL_PROFILE_ZONE
 
 namespace Squidl::Layouts {
 
@@ -17,11 +18,14 @@ namespace Squidl::Layouts {
                 child->setFont(font);
             }
             child->index = static_cast<int>(children.size()) - 1;
+            child->invalidate(); // The new child has never been drawn
+            invalidateMeasure();  // Our desired size depends on children
         }
     }
 
     bool Layout::update(Squidl::Core::UIContext &ctx,
                         Squidl::Core::IRenderer &renderer) {
+        SQUIDL_PROFILE_ZONE_OBJ("Layout::update", this);
         // Update anchored position for the layout itself
         if (isManagedByLayout()) {
             updateAnchoredRect(getParent()->getRect());
@@ -33,7 +37,7 @@ namespace Squidl::Layouts {
         for (const auto &child : children) {
             if (child) {
                 // Pass the same IRenderer reference to children
-                child->update(ctx, renderer);
+                child->draw(ctx, renderer);
             }
         }
         return false; // Layouts usually don't consume events directly
@@ -52,6 +56,8 @@ namespace Squidl::Layouts {
 
     void Layout::updateBackdrop(Squidl::Core::UIContext &ctx,
                                 Squidl::Core::IRenderer &renderer) {
+        if (!renderer.isRectVisible(rect))
+            return;
         Squidl::Utils::UIRect currentRect =
             getRect(); // <--- Now returns UIRect
         Squidl::Utils::Color bgCol =
@@ -0,0 +1,421 @@
+#include "Squidl/layouts/ScrollView.h"
+#include "Squidl/core/UIEvent.h"
+#include "Squidl/elements/Backdrop.h"
+#include "Squidl/utils/Profiler.h" // For SQUIDL_PROFILE_ZONE
+#include <SDL.h>                   // For SDL_GetTicks
+#include <algorithm>
+#include <cmath>
+
+using namespace Squidl;
+
+namespace Squidl::Layouts {
+
+    namespace {
+        // Below this speed (px/s) kinetic motion stops
+        constexpr float MinVelocity = 20.0f;
+        // Releasing a drag later than this after the last move does not fling
+        constexpr Uint32 FlingTimeoutMs = 100;
+        // Longest time step integrated at once, e.g. after a stalled frame
+        constexpr float MaxStep = 0.1f;
+        // Width of the scroll bars
+        constexpr int ScrollBarThickness = 3;
+    } // namespace
+
+    ScrollView::ScrollView(int spacing_, int padding_) {
+        spacing = spacing_;
+        padding = padding_;
+    }
+
+    Utils::UIRect ScrollView::getViewport() const {
+        return {rect.x + padding.left, rect.y + padding.top,
+                std::max(0, rect.w - padding.left - padding.right),
+                std::max(0, rect.h - padding.top - padding.bottom)};
+    }
+
+    Utils::Point ScrollView::getMaxScrollOffset() const {
+        const Utils::UIRect vp = getViewport();
+        return {std::max(0, m_contentSize.w - vp.w),
+                std::max(0, m_contentSize.h - vp.h)};
+    }
+
+    void ScrollView::clampOffset() {
+        const Utils::Point max = getMaxScrollOffset();
+        m_offset.x = std::clamp(m_offset.x, 0, max.x);
+        m_offset.y = std::clamp(m_offset.y, 0, max.y);
+    }
+
+    void ScrollView::setScrollOffset(Utils::Point offset) {
+        const Utils::Point old = m_offset;
+        m_offset = offset;
+        clampOffset();
+        if (m_offset.x == old.x && m_offset.y == old.y)
+            return;
+        placeChildren(false);
+        invalidate();
+    }
+
+    void ScrollView::scrollToChild(const Base::UIElement *child) {
+        for (std::size_t i = 0; i < children.size() && i < m_slots.size();
+             ++i) {
+            if (children[i].get() != child)
+                continue;
+            const Utils::UIRect vp = getViewport();
+            const Utils::UIRect &slot = m_slots[i];
+            Utils::Point target = m_offset;
+            if (slot.y < target.y)
+                target.y = slot.y;
+            else if (slot.y + slot.h > target.y + vp.h)
+                target.y = slot.y + slot.h - vp.h;
+            if (m_horizontal) {
+                if (slot.x < target.x)
+                    target.x = slot.x;
+                else if (slot.x + slot.w > target.x + vp.w)
+                    target.x = slot.x + slot.w - vp.w;
+            }
+            stopKinetic();
+            setScrollOffset(target);
+            return;
+        }
+    }
+
+    void ScrollView::setHorizontalScrollEnabled(bool value) {
+        if (m_horizontal == value)
+            return;
+        m_horizontal = value;
+        if (!m_horizontal)
+            m_offset.x = 0;
+        layoutValid = false;
+        invalidateMeasure();
+    }
+
+    void ScrollView::setKineticScrolling(bool value) {
+        m_kinetic = value;
+        if (!m_kinetic)
+            stopKinetic();
+    }
+
+    void ScrollView::setFriction(float value) {
+        // 1.0 would stop instantly and make the decay rate infinite
+        m_friction = std::clamp(value, 0.05f, 0.999f);
+    }
+
+    void ScrollView::arrangeContent() {
+        const Utils::UIRect vp = getViewport();
+
+        int contentW = vp.w;
+        if (m_horizontal) {
+            for (auto &ch : children) {
+                if (ch)
+                    contentW = std::max(contentW, ch->measure().w +
+                                                      ch->margin.left +
+                                                      ch->margin.right);
+            }
+        }
+
+        m_slots.resize(children.size());
+        int cursorY = 0;
+        for (std::size_t i = 0; i < children.size(); ++i) {
+            const auto &ch = children[i];
+            if (!ch) {
+                m_slots[i] = {0, cursorY, 0, 0};
+                continue;
+            }
+            // Desired size: the rect holds the slot of the previous arrange
+            const Utils::Size c = ch->measure();
+            const Utils::UIRect slot = {
+                ch->margin.left, cursorY + ch->margin.top,
+                std::max(0, contentW - ch->margin.left - ch->margin.right),
+                c.h};
+            const Utils::UIRect desired = {0, 0, c.w, c.h};
+            auto useHX = childHXOverride.value_or(ch->getHorizontalAlign());
+            auto useVY = childVYOverride.value_or(ch->getVerticalAlign());
+            m_slots[i] = alignInSlot(slot, desired, useHX, useVY);
+            cursorY += c.h + ch->margin.top + ch->margin.bottom + spacing;
+        }
+        m_contentSize = {contentW,
+                         std::max(0, cursorY - (children.empty() ? 0 : spacing))};
+    }
+
+    void ScrollView::placeChildren(bool all) {
+        const Utils::UIRect vp = getViewport();
+        const int originX = vp.x - m_offset.x;
+        const int originY = vp.y - m_offset.y;
+
+        // Slots are stacked, so both their tops and bottoms are sorted
+        const int top = m_offset.y;
+        const int bottom = m_offset.y + vp.h;
+        const auto first = std::partition_point(
+            m_slots.begin(), m_slots.end(),
+            [top](const Utils::UIRect &s) { return s.y + s.h <= top; });
+        const auto last =
+            std::partition_point(first, m_slots.end(),
+                                 [bottom](const Utils::UIRect &s) {
+                                     return s.y < bottom;
+                                 });
+        const std::size_t begin = first - m_slots.begin();
+        const std::size_t end = last - m_slots.begin();
+
+        auto place = [&](std::size_t i) {
+            if (const auto &ch = children[i]) {
+                const Utils::UIRect &s = m_slots[i];
+                ch->setRect({originX + s.x, originY + s.y, s.w, s.h});
+            }
+        };
+
+        if (all) {
+            for (std::size_t i = 0; i < m_slots.size(); ++i)
+                place(i);
+        } else {
+            // Children leaving the viewport are moved out of it once; the
+            // rest keep rects outside the viewport and are not touched
+            for (std::size_t i = begin; i < end; ++i)
+                place(i);
+            const std::size_t prevEnd = std::min(m_visibleEnd, m_slots.size());
+            for (std::size_t i = m_visibleBegin; i < prevEnd; ++i) {
+                if (i < begin || i >= end)
+                    place(i);
+            }
+        }
+        m_visibleBegin = begin;
+        m_visibleEnd = end;
+    }
+
+    void ScrollView::setRect(const Utils::UIRect &newRect) {
+        if (layoutValid && newRect == rect)
+            return;
+
+        const Utils::UIRect oldRect = rect;
+        rect = newRect;
+        applyConstraints();
+        m_ownDamage = true;
+        rectChanged(oldRect);
+        m_ownDamage = false;
+
+        arrangeContent();
+        clampOffset();
+        placeChildren(true);
+        layoutValid = true;
+    }
+
+    void ScrollView::invalidateRect(const Utils::UIRect &area) {
+        // Children outside the viewport are not visible
+        UIElement::invalidateRect(m_ownDamage ? area : area.intersection(rect));
+    }
+
+    void ScrollView::autosize() {
+        if (isManagedByChilds()) {
+            int totalH = padding.top + padding.bottom;
+            int maxW = 0;
+            for (std::size_t i = 0; i < children.size(); ++i) {
+                const auto &ch = children[i];
+                if (!ch)
+                    continue;
+                const Utils::Size c = ch->measure();
+                totalH += c.h + ch->margin.top + ch->margin.bottom;
+                if (i + 1 < children.size())
+                    totalH += spacing;
+                maxW = std::max(maxW, c.w + ch->margin.left + ch->margin.right);
+            }
+            const Utils::UIRect oldRect = rect;
+            rect.w = maxW + padding.left + padding.right;
+            rect.h = totalH;
+            m_ownDamage = true;
+            rectChanged(oldRect);
+            m_ownDamage = false;
+        }
+        applyConstraints();
+    }
+
+    void ScrollView::advanceKinetic() {
+        const Uint32 now = SDL_GetTicks();
+        const float dt = std::min(MaxStep, (now - m_lastTick) / 1000.0f);
+        m_lastTick = now;
+        if (!m_kinetic || m_dragging ||
+            (m_velocity.x == 0.0f && m_velocity.y == 0.0f) || dt <= 0.0f)
+            return;
+
+        m_remainderX += m_velocity.x * dt;
+        m_remainderY += m_velocity.y * dt;
+        const int dx = static_cast<int>(m_remainderX);
+        const int dy = static_cast<int>(m_remainderY);
+        m_remainderX -= dx;
+        m_remainderY -= dy;
+
+        const Utils::Point before = m_offset;
+        scrollBy(dx, dy);
+        // Stop at the edges instead of pushing against them
+        if (dx != 0 && m_offset.x == before.x)
+            m_velocity.x = 0.0f;
+        if (dy != 0 && m_offset.y == before.y)
+            m_velocity.y = 0.0f;
+
+        const float decay = std::pow(1.0f - m_friction, dt);
+        m_velocity.x *= decay;
+        m_velocity.y *= decay;
+        if (std::fabs(m_velocity.x) < MinVelocity)
+            m_velocity.x = 0.0f;
+        if (std::fabs(m_velocity.y) < MinVelocity)
+            m_velocity.y = 0.0f;
+
+        // A step below a pixel moves nothing and damages nothing, yet the
+        // fling has to go on until the velocity drops below MinVelocity
+        if (isScrolling() && m_offset.x == before.x && m_offset.y == before.y)
+            requestKineticFrame();
+    }
+
+    void ScrollView::requestKineticFrame() {
+        // The scroll bar strip is cheap to repaint and always inside us
+        const Utils::UIRect vp = getViewport();
+        invalidateRect({vp.x + vp.w - ScrollBarThickness - 1, vp.y,
+                        ScrollBarThickness, vp.h});
+    }
+
+    bool ScrollView::update(Core::UIContext &ctx, Core::IRenderer &renderer) {
+        SQUIDL_PROFILE_ZONE_OBJ("ScrollView::update", this);
+        advanceKinetic();
+        updateBackdrop(ctx, renderer);
+
+        const Utils::UIRect vp = getViewport();
+        const std::size_t end = std::min(m_visibleEnd, children.size());
+        bool any = false;
+        // Children nest their own clips inside the viewport
+        renderer.pushClipRect(vp);
+        for (std::size_t i = m_visibleBegin; i < end; ++i) {
+            const auto &ch = children[i];
+            if (ch && renderer.isRectVisible(ch->getRect()))
+                any |= ch->draw(ctx, renderer);
+        }
+        renderer.popClipRect();
+        drawScrollBars(renderer);
+        return any;
+    }
+
+    void ScrollView::drawScrollBars(Core::IRenderer &renderer) const {
+        constexpr int Thickness = ScrollBarThickness;
+        constexpr int MinThumb = 16;
+        const Utils::UIRect vp = getViewport();
+        const Utils::Point max = getMaxScrollOffset();
+        if (max.y > 0 && vp.h > 0) {
+            const int thumbH = std::max(
+                MinThumb, static_cast<int>(static_cast<long long>(vp.h) *
+                                           vp.h / m_contentSize.h));
+            const int track = std::max(0, vp.h - thumbH);
+            const int thumbY = vp.y + static_cast<int>(
+                                          static_cast<long long>(track) *
+                                          m_offset.y / max.y);
+            renderer.drawFilledRect(
+                {vp.x + vp.w - Thickness - 1, thumbY, Thickness, thumbH},
+                m_scrollBarColor);
+        }
+        if (max.x > 0 && vp.w > 0) {
+            const int thumbW = std::max(
+                MinThumb, static_cast<int>(static_cast<long long>(vp.w) *
+                                           vp.w / m_contentSize.w));
+            const int track = std::max(0, vp.w - thumbW);
+            const int thumbX = vp.x + static_cast<int>(
+                                          static_cast<long long>(track) *
+                                          m_offset.x / max.x);
+            renderer.drawFilledRect(
+                {thumbX, vp.y + vp.h - Thickness - 1, thumbW, Thickness},
+                m_scrollBarColor);
+        }
+    }
+
+    void ScrollView::onEvent(Core::UIEvent &event) {
+        if (event.type != Core::EventType::MouseEvent || event.handled)
+            return;
+        auto &me = static_cast<Core::MouseEvent &>(event);
+        const Utils::Point max = getMaxScrollOffset();
+
+        switch (me.mouseEventType) {
+        case Core::MouseEventType::Wheel: {
+            if (!rect.contains(me.position.x, me.position.y))
+                return;
+            const int dx = m_horizontal ? me.wheelX * m_wheelStep : 0;
+            const int dy = -me.wheelY * m_wheelStep;
+            // Let an outer view scroll along an axis we cannot
+            if ((dx == 0 || max.x == 0) && (dy == 0 || max.y == 0))
+                return;
+            if (m_kinetic) {
+                // An impulse that glides exactly one step: the distance
+                // covered by v * (1 - f)^t is v / -ln(1 - f)
+                const float rate = -std::log(1.0f - m_friction);
+                m_velocity.x += dx * rate;
+                m_velocity.y += dy * rate;
+                m_lastTick = SDL_GetTicks();
+                requestKineticFrame();
+            } else {
+                scrollBy(dx, dy);
+            }
+            event.handled = true;
+            break;
+        }
+        case Core::MouseEventType::ButtonPressed:
+            if (me.button != SDL_BUTTON_LEFT ||
+                !getViewport().contains(me.position.x, me.position.y) ||
+                (max.x == 0 && max.y == 0))
+                return;
+            // Children had the chance to handle the press first
+            m_dragging = true;
+            m_dragLast = me.position;
+            m_dragTick = SDL_GetTicks();
+            stopKinetic();
+            setPointerCapture(true);
+            event.handled = true;
+            break;
+        case Core::MouseEventType::Moved: {
+            if (!m_dragging)
+                return;
+            const int dx = m_horizontal ? me.position.x - m_dragLast.x : 0;
+            const int dy = me.position.y - m_dragLast.y;
+            scrollBy(-dx, -dy);
+            const Uint32 now = SDL_GetTicks();
+            if (now > m_dragTick) {
+                // Smoothed pointer velocity, used as the fling speed
+                const float dt = (now - m_dragTick) / 1000.0f;
+                m_velocity.x = 0.8f * (-dx / dt) + 0.2f * m_velocity.x;
+                m_velocity.y = 0.8f * (-dy / dt) + 0.2f * m_velocity.y;
+            }
+            m_dragLast = me.position;
+            m_dragTick = now;
+            event.handled = true;
+            break;
+        }
+        case Core::MouseEventType::ButtonReleased:
+            if (!m_dragging || me.button != SDL_BUTTON_LEFT)
+                return;
+            m_dragging = false;
+            setPointerCapture(false);
+            m_lastTick = SDL_GetTicks();
+            if (!m_kinetic || m_lastTick - m_dragTick > FlingTimeoutMs)
+                stopKinetic();
+            else
+                requestKineticFrame();
+            m_remainderX = m_remainderY = 0.0f;
+            event.handled = true;
+            break;
+        }
+    }
+
+    void ScrollView::updateBackdrop(Core::UIContext &ctx,
+                                    Core::IRenderer &renderer) {
+        if (!renderer.isRectVisible(rect))
+            return;
+        if (backdrop) {
+            backdrop->setRect(rect);
+            backdrop->setOpacity(opacity);
+            backdrop->update(ctx, renderer);
+            return;
+        }
+        Utils::Color col = getBackgroundColor();
+        col.a = static_cast<Uint8>(col.a * getOpacity());
+        renderer.drawFilledRect(rect, col);
+
+        if (!isBorderless() && getBorderOpacity() > 0.0f) {
+            Utils::Color bc = getBorderColor();
+            bc.a = static_cast<Uint8>(bc.a * getBorderOpacity());
+            renderer.drawOutlineRect(rect, bc);
+        }
+    }
+
+} // namespace Squidl::Layouts
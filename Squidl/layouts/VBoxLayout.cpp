@@ -1,5 +1,6 @@
 #include "Squidl/layouts/VBoxLayout.h"
 #include "Squidl/elements/Backdrop.h"
+#include "Squidl/utils/Profiler.h" // For SQUIDL_PROFILE_ZONE
 #include <algorithm>
 
 using namespace Squidl;
@@ -9,7 +10,13 @@ namespace Squidl::Layouts {
     VBoxLayout::VBoxLayout(int spacing_) { spacing = spacing_; }
 
     void VBoxLayout::setRect(const Utils::UIRect &newRect) {
+        // Nothing to arrange if neither the rect nor the children changed
+        if (layoutValid && newRect == rect)
+            return;
+
+        const Utils::UIRect oldRect = rect;
         rect = newRect;
+        rectChanged(oldRect);
 
         const int innerW = std::max(0, rect.w - padding.pWidthSum());
         const int innerH = std::max(0, rect.h - padding.pHeightSum());
@@ -17,7 +24,7 @@ namespace Squidl::Layouts {
         // autosize для всех детей
         for (auto &child : children) {
             if (child)
-                child->autosize();
+                child->measure();
         }
 
         // Рассчёт высоты слота для Stretch
@@ -47,7 +54,9 @@ namespace Squidl::Layouts {
             if (!ch->isManagedByLayout())
                 continue;
 
-            auto c = ch->getRect();
+            // Desired size: the rect may still hold a stretched slot from
+            // the previous arrange
+            const Utils::Size c = ch->measure();
 
             int childH = (getVerticalAlign() == Core::VerticalAlign::Stretch)
                              ? stretchSlotH
@@ -71,10 +80,14 @@ namespace Squidl::Layouts {
         }
 
         applyConstraints();
+        layoutValid = true;
     }
 
     bool VBoxLayout::update(Core::UIContext &ctx, Core::IRenderer &renderer) {
-        if (backdrop) {
+        SQUIDL_PROFILE_ZONE_OBJ("VBoxLayout::update", this);
+        if (!renderer.isRectVisible(rect)) {
+            // Only the background is culled: children may overflow the rect
+        } else if (backdrop) {
             updateBackdrop(ctx, renderer);
         } else {
             Utils::Color col = getBackgroundColor();
@@ -91,7 +104,7 @@ namespace Squidl::Layouts {
         bool any = false;
         for (auto &ch : children) {
             if (ch)
-                any |= ch->update(ctx, renderer);
+                any |= ch->draw(ctx, renderer);
         }
         return any;
     }
@@ -109,7 +122,7 @@ namespace Squidl::Layouts {
         if (!isManagedByChilds()) {
             for (auto &ch : children)
                 if (ch)
-                    ch->autosize();
+                    ch->measure();
             applyConstraints();
             return;
         }
@@ -120,8 +133,7 @@ namespace Squidl::Layouts {
         for (auto &ch : children) {
             if (!ch)
                 continue;
-            ch->autosize();
-            auto c = ch->getRect();
+            const Utils::Size c = ch->measure();
             totalH += c.h + ch->margin.top + ch->margin.bottom;
             if (i++ < (int)children.size() - 1)
                 totalH += spacing;
@@ -0,0 +1,348 @@
+#include "Squidl/layouts/VirtualGridLayout.h"
+#include "Squidl/core/UIEvent.h"
+#include "Squidl/elements/Backdrop.h"
+#include "Squidl/utils/Logger.h"   // For logging
+#include "Squidl/utils/Profiler.h" // For SQUIDL_PROFILE_ZONE
+#include <algorithm>
+#include <limits>
+
+using namespace Squidl;
+
+namespace Squidl::Layouts {
+
+    VirtualGridLayout::VirtualGridLayout(int columns, Utils::Size itemSize,
+                                         int spacing_, int padding_)
+        : m_columns(std::max(1, columns)), m_itemSize(itemSize) {
+        m_itemSize.w = std::max(0, m_itemSize.w);
+        m_itemSize.h = std::max(1, m_itemSize.h);
+        spacing = std::max(0, spacing_);
+        padding = padding_;
+    }
+
+    void VirtualGridLayout::add(std::shared_ptr<Base::UIElement>) {
+        SQUIDL_LOG_WARNING << "VirtualGridLayout: add() is not supported, "
+                              "items come from the data source.";
+    }
+
+    void VirtualGridLayout::setDataSource(ItemFactory factory,
+                                          ItemBinder binder) {
+        releaseAll();
+        m_pool.clear(); // Old widgets may not suit the new binder
+        m_factory = std::move(factory);
+        m_binder = std::move(binder);
+        syncItems();
+        invalidate();
+    }
+
+    void VirtualGridLayout::setItemCount(std::size_t count) {
+        if (m_itemCount == count)
+            return;
+        m_itemCount = count;
+        // Items past the new end may still be bound to stale indices
+        releaseAll();
+        m_scrollOffset = std::min(m_scrollOffset, getMaxScrollOffset());
+        syncItems();
+        invalidate();
+        if (isManagedByChilds())
+            invalidateMeasure();
+    }
+
+    void VirtualGridLayout::setColumns(int value) {
+        value = std::max(1, value);
+        if (m_columns == value)
+            return;
+        m_columns = value;
+        releaseAll();
+        m_scrollOffset = std::min(m_scrollOffset, getMaxScrollOffset());
+        syncItems();
+        invalidate();
+        // Only the size computed by autosize() depends on the grid geometry
+        if (isManagedByChilds())
+            invalidateMeasure();
+    }
+
+    void VirtualGridLayout::setItemSize(Utils::Size size) {
+        size.w = std::max(0, size.w);
+        size.h = std::max(1, size.h);
+        if (m_itemSize == size)
+            return;
+        m_itemSize = size;
+        m_scrollOffset = std::min(m_scrollOffset, getMaxScrollOffset());
+        syncItems();
+        invalidate();
+        // Only the size computed by autosize() depends on the grid geometry
+        if (isManagedByChilds())
+            invalidateMeasure();
+    }
+
+    void VirtualGridLayout::refreshItems() {
+        if (!m_binder)
+            return;
+        for (std::size_t i = 0; i < m_active.size(); ++i)
+            m_binder(*m_active[i], m_first + i);
+        invalidate();
+    }
+
+    void VirtualGridLayout::refreshItem(std::size_t index) {
+        if (!m_binder || index < m_first || index >= m_first + m_active.size())
+            return;
+        auto &widget = m_active[index - m_first];
+        m_binder(*widget, index);
+        widget->invalidate();
+    }
+
+    int VirtualGridLayout::getContentHeight() const {
+        const std::size_t rows =
+            (m_itemCount + static_cast<std::size_t>(m_columns) - 1) /
+            static_cast<std::size_t>(m_columns);
+        const long long height =
+            static_cast<long long>(padding.top) + padding.bottom +
+            static_cast<long long>(rows) * m_itemSize.h +
+            static_cast<long long>(rows > 0 ? rows - 1 : 0) * spacing;
+        return static_cast<int>(
+            std::min<long long>(height, std::numeric_limits<int>::max()));
+    }
+
+    int VirtualGridLayout::getMaxScrollOffset() const {
+        return std::max(0, getContentHeight() - rect.h);
+    }
+
+    void VirtualGridLayout::setScrollOffset(int offset) {
+        offset = std::clamp(offset, 0, getMaxScrollOffset());
+        if (m_scrollOffset == offset)
+            return;
+        m_scrollOffset = offset;
+        syncItems();
+        invalidate();
+    }
+
+    void VirtualGridLayout::scrollToItem(std::size_t index) {
+        if (index >= m_itemCount)
+            return;
+        const long long row = static_cast<long long>(index) / m_columns;
+        const long long top = padding.top + row * rowHeight();
+        const long long bottom = top + m_itemSize.h;
+        if (top < m_scrollOffset + padding.top)
+            setScrollOffset(static_cast<int>(top - padding.top));
+        else if (bottom > m_scrollOffset + rect.h - padding.bottom)
+            setScrollOffset(static_cast<int>(bottom - rect.h + padding.bottom));
+    }
+
+    std::shared_ptr<Base::UIElement>
+    VirtualGridLayout::getItemWidget(std::size_t index) const {
+        if (index < m_first || index >= m_first + m_active.size())
+            return nullptr;
+        return m_active[index - m_first];
+    }
+
+    int VirtualGridLayout::cellWidth() const {
+        if (m_itemSize.w > 0)
+            return m_itemSize.w;
+        const int innerW = rect.w - padding.left - padding.right;
+        return std::max(0, (innerW - (m_columns - 1) * spacing) / m_columns);
+    }
+
+    Utils::UIRect VirtualGridLayout::itemRect(std::size_t index) const {
+        const long long row = static_cast<long long>(index) / m_columns;
+        const int col = static_cast<int>(index % m_columns);
+        const int cellW = cellWidth();
+        const long long y =
+            rect.y + padding.top + row * rowHeight() - m_scrollOffset;
+        return {rect.x + padding.left + col * (cellW + spacing),
+                static_cast<int>(y), cellW, m_itemSize.h};
+    }
+
+    std::shared_ptr<Base::UIElement> VirtualGridLayout::acquire() {
+        std::shared_ptr<Base::UIElement> widget;
+        if (!m_pool.empty()) {
+            widget = std::move(m_pool.back());
+            m_pool.pop_back();
+            return widget;
+        }
+        widget = m_factory();
+        if (!widget) {
+            SQUIDL_LOG_ERROR << "VirtualGridLayout: Item factory returned null.";
+            return nullptr;
+        }
+        widget->setParent(shared_from_this());
+        widget->setManagedByLayout(true);
+        if (!widget->getFont() && font)
+            widget->setFont(font);
+        return widget;
+    }
+
+    void VirtualGridLayout::releaseAll() {
+        for (auto &widget : m_active)
+            m_pool.push_back(std::move(widget));
+        m_active.clear();
+        m_first = 0;
+    }
+
+    void VirtualGridLayout::syncItems() {
+        if (!m_factory || !m_binder || m_itemCount == 0 || rect.h <= 0) {
+            releaseAll();
+            return;
+        }
+
+        // Rows overlapping [m_scrollOffset, m_scrollOffset + rect.h) in
+        // content coordinates
+        const long long rowH = rowHeight();
+        const long long top = static_cast<long long>(m_scrollOffset) -
+                              padding.top;
+        const long long firstRow = std::max(0LL, top / rowH);
+        const long long endRow = std::max(0LL, (top + rect.h) / rowH + 1);
+        const std::size_t cols = static_cast<std::size_t>(m_columns);
+        const std::size_t first =
+            std::min(m_itemCount, static_cast<std::size_t>(firstRow) * cols);
+        const std::size_t end =
+            std::min(m_itemCount, static_cast<std::size_t>(endRow) * cols);
+
+        // Keep widgets whose items stay visible, recycle the rest
+        std::vector<std::shared_ptr<Base::UIElement>> next(end - first);
+        for (std::size_t i = 0; i < m_active.size(); ++i) {
+            const std::size_t index = m_first + i;
+            if (index >= first && index < end)
+                next[index - first] = std::move(m_active[i]);
+            else
+                m_pool.push_back(std::move(m_active[i]));
+        }
+        m_active.clear();
+        m_first = first;
+
+        for (std::size_t i = 0; i < next.size(); ++i) {
+            if (!next[i]) {
+                next[i] = acquire();
+                if (!next[i]) {
+                    next.resize(i);
+                    break;
+                }
+                m_binder(*next[i], first + i);
+                next[i]->invalidate();
+            }
+            next[i]->setRect(itemRect(first + i));
+        }
+        m_active = std::move(next);
+    }
+
+    void VirtualGridLayout::setRect(const Utils::UIRect &newRect) {
+        if (layoutValid && newRect == rect)
+            return;
+
+        const Utils::UIRect oldRect = rect;
+        rect = newRect;
+        applyConstraints();
+        rectChanged(oldRect);
+
+        m_scrollOffset = std::min(m_scrollOffset, getMaxScrollOffset());
+        syncItems();
+        layoutValid = true;
+    }
+
+    void VirtualGridLayout::setFont(TTF_Font *f) {
+        TTF_Font *old = font;
+        UIElement::setFont(f);
+        // Widgets that got our font keep following it
+        auto follow = [&](const std::shared_ptr<Base::UIElement> &widget) {
+            if (widget && (!widget->getFont() || widget->getFont() == old))
+                widget->setFont(f);
+        };
+        for (const auto &widget : m_active)
+            follow(widget);
+        for (const auto &widget : m_pool)
+            follow(widget);
+    }
+
+    void VirtualGridLayout::autosize() {
+        if (!isManagedByChilds()) {
+            applyConstraints();
+            return;
+        }
+        const Utils::UIRect oldRect = rect;
+        if (m_itemSize.w > 0) {
+            rect.w = padding.left + padding.right +
+                     m_columns * m_itemSize.w + (m_columns - 1) * spacing;
+        }
+        rect.h = getContentHeight();
+        applyConstraints();
+        rectChanged(oldRect);
+    }
+
+    bool VirtualGridLayout::update(Core::UIContext &ctx,
+                                   Core::IRenderer &renderer) {
+        SQUIDL_PROFILE_ZONE_OBJ("VirtualGridLayout::update", this);
+        updateBackdrop(ctx, renderer);
+
+        bool any = false;
+        // Rows cut by the viewport edge must not draw outside it
+        renderer.pushClipRect(rect);
+        for (const auto &widget : m_active) {
+            if (renderer.isRectVisible(widget->getRect()))
+                any |= widget->draw(ctx, renderer);
+        }
+        renderer.popClipRect();
+        return any;
+    }
+
+    void VirtualGridLayout::onEvent(Core::UIEvent &event) {
+        if (event.type != Core::EventType::MouseEvent)
+            return;
+        auto &me = static_cast<Core::MouseEvent &>(event);
+        const bool inside = rect.contains(me.position.x, me.position.y);
+
+        std::shared_ptr<Base::UIElement> target;
+        if (inside) {
+            for (const auto &widget : m_active) {
+                if (widget->getRect().contains(me.position.x, me.position.y)) {
+                    target = widget;
+                    break;
+                }
+            }
+        }
+
+        // Same delivery rules as EventDispatcher: captured widgets, the
+        // previously hovered one and the one under the cursor
+        for (const auto &widget : m_active) {
+            if (event.handled)
+                return;
+            if (widget->hasPointerCapture() && widget != target)
+                widget->onEvent(event);
+        }
+        auto previous = m_hovered.lock();
+        m_hovered = target;
+        if (previous && previous != target && !previous->hasPointerCapture() &&
+            !event.handled)
+            previous->onEvent(event);
+        if (target && !event.handled)
+            target->onEvent(event);
+
+        if (!event.handled && inside &&
+            me.mouseEventType == Core::MouseEventType::Wheel &&
+            me.wheelY != 0) {
+            setScrollOffset(m_scrollOffset -
+                            me.wheelY * m_wheelRows * rowHeight());
+            event.handled = true;
+        }
+    }
+
+    void VirtualGridLayout::updateBackdrop(Core::UIContext &ctx,
+                                           Core::IRenderer &renderer) {
+        if (!renderer.isRectVisible(rect))
+            return;
+        if (backdrop) {
+            backdrop->setRect(rect);
+            backdrop->setOpacity(opacity);
+            backdrop->update(ctx, renderer);
+            return;
+        }
+        Utils::Color col = getBackgroundColor();
+        col.a = static_cast<Uint8>(col.a * getOpacity());
+        renderer.drawFilledRect(rect, col);
+
+        if (!isBorderless() && getBorderOpacity() > 0.0f) {
+            Utils::Color bc = getBorderColor();
+            bc.a = static_cast<Uint8>(bc.a * getBorderOpacity());
+            renderer.drawOutlineRect(rect, bc);
+        }
+    }
+
+} // namespace Squidl::Layouts
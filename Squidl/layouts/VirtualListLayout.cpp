@@ -0,0 +1,9 @@
+#include "Squidl/layouts/VirtualListLayout.h"
+
+namespace Squidl::Layouts {
+
+    VirtualListLayout::VirtualListLayout(int rowHeight, int spacing_,
+                                         int padding_)
+        : VirtualGridLayout(1, {0, rowHeight}, spacing_, padding_) {}
+
+} // namespace Squidl::Layouts
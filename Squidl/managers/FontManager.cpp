@@ -0,0 +1,118 @@
+#include "Squidl/managers/FontManager.h"
+#include "Squidl/managers/ResourceManager.h" // For archived fonts
+#include "Squidl/utils/Logger.h" // For logging
+#include <SDL.h>                 // For SDL_RWFromConstMem
+
+namespace Squidl::Managers {
+
+    FontManager::Face::~Face() {
+        if (font)
+            TTF_CloseFont(font);
+    }
+
+    FontManager::~FontManager() {
+        evictUnused();
+        if (!m_faces.empty()) {
+            SQUIDL_LOG_DEBUG << "FontManager: " << m_faces.size()
+                             << " fonts are still in use and close with "
+                                "their last handle.";
+        }
+    }
+
+    FontHandle FontManager::load(const std::string &path, int size,
+                                 int style) {
+        const FaceKey key{path, size, style};
+        auto it = m_faces.find(key);
+        if (it != m_faces.end()) {
+            ++m_stats.hits;
+            const auto &face = it->second;
+            return FontHandle(face, face->font);
+        }
+
+        // The face reads the mapping for as long as it is open, so the RW
+        // only wraps it and the Face keeps the mapping (or archive) alive
+        ResourceView source =
+            m_resources ? m_resources->find(path) : ResourceView();
+        std::shared_ptr<Squidl::Utils::MappedFile> file = source.archive;
+        if (!source) {
+            file = mapFile(path);
+            if (!file)
+                return nullptr;
+            source.data = file->data();
+            source.size = file->size();
+        }
+
+        SDL_RWops *rw =
+            SDL_RWFromConstMem(source.data, static_cast<int>(source.size));
+        TTF_Font *font = rw ? TTF_OpenFontRW(rw, 1, size) : nullptr;
+        if (!font) {
+            SQUIDL_LOG_ERROR << "FontManager: Failed to open " << path
+                             << " at size " << size << ": " << TTF_GetError();
+            return nullptr;
+        }
+        TTF_SetFontStyle(font, style);
+
+        auto face = std::make_shared<Face>();
+        face->font = font;
+        face->file = std::move(file);
+        m_faces.emplace(key, face);
+        ++m_stats.misses;
+        m_stats.faces = m_faces.size();
+        updateFileStats();
+        SQUIDL_LOG_DEBUG << "FontManager: Opened " << path << " at size "
+                         << size << ".";
+        return FontHandle(face, face->font);
+    }
+
+    std::size_t FontManager::evictUnused() {
+        std::size_t closed = 0;
+        for (auto it = m_faces.begin(); it != m_faces.end();) {
+            // Only the cache refers to the face
+            if (it->second.use_count() == 1) {
+                if (m_onEvict)
+                    m_onEvict(it->second->font);
+                it = m_faces.erase(it);
+                ++closed;
+            } else {
+                ++it;
+            }
+        }
+        m_stats.evictions += closed;
+        m_stats.faces = m_faces.size();
+        updateFileStats();
+        return closed;
+    }
+
+    std::shared_ptr<Squidl::Utils::MappedFile>
+    FontManager::mapFile(const std::string &path) {
+        auto it = m_files.find(path);
+        if (it != m_files.end()) {
+            if (auto file = it->second.lock())
+                return file;
+        }
+
+        auto file = std::make_shared<Squidl::Utils::MappedFile>();
+        if (!file->openRead(path)) {
+            SQUIDL_LOG_ERROR << "FontManager: Failed to map " << path << ": "
+                             << file->getError();
+            return nullptr;
+        }
+        m_files[path] = file;
+        return file;
+    }
+
+    void FontManager::updateFileStats() {
+        m_stats.files = 0;
+        m_stats.mappedBytes = 0;
+        for (auto it = m_files.begin(); it != m_files.end();) {
+            if (auto file = it->second.lock()) {
+                ++m_stats.files;
+                m_stats.mappedBytes += file->size();
+                ++it;
+            } else {
+                it = m_files.erase(it);
+            }
+        }
+    }
+
+} // namespace Squidl::Managers
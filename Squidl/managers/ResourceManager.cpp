@@ -0,0 +1,148 @@
+#include "Squidl/managers/ResourceManager.h"
+#include "Squidl/utils/Logger.h"     // For logging
+#include "Squidl/utils/PackFormat.h" // For the archive layout
+#include <climits>                   // For INT_MAX
+#include <cstring>                   // For std::memcmp, std::memcpy
+
+namespace Squidl::Managers {
+
+    namespace Pack = Squidl::Utils::Pack;
+
+    namespace {
+        // SDL_RWFromConstMem rejects a size of 0, so empty entries get a
+        // stream that is always at its end
+        SDL_RWops *openEmptyRW() {
+            SDL_RWops *rw = SDL_AllocRW();
+            if (!rw)
+                return nullptr;
+            rw->type = SDL_RWOPS_UNKNOWN;
+            rw->size = [](SDL_RWops *) -> Sint64 { return 0; };
+            rw->seek = [](SDL_RWops *, Sint64 offset, int whence) -> Sint64 {
+                if (whence != RW_SEEK_SET && whence != RW_SEEK_CUR &&
+                    whence != RW_SEEK_END)
+                    return SDL_SetError("Unknown value for 'whence'");
+                return offset == 0 ? 0 : SDL_SetError("Seek past empty file");
+            };
+            rw->read = [](SDL_RWops *, void *, size_t, size_t) -> size_t {
+                return 0;
+            };
+            rw->write = [](SDL_RWops *, const void *, size_t,
+                           size_t) -> size_t {
+                SDL_SetError("Can't write to read-only memory");
+                return 0;
+            };
+            rw->close = [](SDL_RWops *context) -> int {
+                SDL_FreeRW(context);
+                return 0;
+            };
+            return rw;
+        }
+    } // namespace
+
+    bool ResourceManager::mount(const std::string &archivePath) {
+        auto archive = std::make_shared<Squidl::Utils::MappedFile>();
+        if (!archive->openRead(archivePath)) {
+            SQUIDL_LOG_ERROR << "ResourceManager: Failed to map "
+                             << archivePath << ": " << archive->getError();
+            return false;
+        }
+
+        const std::uint8_t *base = archive->data();
+        const std::size_t size = archive->size();
+        Pack::FileHeader header;
+        if (size < sizeof(header)) {
+            SQUIDL_LOG_ERROR << "ResourceManager: " << archivePath
+                             << " is not an asset archive.";
+            return false;
+        }
+        std::memcpy(&header, base, sizeof(header));
+        if (std::memcmp(header.magic, Pack::FileMagic,
+                        sizeof(Pack::FileMagic)) != 0) {
+            SQUIDL_LOG_ERROR << "ResourceManager: " << archivePath
+                             << " is not an asset archive.";
+            return false;
+        }
+        if (header.version != Pack::FormatVersion) {
+            SQUIDL_LOG_ERROR << "ResourceManager: " << archivePath
+                             << " has unsupported version " << header.version
+                             << ".";
+            return false;
+        }
+        // Paths are padded to IndexAlignment relative to the archive start,
+        // so an unaligned index could end in the middle of the padding
+        if (header.fileSize != size || header.indexOffset > size ||
+            header.indexSize > size - header.indexOffset ||
+            header.indexOffset % Pack::IndexAlignment != 0 ||
+            header.indexSize % Pack::IndexAlignment != 0 ||
+            header.entryCount > header.indexSize / sizeof(Pack::IndexEntry)) {
+            SQUIDL_LOG_ERROR << "ResourceManager: " << archivePath
+                             << " is corrupt (bad header).";
+            return false;
+        }
+
+        // Validate the whole index before adding any of it. entryCount is
+        // bounded by the index size above, so reserving for it is safe
+        std::vector<std::pair<std::string, Entry>> entries;
+        entries.reserve(static_cast<std::size_t>(header.entryCount));
+        const std::size_t archiveIndex = m_archives.size();
+        std::uint64_t offset = header.indexOffset;
+        const std::uint64_t indexEnd = header.indexOffset + header.indexSize;
+        for (std::uint64_t i = 0; i < header.entryCount; ++i) {
+            Pack::IndexEntry entry;
+            if (offset > indexEnd || indexEnd - offset < sizeof(entry)) {
+                SQUIDL_LOG_ERROR << "ResourceManager: " << archivePath
+                                 << " is corrupt (truncated index).";
+                return false;
+            }
+            std::memcpy(&entry, base + offset, sizeof(entry));
+            offset += sizeof(entry);
+            if (offset > indexEnd || indexEnd - offset < entry.pathLength ||
+                entry.offset > size || entry.size > size - entry.offset ||
+                entry.size > static_cast<std::uint64_t>(INT_MAX)) {
+                SQUIDL_LOG_ERROR << "ResourceManager: " << archivePath
+                                 << " is corrupt (bad entry " << i << ").";
+                return false;
+            }
+            entries.emplace_back(
+                std::string(reinterpret_cast<const char *>(base + offset),
+                            entry.pathLength),
+                Entry{base + entry.offset,
+                      static_cast<std::size_t>(entry.size), archiveIndex});
+            offset = Pack::alignUp(offset + entry.pathLength,
+                                   Pack::IndexAlignment);
+        }
+
+        m_archives.push_back(std::move(archive));
+        for (auto &entry : entries)
+            m_entries[std::move(entry.first)] = entry.second;
+        SQUIDL_LOG_INFO << "ResourceManager: Mounted " << archivePath << " ("
+                        << entries.size() << " files).";
+        return true;
+    }
+
+    ResourceView ResourceManager::find(const std::string &path) const {
+        auto it = m_entries.find(path);
+        if (it == m_entries.end())
+            return {};
+        return {it->second.data, it->second.size,
+                m_archives[it->second.archive]};
+    }
+
+    SDL_RWops *ResourceManager::openRW(const std::string &path) const {
+        auto it = m_entries.find(path);
+        SDL_RWops *rw = nullptr;
+        if (it == m_entries.end())
+            rw = SDL_RWFromFile(path.c_str(), "rb");
+        else if (it->second.size == 0)
+            rw = openEmptyRW();
+        else
+            rw = SDL_RWFromConstMem(it->second.data,
+                                    static_cast<int>(it->second.size));
+        if (!rw) {
+            SQUIDL_LOG_ERROR << "ResourceManager: Failed to open " << path
+                             << ": " << SDL_GetError();
+        }
+        return rw;
+    }
+
+} // namespace Squidl::Managers
@@ -0,0 +1,371 @@
+#include "Squidl/managers/TextureManager.h"
+#include "Squidl/renderers/QuadBatch.h" // For QuadBatch::destroyTexture
+#include "Squidl/utils/Logger.h"   // For logging
+#include "Squidl/utils/Profiler.h" // For SQUIDL_PROFILE_ZONE
+#include <SDL_image.h>             // For IMG_Load, IMG_Load_RW
+#include <algorithm>               // For std::min, std::clamp
+#include <chrono>                  // For std::chrono::steady_clock
+
+namespace Squidl::Managers {
+
+    namespace {
+        // Rows uploaded per SDL_UpdateTexture call: 64 rows of a 4K image
+        // are about 1 MB
+        constexpr int UploadBandRows = 64;
+        constexpr unsigned MaxWorkers = 4;
+        // Cache entries below which released textures are not swept
+        constexpr std::size_t MinSweepSize = 64;
+
+        // Rounded average of four opaque ARGB8888 pixels. Two channels are
+        // summed per word, 16 bits apart, so four samples never overflow
+        // into the next channel.
+        inline Uint32 averageOpaque4(Uint32 a, Uint32 b, Uint32 c, Uint32 d) {
+            constexpr Uint32 Mask = 0x00FF00FFu;
+            constexpr Uint32 Half = 0x00020002u; // Rounds each sum of four
+            const Uint32 rb =
+                (a & Mask) + (b & Mask) + (c & Mask) + (d & Mask) + Half;
+            const Uint32 ag = ((a >> 8) & Mask) + ((b >> 8) & Mask) +
+                              ((c >> 8) & Mask) + ((d >> 8) & Mask) + Half;
+            return ((rb >> 2) & Mask) | (((ag >> 2) & Mask) << 8);
+        }
+
+        // Averages four ARGB8888 pixels weighted by their alpha, i.e.
+        // premultiplied, averaged and divided back. A straight average
+        // would bleed the colour of transparent texels (often black) into
+        // the edges of icons and text.
+        inline Uint32 average4(Uint32 a, Uint32 b, Uint32 c, Uint32 d) {
+            if ((a & b & c & d) >> 24 == 0xFF)
+                return averageOpaque4(a, b, c, d);
+            const Uint32 pixels[4] = {a, b, c, d};
+            Uint32 alpha = 0;
+            Uint32 sums[3] = {0, 0, 0}; // R, G, B times alpha
+            for (Uint32 p : pixels) {
+                const Uint32 pa = p >> 24;
+                alpha += pa;
+                sums[0] += ((p >> 16) & 0xFF) * pa;
+                sums[1] += ((p >> 8) & 0xFF) * pa;
+                sums[2] += (p & 0xFF) * pa;
+            }
+            if (alpha == 0)
+                return 0;
+            Uint32 out = ((alpha + 2) >> 2) << 24;
+            for (int i = 0; i < 3; ++i)
+                out |= ((sums[i] + alpha / 2) / alpha) << (16 - 8 * i);
+            return out;
+        }
+
+        // Box-filters an ARGB8888 surface to half its size. Odd edges reuse
+        // their last row or column.
+        SDL_Surface *downscale(const SDL_Surface *src) {
+            const int w = std::max(1, src->w / 2);
+            const int h = std::max(1, src->h / 2);
+            SDL_Surface *dst = SDL_CreateRGBSurfaceWithFormat(
+                0, w, h, 32, SDL_PIXELFORMAT_ARGB8888);
+            if (!dst)
+                return nullptr;
+            const auto *in = static_cast<const Uint8 *>(src->pixels);
+            auto *out = static_cast<Uint8 *>(dst->pixels);
+            for (int y = 0; y < h; ++y) {
+                const auto *row0 = reinterpret_cast<const Uint32 *>(
+                    in + static_cast<std::size_t>(std::min(2 * y, src->h - 1)) *
+                             src->pitch);
+                const auto *row1 = reinterpret_cast<const Uint32 *>(
+                    in +
+                    static_cast<std::size_t>(std::min(2 * y + 1, src->h - 1)) *
+                        src->pitch);
+                auto *row = reinterpret_cast<Uint32 *>(
+                    out + static_cast<std::size_t>(y) * dst->pitch);
+                for (int x = 0; x < w; ++x) {
+                    const int x0 = std::min(2 * x, src->w - 1);
+                    const int x1 = std::min(2 * x + 1, src->w - 1);
+                    row[x] = average4(row0[x0], row0[x1], row1[x0], row1[x1]);
+                }
+            }
+            return dst;
+        }
+    } // namespace
+
+    TextureResource::~TextureResource() {
+        for (const Level &level : m_levels)
+            Squidl::Renderers::QuadBatch::destroyTexture(level.texture);
+    }
+
+    SDL_Texture *TextureResource::getForSize(int w, int h) const {
+        if (!isReady())
+            return nullptr;
+        // Levels shrink, so the last one still covering the rect wins
+        std::size_t best = 0;
+        for (std::size_t i = 1; i < m_levels.size(); ++i) {
+            if (m_levels[i].width < w || m_levels[i].height < h)
+                break;
+            best = i;
+        }
+        return m_levels[best].texture;
+    }
+
+    TextureManager::TextureManager(SDL_Renderer *renderer, unsigned workers)
+        : m_sdlRenderer(renderer), m_sweepAt(MinSweepSize) {
+        if (workers == 0) {
+            // Leave a hardware thread to the render thread
+            const unsigned hardware = std::thread::hardware_concurrency();
+            workers = std::clamp(hardware > 1 ? hardware - 1 : 1u, 1u,
+                                 MaxWorkers);
+        }
+        m_workers.reserve(workers);
+        for (unsigned i = 0; i < workers; ++i)
+            m_workers.emplace_back(&TextureManager::workerLoop, this);
+    }
+
+    TextureManager::~TextureManager() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        m_wake.notify_all();
+        for (std::thread &worker : m_workers)
+            worker.join();
+
+        // Textures still loading stay Pending
+        if (m_current)
+            releaseLevels(*m_current);
+        for (auto &job : m_uploadQueue)
+            releaseLevels(*job);
+    }
+
+    TextureHandle
+    TextureManager::load(const std::string &path,
+                         TextureResource::ReadyCallback onReady) {
+        auto it = m_textures.find(path);
+        if (it != m_textures.end()) {
+            if (TextureHandle texture = it->second.lock()) {
+                ++m_hits;
+                if (onReady && texture->m_state == TextureState::Pending)
+                    texture->m_onReady.push_back(std::move(onReady));
+                return texture;
+            }
+        }
+
+        // Forget released textures once the map has doubled since the last
+        // sweep, so loading many distinct paths keeps it bounded
+        if (m_textures.size() >= m_sweepAt) {
+            for (auto entry = m_textures.begin(); entry != m_textures.end();) {
+                if (entry->second.expired())
+                    entry = m_textures.erase(entry);
+                else
+                    ++entry;
+            }
+            m_sweepAt = std::max(MinSweepSize, 2 * m_textures.size());
+        }
+
+        auto texture = std::make_shared<TextureResource>(path);
+        if (onReady)
+            texture->m_onReady.push_back(std::move(onReady));
+        m_textures[path] = texture;
+        ++m_misses;
+
+        auto job = std::make_unique<Job>();
+        job->path = path;
+        job->target = texture;
+        job->mipmaps = m_mipmaps;
+        // Looked up here: the resource manager is not safe to use from the
+        // workers
+        if (m_resources)
+            job->source = m_resources->find(path);
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_decodeQueue.push_back(std::move(job));
+        }
+        m_wake.notify_one();
+        return texture;
+    }
+
+    std::size_t TextureManager::processUploads(double budgetMs) {
+        SQUIDL_PROFILE_ZONE_OBJ("TextureManager::processUploads", this);
+        using Clock = std::chrono::steady_clock;
+        const Clock::time_point start = Clock::now();
+        std::size_t finished = 0;
+
+        for (;;) {
+            if (!m_current) {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (m_uploadQueue.empty())
+                    break;
+                m_current = std::move(m_uploadQueue.front());
+                m_uploadQueue.pop_front();
+            }
+
+            Job &job = *m_current;
+            TextureHandle texture = job.target.lock();
+            if (texture &&
+                (job.levels.empty() || uploadBand(job, *texture))) {
+                finish(job, *texture);
+                ++finished;
+            }
+            if (!texture || texture->m_state != TextureState::Pending) {
+                releaseLevels(job);
+                m_current.reset();
+            }
+
+            const std::chrono::duration<double, std::milli> elapsed =
+                Clock::now() - start;
+            if (elapsed.count() >= budgetMs)
+                break;
+        }
+        return finished;
+    }
+
+    bool TextureManager::uploadBand(Job &job, TextureResource &texture) {
+        SDL_Surface *surface = job.levels[job.uploadLevel];
+        if (texture.m_levels.size() <= job.uploadLevel) {
+            SDL_Texture *created = SDL_CreateTexture(
+                m_sdlRenderer, SDL_PIXELFORMAT_ARGB8888,
+                SDL_TEXTUREACCESS_STATIC, surface->w, surface->h);
+            if (!created) {
+                job.error = SDL_GetError();
+                return true; // Finished, as Failed
+            }
+            SDL_SetTextureBlendMode(created, SDL_BLENDMODE_BLEND);
+            // Levels are picked to be minified by less than 2x, where
+            // linear filtering is enough
+            if (job.levels.size() > 1)
+                SDL_SetTextureScaleMode(created, SDL_ScaleModeLinear);
+            texture.m_levels.push_back({created, surface->w, surface->h});
+        }
+        SDL_Texture *target = texture.m_levels[job.uploadLevel].texture;
+
+        const int rows = std::min(UploadBandRows, surface->h - job.uploadedRows);
+        const SDL_Rect band{0, job.uploadedRows, surface->w, rows};
+        const auto *pixels = static_cast<const Uint8 *>(surface->pixels) +
+                             static_cast<std::size_t>(job.uploadedRows) *
+                                 surface->pitch;
+        if (SDL_UpdateTexture(target, &band, pixels, surface->pitch) != 0) {
+            job.error = SDL_GetError();
+            return true;
+        }
+        job.uploadedRows += rows;
+        m_uploadedBytes += static_cast<std::size_t>(rows) * surface->pitch;
+        if (job.uploadedRows >= surface->h) {
+            ++job.uploadLevel;
+            job.uploadedRows = 0;
+        }
+        return job.uploadLevel >= job.levels.size();
+    }
+
+    void TextureManager::finish(Job &job, TextureResource &texture) {
+        if (job.error.empty()) {
+            texture.m_state = TextureState::Ready;
+            SQUIDL_LOG_DEBUG << "TextureManager: Loaded " << job.path << " ("
+                             << texture.getWidth() << "x"
+                             << texture.getHeight() << ", "
+                             << texture.m_levels.size() << " levels).";
+        } else {
+            texture.m_state = TextureState::Failed;
+            for (const auto &level : texture.m_levels)
+                Squidl::Renderers::QuadBatch::destroyTexture(level.texture);
+            texture.m_levels.clear();
+            ++m_failed;
+            SQUIDL_LOG_ERROR << "TextureManager: Failed to load texture from "
+                                "file '"
+                             << job.path << "': " << job.error;
+        }
+
+        // A callback may load more textures, so run them from a copy
+        std::vector<TextureResource::ReadyCallback> callbacks;
+        callbacks.swap(texture.m_onReady);
+        for (auto &callback : callbacks)
+            callback(texture);
+    }
+
+    void TextureManager::workerLoop() {
+        for (;;) {
+            std::unique_ptr<Job> job;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_wake.wait(lock,
+                            [&] { return m_stop || !m_decodeQueue.empty(); });
+                if (m_stop)
+                    return;
+                job = std::move(m_decodeQueue.front());
+                m_decodeQueue.pop_front();
+                ++m_decoding;
+            }
+
+            if (!job->target.expired())
+                decode(*job);
+            // Every handle may have gone away while the job was queued or
+            // decoding
+            const bool wanted = !job->target.expired();
+            if (!wanted)
+                releaseLevels(*job);
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            --m_decoding;
+            if (wanted)
+                m_uploadQueue.push_back(std::move(job));
+        }
+    }
+
+    void TextureManager::decode(Job &job) {
+        SQUIDL_PROFILE_ZONE("TextureManager::decode");
+        SDL_Surface *loaded =
+            job.source ? IMG_Load_RW(SDL_RWFromConstMem(
+                                         job.source.data,
+                                         static_cast<int>(job.source.size)),
+                                     1)
+                       : IMG_Load(job.path.c_str());
+        if (!loaded) {
+            job.error = IMG_GetError();
+            return;
+        }
+        // One pixel format lets the render thread upload rows as they are
+        SDL_Surface *surface =
+            SDL_ConvertSurfaceFormat(loaded, SDL_PIXELFORMAT_ARGB8888, 0);
+        SDL_FreeSurface(loaded);
+        if (!surface) {
+            job.error = SDL_GetError();
+            return;
+        }
+        job.levels.push_back(surface);
+
+        while (job.mipmaps &&
+               std::max(surface->w, surface->h) / 2 >= MinMipSize) {
+            surface = downscale(surface);
+            if (!surface)
+                break; // Keep the levels made so far
+            job.levels.push_back(surface);
+        }
+    }
+
+    void TextureManager::releaseLevels(Job &job) {
+        for (SDL_Surface *level : job.levels)
+            SDL_FreeSurface(level);
+        job.levels.clear();
+    }
+
+    bool TextureManager::isLoading() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_current || m_decoding > 0 || !m_decodeQueue.empty() ||
+               !m_uploadQueue.empty();
+    }
+
+    TextureManagerStats TextureManager::getStats() const {
+        TextureManagerStats stats;
+        for (const auto &entry : m_textures) {
+            if (!entry.second.expired())
+                ++stats.textures;
+        }
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            stats.decoding = m_decodeQueue.size() + m_decoding;
+            stats.uploading = m_uploadQueue.size();
+        }
+        if (m_current)
+            ++stats.uploading;
+        stats.uploadedBytes = m_uploadedBytes;
+        stats.hits = m_hits;
+        stats.misses = m_misses;
+        stats.failed = m_failed;
+        return stats;
+    }
+
+} // namespace Squidl::Managers
@@ -0,0 +1,313 @@
+// squidl/renderers/GlyphAtlas.cpp
+#include "Squidl/renderers/GlyphAtlas.h"
+#include "Squidl/utils/Logger.h" // For logging
+#include <algorithm>             // For std::min, std::max
+#include <functional>            // For std::hash
+
+namespace Squidl::Renderers {
+
+    namespace {
+        // Gap kept between glyphs so linear filtering never samples a
+        // neighbour
+        constexpr int GlyphPadding = 1;
+
+        // Decodes the next UTF-8 sequence starting at 'pos' and advances it.
+        // Malformed input yields U+FFFD.
+        Uint32 nextCodepoint(const std::string &text, std::size_t &pos) {
+            const auto byte = [&](std::size_t i) {
+                return static_cast<unsigned char>(text[i]);
+            };
+            const unsigned char lead = byte(pos);
+            int length = 1;
+            Uint32 cp = lead;
+            if (lead >= 0xF0) {
+                length = 4;
+                cp = lead & 0x07;
+            } else if (lead >= 0xE0) {
+                length = 3;
+                cp = lead & 0x0F;
+            } else if (lead >= 0xC0) {
+                length = 2;
+                cp = lead & 0x1F;
+            } else if (lead >= 0x80) {
+                ++pos;
+                return 0xFFFD;
+            }
+            if (pos + length > text.size()) {
+                pos = text.size();
+                return 0xFFFD;
+            }
+            for (int i = 1; i < length; ++i) {
+                const unsigned char next = byte(pos + i);
+                if ((next & 0xC0) != 0x80) {
+                    pos += i;
+                    return 0xFFFD;
+                }
+                cp = (cp << 6) | (next & 0x3F);
+            }
+            pos += length;
+            return cp;
+        }
+    } // namespace
+
+    std::size_t
+    GlyphAtlas::FontKeyHash::operator()(const FontKey &key) const {
+        return std::hash<const void *>{}(key.font) ^
+               (std::hash<int>{}(key.style) << 1);
+    }
+
+    GlyphAtlas::GlyphAtlas(SDL_Renderer *renderer, int pageSize,
+                           int maxPages)
+        : m_sdlRenderer(renderer), m_pageSize(pageSize),
+          m_maxPages(std::max(maxPages, 1)) {}
+
+    GlyphAtlas::~GlyphAtlas() { clear(); }
+
+    bool GlyphAtlas::drawText(TTF_Font *font, const std::string &text,
+                              Squidl::Utils::Color color, int x, int y) {
+        if (!m_sdlRenderer || !font || text.empty())
+            return false;
+
+        GlyphMap &glyphs = m_fonts[FontKey{font, TTF_GetFontStyle(font)}];
+        const bool kerning = TTF_GetFontKerning(font) != 0;
+        const SDL_Color vertexColor = color;
+
+        m_vertices.clear();
+        m_indices.clear();
+
+        int currentPage = -1;
+        int penX = x;
+        Uint32 previous = 0;
+        std::size_t pos = 0;
+        while (pos < text.size()) {
+            const Uint32 cp = nextCodepoint(text, pos);
+            const Glyph *glyph = findOrRasterize(font, glyphs, cp);
+            if (!glyph)
+                continue;
+
+            if (kerning && previous)
+                penX += TTF_GetFontKerningSizeGlyphs32(font, previous, cp);
+            previous = cp;
+
+            if (glyph->page >= 0) {
+                // Glyphs living on another page go out in their own batch
+                if (glyph->page != currentPage) {
+                    flush(currentPage);
+                    currentPage = glyph->page;
+                }
+
+                const float inv = 1.0f / static_cast<float>(m_pageSize);
+                const float x0 = static_cast<float>(penX + glyph->offsetX);
+                const float y0 = static_cast<float>(y);
+                const float x1 = x0 + glyph->src.w;
+                const float y1 = y0 + glyph->src.h;
+                const float u0 = glyph->src.x * inv;
+                const float v0 = glyph->src.y * inv;
+                const float u1 = (glyph->src.x + glyph->src.w) * inv;
+                const float v1 = (glyph->src.y + glyph->src.h) * inv;
+
+                const int base = static_cast<int>(m_vertices.size());
+                m_vertices.push_back({{x0, y0}, vertexColor, {u0, v0}});
+                m_vertices.push_back({{x1, y0}, vertexColor, {u1, v0}});
+                m_vertices.push_back({{x1, y1}, vertexColor, {u1, v1}});
+                m_vertices.push_back({{x0, y1}, vertexColor, {u0, v1}});
+                m_indices.insert(m_indices.end(), {base, base + 1, base + 2,
+                                                   base, base + 2, base + 3});
+                ++m_stats.quads;
+            }
+            penX += glyph->advance;
+        }
+
+        flush(currentPage);
+        return true;
+    }
+
+    void GlyphAtlas::removeFont(TTF_Font *font) {
+        for (auto it = m_fonts.begin(); it != m_fonts.end();) {
+            if (it->first.font == font) {
+                m_stats.glyphs -= it->second.size();
+                for (const auto &[codepoint, glyph] : it->second) {
+                    if (glyph.page >= 0)
+                        --m_pages[glyph.page].glyphs;
+                }
+                it = m_fonts.erase(it);
+            } else {
+                ++it;
+            }
+        }
+
+        // Glyphs cannot be removed from a packer one by one, but a page left
+        // without glyphs starts over
+        for (Page &page : m_pages) {
+            if (page.glyphs == 0 && page.packer.getOccupancy() > 0.0f) {
+                clearPage(page.texture);
+                page.packer.reset(m_pageSize, m_pageSize);
+            }
+        }
+    }
+
+    void GlyphAtlas::clear() {
+        for (auto &page : m_pages) {
+            if (page.texture)
+                SDL_DestroyTexture(page.texture);
+        }
+        m_pages.clear();
+        m_fonts.clear();
+        m_stats.glyphs = 0;
+        m_stats.pages = 0;
+        m_warnedFull = false;
+    }
+
+    void GlyphAtlas::resetCounters() {
+        m_stats.rasterized = 0;
+        m_stats.drawCalls = 0;
+        m_stats.quads = 0;
+        m_stats.rejected = 0;
+    }
+
+    const GlyphAtlas::Glyph *GlyphAtlas::findOrRasterize(TTF_Font *font,
+                                                         GlyphMap &glyphs,
+                                                         Uint32 codepoint) {
+        auto found = glyphs.find(codepoint);
+        if (found != glyphs.end())
+            return &found->second;
+
+        Glyph glyph;
+        int minX = 0, maxX = 0, minY = 0, maxY = 0, advance = 0;
+        if (TTF_GlyphMetrics32(font, codepoint, &minX, &maxX, &minY, &maxY,
+                               &advance) != 0) {
+            // Unknown glyphs are remembered too, so they are not retried
+            ++m_stats.glyphs;
+            return &glyphs.emplace(codepoint, glyph).first->second;
+        }
+        glyph.advance = advance;
+        // TTF_RenderGlyph32 shifts glyphs with a negative bearing right
+        glyph.offsetX = std::min(0, minX);
+
+        SDL_Surface *surface =
+            TTF_RenderGlyph32_Blended(font, codepoint, {255, 255, 255, 255});
+        if (surface) {
+            if (surface->w > 0 && surface->h > 0)
+                placeGlyph(surface, glyph);
+            SDL_FreeSurface(surface);
+        }
+
+        ++m_stats.rasterized;
+        ++m_stats.glyphs;
+        return &glyphs.emplace(codepoint, glyph).first->second;
+    }
+
+    bool GlyphAtlas::placeGlyph(SDL_Surface *surface, Glyph &glyph) {
+        const int w = surface->w + GlyphPadding;
+        const int h = surface->h + GlyphPadding;
+        if (w > m_pageSize || h > m_pageSize) {
+            SQUIDL_LOG_WARNING << "GlyphAtlas: Glyph of " << surface->w << "x"
+                               << surface->h
+                               << " does not fit into an atlas page.";
+            ++m_stats.rejected;
+            return false;
+        }
+
+        // Converted before a slot is taken: the packer cannot give it back
+        SDL_Surface *converted = surface;
+        if (surface->format->format != SDL_PIXELFORMAT_ARGB8888) {
+            converted =
+                SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_ARGB8888, 0);
+            if (!converted) {
+                SQUIDL_LOG_ERROR << "GlyphAtlas: Failed to convert glyph: "
+                                 << SDL_GetError();
+                ++m_stats.rejected;
+                return false;
+            }
+        }
+
+        // Earlier pages may still have room, e.g. after removeFont()
+        Squidl::Utils::UIRect slot;
+        int page = 0;
+        const int pageCount = static_cast<int>(m_pages.size());
+        while (page < pageCount && !m_pages[page].packer.insert(w, h, slot))
+            ++page;
+        if (page == pageCount) {
+            if (pageCount >= m_maxPages) {
+                if (!m_warnedFull) {
+                    SQUIDL_LOG_WARNING << "GlyphAtlas: All " << m_maxPages
+                                       << " atlas pages are full, new glyphs "
+                                          "are not drawn.";
+                    m_warnedFull = true;
+                }
+                if (converted != surface)
+                    SDL_FreeSurface(converted);
+                ++m_stats.rejected;
+                return false;
+            }
+            if (!addPage() || !m_pages[page].packer.insert(w, h, slot)) {
+                if (converted != surface)
+                    SDL_FreeSurface(converted);
+                ++m_stats.rejected;
+                return false;
+            }
+        }
+
+        const SDL_Rect dst{slot.x, slot.y, surface->w, surface->h};
+        const bool uploaded =
+            SDL_UpdateTexture(m_pages[page].texture, &dst, converted->pixels,
+                              converted->pitch) == 0;
+        if (converted != surface)
+            SDL_FreeSurface(converted);
+        if (!uploaded) {
+            SQUIDL_LOG_ERROR << "GlyphAtlas: Failed to upload glyph: "
+                             << SDL_GetError();
+            ++m_stats.rejected;
+            return false;
+        }
+
+        ++m_pages[page].glyphs;
+        glyph.page = page;
+        glyph.src = dst;
+        return true;
+    }
+
+    bool GlyphAtlas::addPage() {
+        SDL_Texture *texture =
+            SDL_CreateTexture(m_sdlRenderer, SDL_PIXELFORMAT_ARGB8888,
+                              SDL_TEXTUREACCESS_STATIC, m_pageSize, m_pageSize);
+        if (!texture) {
+            SQUIDL_LOG_ERROR << "GlyphAtlas: Failed to create atlas page: "
+                             << SDL_GetError();
+            return false;
+        }
+        SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+        clearPage(texture);
+
+        Page page;
+        page.texture = texture;
+        page.packer.reset(m_pageSize, m_pageSize);
+        m_pages.push_back(std::move(page));
+        m_stats.pages = m_pages.size();
+        SQUIDL_LOG_DEBUG << "GlyphAtlas: Allocated atlas page "
+                         << m_pages.size() << ".";
+        return true;
+    }
+
+    void GlyphAtlas::clearPage(SDL_Texture *texture) {
+        // Start from fully transparent pixels: the texture content is
+        // undefined otherwise, and padding must not keep old glyphs
+        std::vector<Uint32> blank(static_cast<std::size_t>(m_pageSize) *
+                                  m_pageSize);
+        SDL_UpdateTexture(texture, nullptr, blank.data(),
+                          m_pageSize * static_cast<int>(sizeof(Uint32)));
+    }
+
+    void GlyphAtlas::flush(int page) {
+        if (page < 0 || m_indices.empty())
+            return;
+        SDL_RenderGeometry(m_sdlRenderer, m_pages[page].texture,
+                           m_vertices.data(),
+                           static_cast<int>(m_vertices.size()),
+                           m_indices.data(), static_cast<int>(m_indices.size()));
+        ++m_stats.drawCalls;
+        m_vertices.clear();
+        m_indices.clear();
+    }
+
+} // namespace Squidl::Renderers
@@ -0,0 +1,211 @@
+// squidl/renderers/QuadBatch.cpp
+#include "Squidl/renderers/QuadBatch.h"
+#include <algorithm> // For std::min, std::clamp, std::remove
+#include <cmath>     // For std::cos, std::sin
+
+namespace Squidl::Renderers {
+
+    namespace {
+        SDL_Color toSDL(Squidl::Utils::Color color) {
+            return {color.r, color.g, color.b, color.a};
+        }
+
+        // Batches alive on the rendering thread, for releaseTexture()
+        std::vector<QuadBatch *> &liveBatches() {
+            static std::vector<QuadBatch *> batches;
+            return batches;
+        }
+    } // namespace
+
+    QuadBatch::QuadBatch(SDL_Renderer *renderer) : m_sdlRenderer(renderer) {
+        liveBatches().push_back(this);
+    }
+
+    QuadBatch::~QuadBatch() {
+        auto &batches = liveBatches();
+        batches.erase(std::remove(batches.begin(), batches.end(), this),
+                      batches.end());
+    }
+
+    void QuadBatch::releaseTexture(SDL_Texture *texture) {
+        if (!texture)
+            return;
+        for (QuadBatch *batch : liveBatches()) {
+            if (batch->m_texture == texture)
+                batch->setTexture(nullptr);
+        }
+    }
+
+    void QuadBatch::destroyTexture(SDL_Texture *texture) {
+        if (!texture)
+            return;
+        releaseTexture(texture);
+        SDL_DestroyTexture(texture);
+    }
+
+    void QuadBatch::setTexture(SDL_Texture *texture) {
+        if (m_texture == texture)
+            return;
+        flush();
+        m_texture = texture;
+    }
+
+    void QuadBatch::setSolidTexture(SDL_Texture *texture, SDL_FPoint uv) {
+        m_solidTexture = texture;
+        m_solidUV = texture ? uv : SDL_FPoint{0.0f, 0.0f};
+    }
+
+    void QuadBatch::addRect(const SDL_Rect &rect, Squidl::Utils::Color color) {
+        if (rect.w <= 0 || rect.h <= 0)
+            return;
+        setTexture(m_solidTexture);
+        addQuad({static_cast<float>(rect.x), static_cast<float>(rect.y),
+                 static_cast<float>(rect.w), static_cast<float>(rect.h)},
+                {m_solidUV.x, m_solidUV.y, 0.0f, 0.0f}, color);
+    }
+
+    void QuadBatch::addQuad(const SDL_FRect &rect, const SDL_FRect &uv,
+                            Squidl::Utils::Color color) {
+        const SDL_Color c = toSDL(color);
+        const float x1 = rect.x + rect.w;
+        const float y1 = rect.y + rect.h;
+        const float u1 = uv.x + uv.w;
+        const float v1 = uv.y + uv.h;
+        const int base = static_cast<int>(m_vertices.size());
+        m_vertices.push_back({{rect.x, rect.y}, c, {uv.x, uv.y}});
+        m_vertices.push_back({{x1, rect.y}, c, {u1, uv.y}});
+        m_vertices.push_back({{x1, y1}, c, {u1, v1}});
+        m_vertices.push_back({{rect.x, y1}, c, {uv.x, v1}});
+        m_indices.insert(m_indices.end(),
+                         {base, base + 1, base + 2, base, base + 2, base + 3});
+        ++m_stats.shapes;
+    }
+
+    void QuadBatch::addOutline(const SDL_Rect &rect,
+                               Squidl::Utils::Color color) {
+        if (rect.w <= 2 || rect.h <= 2) {
+            addRect(rect, color);
+            return;
+        }
+        // The sides do not overlap, so translucent corners are not blended
+        // twice
+        addRect({rect.x, rect.y, rect.w, 1}, color);
+        addRect({rect.x, rect.y + rect.h - 1, rect.w, 1}, color);
+        addRect({rect.x, rect.y + 1, 1, rect.h - 2}, color);
+        addRect({rect.x + rect.w - 1, rect.y + 1, 1, rect.h - 2}, color);
+    }
+
+    int QuadBatch::segmentsFor(float radius) {
+        return std::clamp(static_cast<int>(std::ceil(radius / 2.0f)), 1,
+                          MaxCornerSegments);
+    }
+
+    const std::vector<SDL_FPoint> &QuadBatch::quarterCircle(int segments) {
+        std::vector<SDL_FPoint> &arc = m_arcs[segments];
+        if (arc.empty()) {
+            constexpr float HalfPi = 1.57079632679f;
+            arc.reserve(segments + 1);
+            for (int i = 0; i <= segments; ++i) {
+                const float angle = HalfPi * i / segments;
+                arc.push_back({std::cos(angle), std::sin(angle)});
+            }
+        }
+        return arc;
+    }
+
+    void QuadBatch::roundedContour(float x, float y, float w, float h,
+                                   float radius, int segments) {
+        const std::vector<SDL_FPoint> &arc = quarterCircle(segments);
+        const float left = x + radius;
+        const float top = y + radius;
+        const float right = x + w - radius;
+        const float bottom = y + h - radius;
+        m_contour.clear();
+        for (const SDL_FPoint &p : arc) // Top-left, from the left edge
+            m_contour.push_back({left - p.x * radius, top - p.y * radius});
+        for (const SDL_FPoint &p : arc) // Top-right, from the top edge
+            m_contour.push_back({right + p.y * radius, top - p.x * radius});
+        for (const SDL_FPoint &p : arc) // Bottom-right, from the right edge
+            m_contour.push_back({right + p.x * radius, bottom + p.y * radius});
+        for (const SDL_FPoint &p : arc) // Bottom-left, from the bottom edge
+            m_contour.push_back({left - p.y * radius, bottom + p.x * radius});
+    }
+
+    void QuadBatch::addRoundedRect(const SDL_Rect &rect, int radius,
+                                   Squidl::Utils::Color color) {
+        radius = std::min(radius, std::min(rect.w, rect.h) / 2);
+        if (radius <= 0) {
+            addRect(rect, color);
+            return;
+        }
+        setTexture(m_solidTexture);
+
+        const float r = static_cast<float>(radius);
+        roundedContour(static_cast<float>(rect.x), static_cast<float>(rect.y),
+                       static_cast<float>(rect.w), static_cast<float>(rect.h),
+                       r, segmentsFor(r));
+
+        // Rounded rects are convex: a fan around the center covers them
+        const SDL_Color c = toSDL(color);
+        const int center = static_cast<int>(m_vertices.size());
+        m_vertices.push_back({{rect.x + rect.w * 0.5f, rect.y + rect.h * 0.5f},
+                              c, m_solidUV});
+        const int count = static_cast<int>(m_contour.size());
+        for (const SDL_FPoint &p : m_contour)
+            m_vertices.push_back({p, c, m_solidUV});
+        for (int i = 0; i < count; ++i) {
+            m_indices.insert(m_indices.end(), {center, center + 1 + i,
+                                               center + 1 + (i + 1) % count});
+        }
+        ++m_stats.shapes;
+    }
+
+    void QuadBatch::addRoundedOutline(const SDL_Rect &rect, int radius,
+                                      Squidl::Utils::Color color) {
+        radius = std::min(radius, std::min(rect.w, rect.h) / 2);
+        if (radius <= 0 || rect.w <= 2 || rect.h <= 2) {
+            addOutline(rect, color);
+            return;
+        }
+        setTexture(m_solidTexture);
+
+        // A strip between the outer contour and the one inset by a pixel,
+        // both with the same number of points
+        const float r = static_cast<float>(radius);
+        const int segments = segmentsFor(r);
+        const SDL_Color c = toSDL(color);
+        const int outer = static_cast<int>(m_vertices.size());
+        roundedContour(static_cast<float>(rect.x), static_cast<float>(rect.y),
+                       static_cast<float>(rect.w), static_cast<float>(rect.h),
+                       r, segments);
+        for (const SDL_FPoint &p : m_contour)
+            m_vertices.push_back({p, c, m_solidUV});
+        const int inner = static_cast<int>(m_vertices.size());
+        roundedContour(rect.x + 1.0f, rect.y + 1.0f, rect.w - 2.0f,
+                       rect.h - 2.0f, r - 1.0f, segments);
+        for (const SDL_FPoint &p : m_contour)
+            m_vertices.push_back({p, c, m_solidUV});
+
+        const int count = inner - outer;
+        for (int i = 0; i < count; ++i) {
+            const int next = (i + 1) % count;
+            m_indices.insert(m_indices.end(),
+                             {outer + i, outer + next, inner + next, outer + i,
+                              inner + next, inner + i});
+        }
+        ++m_stats.shapes;
+    }
+
+    void QuadBatch::flush() {
+        if (m_indices.empty())
+            return;
+        SDL_RenderGeometry(m_sdlRenderer, m_texture, m_vertices.data(),
+                           static_cast<int>(m_vertices.size()),
+                           m_indices.data(), static_cast<int>(m_indices.size()));
+        ++m_stats.drawCalls;
+        m_stats.triangles += m_indices.size() / 3;
+        m_vertices.clear();
+        m_indices.clear();
+    }
+
+} // namespace Squidl::Renderers
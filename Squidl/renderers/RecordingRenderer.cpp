@@ -0,0 +1,286 @@
+// squidl/renderers/RecordingRenderer.cpp
+#include "Squidl/renderers/RecordingRenderer.h"
+#include "Squidl/base/UIElement.h" // For UIElement::draw
+#include "Squidl/core/UIContext.h" // For UIContext
+#include "Squidl/utils/Logger.h"   // For logging
+
+namespace Squidl::Renderers {
+
+    RecordingRenderer::RecordingRenderer(Squidl::Core::IRenderer &target)
+        : m_target(target) {}
+
+    void RecordingRenderer::beginFrame() {
+        m_current.clear();
+        m_clipStack.clear();
+        m_layerClipStacks.clear();
+    }
+
+    bool RecordingRenderer::endFrame() {
+        ++m_stats.framesRecorded;
+        m_stats.commands = m_current.commands.size();
+
+        if (!m_forceReplay && sameAsPrevious()) {
+            ++m_stats.framesSkipped;
+            return false;
+        }
+
+        replay(m_current);
+        m_target.flush();
+        m_forceReplay = false;
+        ++m_stats.framesReplayed;
+        // Keep the buffers of both frames to avoid reallocating next frame
+        std::swap(m_current, m_previous);
+        return true;
+    }
+
+    RecordingRenderer::Command &RecordingRenderer::push(Op op) {
+        Command command{};
+        command.op = op;
+        command.opacity = 1.0f;
+        m_current.commands.push_back(command);
+        return m_current.commands.back();
+    }
+
+    bool RecordingRenderer::sameAsPrevious() const {
+        const auto &a = m_current.commands;
+        const auto &b = m_previous.commands;
+        if (a.size() != b.size())
+            return false;
+
+        for (std::size_t i = 0; i < a.size(); ++i) {
+            const Command &x = a[i];
+            const Command &y = b[i];
+            if (x.op != y.op || x.hasSrc != y.hasSrc ||
+                x.hasDest != y.hasDest || x.color != y.color ||
+                x.rect != y.rect || x.src != y.src || x.radius != y.radius ||
+                x.opacity != y.opacity || x.resource != y.resource ||
+                x.textLength != y.textLength) {
+                return false;
+            }
+            if (x.textLength > 0 &&
+                m_current.textPool.compare(x.textOffset, x.textLength,
+                                           m_previous.textPool, y.textOffset,
+                                           y.textLength) != 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void RecordingRenderer::replay(const Frame &frame) {
+        std::string text;
+        // Layers the target failed to bind get no endLayer()
+        std::vector<bool> boundLayers;
+        for (const Command &c : frame.commands) {
+            switch (c.op) {
+            case Op::SetDrawColor:
+                m_target.setDrawColor(c.color);
+                break;
+            case Op::ClearScreen:
+                m_target.clearScreen(c.color);
+                break;
+            case Op::Line:
+                m_target.drawLine(c.rect.x, c.rect.y, c.rect.w, c.rect.h,
+                                  c.color);
+                break;
+            case Op::FilledRect:
+                m_target.drawFilledRect(c.rect, c.color);
+                break;
+            case Op::FilledRoundedRect:
+                m_target.fillRoundedRect(c.rect, c.radius, c.color);
+                break;
+            case Op::RoundedRect:
+                m_target.drawRoundedRect(c.rect, c.radius, c.color);
+                break;
+            case Op::OutlineRect:
+                m_target.drawOutlineRect(c.rect, c.color);
+                break;
+            case Op::Texture: {
+                const SDL_Rect src = c.src;
+                const SDL_Rect dest = c.rect;
+                m_target.drawTexture(
+                    static_cast<SDL_Texture *>(const_cast<void *>(c.resource)),
+                    c.hasSrc ? &src : nullptr, c.hasDest ? &dest : nullptr,
+                    c.opacity);
+                break;
+            }
+            case Op::Text:
+                text.assign(frame.textPool, c.textOffset, c.textLength);
+                m_target.drawText(
+                    static_cast<TTF_Font *>(const_cast<void *>(c.resource)),
+                    text, c.color, c.rect);
+                break;
+            case Op::SetClip:
+                m_target.setClipRect(c.rect);
+                break;
+            case Op::ResetClip:
+                m_target.resetClipRect();
+                break;
+            case Op::PushClip:
+                m_target.pushClipRect(c.rect);
+                break;
+            case Op::PopClip:
+                m_target.popClipRect();
+                break;
+            case Op::BeginLayer:
+                boundLayers.push_back(m_target.beginLayer(
+                    static_cast<SDL_Texture *>(const_cast<void *>(c.resource)),
+                    c.rect));
+                break;
+            case Op::EndLayer:
+                if (!boundLayers.empty() && boundLayers.back())
+                    m_target.endLayer();
+                if (!boundLayers.empty())
+                    boundLayers.pop_back();
+                break;
+            }
+        }
+    }
+
+    void RecordingRenderer::render(
+        std::shared_ptr<Squidl::Base::UIElement> rootElement,
+        Squidl::Core::UIContext &ctx) {
+        if (!rootElement) {
+            SQUIDL_LOG_WARNING << "RecordingRenderer: Attempting to render a "
+                                  "null root UIElement.";
+            return;
+        }
+        rootElement->draw(ctx, *this);
+    }
+
+    void RecordingRenderer::setDrawColor(Squidl::Utils::Color color) {
+        push(Op::SetDrawColor).color = color;
+    }
+
+    void RecordingRenderer::clearScreen(Squidl::Utils::Color color) {
+        push(Op::ClearScreen).color = color;
+    }
+
+    void RecordingRenderer::drawLine(int x1, int y1, int x2, int y2,
+                                     Squidl::Utils::Color color) {
+        Command &c = push(Op::Line);
+        c.rect = {x1, y1, x2, y2};
+        c.color = color;
+    }
+
+    void RecordingRenderer::drawFilledRect(const Squidl::Utils::UIRect &rect,
+                                           Squidl::Utils::Color color) {
+        Command &c = push(Op::FilledRect);
+        c.rect = rect;
+        c.color = color;
+    }
+
+    void RecordingRenderer::fillRoundedRect(const Squidl::Utils::UIRect &rect,
+                                            int radius,
+                                            Squidl::Utils::Color color) {
+        Command &c = push(Op::FilledRoundedRect);
+        c.rect = rect;
+        c.radius = radius;
+        c.color = color;
+    }
+
+    void RecordingRenderer::drawRoundedRect(const Squidl::Utils::UIRect &rect,
+                                            int radius,
+                                            Squidl::Utils::Color color) {
+        Command &c = push(Op::RoundedRect);
+        c.rect = rect;
+        c.radius = radius;
+        c.color = color;
+    }
+
+    void RecordingRenderer::drawOutlineRect(const Squidl::Utils::UIRect &rect,
+                                            Squidl::Utils::Color color) {
+        Command &c = push(Op::OutlineRect);
+        c.rect = rect;
+        c.color = color;
+    }
+
+    void RecordingRenderer::drawTexture(SDL_Texture *texture,
+                                        const SDL_Rect *srcRect,
+                                        const SDL_Rect *destRect,
+                                        float opacity) {
+        if (!texture)
+            return;
+        Command &c = push(Op::Texture);
+        c.resource = texture;
+        c.hasSrc = srcRect != nullptr;
+        c.hasDest = destRect != nullptr;
+        if (srcRect)
+            c.src = *srcRect;
+        if (destRect)
+            c.rect = *destRect;
+        c.opacity = opacity;
+    }
+
+    void RecordingRenderer::drawText(TTF_Font *font, const std::string &text,
+                                     Squidl::Utils::Color color,
+                                     const Squidl::Utils::UIRect &destRect) {
+        if (!font || text.empty())
+            return;
+        Command &c = push(Op::Text);
+        c.resource = font;
+        c.color = color;
+        c.rect = destRect;
+        c.textOffset = m_current.textPool.size();
+        c.textLength = text.size();
+        m_current.textPool += text;
+    }
+
+    void RecordingRenderer::setClipRect(const Squidl::Utils::UIRect &rect) {
+        push(Op::SetClip).rect = rect;
+    }
+
+    void RecordingRenderer::resetClipRect() { push(Op::ResetClip); }
+
+    void RecordingRenderer::pushClipRect(const Squidl::Utils::UIRect &rect) {
+        push(Op::PushClip).rect = rect;
+        m_clipStack.push_back(m_clipStack.empty()
+                                  ? rect
+                                  : rect.intersection(m_clipStack.back()));
+    }
+
+    void RecordingRenderer::popClipRect() {
+        if (m_clipStack.empty()) {
+            SQUIDL_LOG_WARNING
+                << "RecordingRenderer: popClipRect without matching push.";
+            return;
+        }
+        push(Op::PopClip);
+        m_clipStack.pop_back();
+    }
+
+    bool RecordingRenderer::isRectVisible(
+        const Squidl::Utils::UIRect &rect) const {
+        return m_clipStack.empty() ? !rect.isEmpty()
+                                   : rect.intersects(m_clipStack.back());
+    }
+
+    SDL_Texture *RecordingRenderer::createLayerTexture(int w, int h) {
+        // Resources are not recorded, the texture must exist when replaying
+        return m_target.createLayerTexture(w, h);
+    }
+
+    bool RecordingRenderer::beginLayer(SDL_Texture *texture,
+                                       const Squidl::Utils::UIRect &area) {
+        if (!texture)
+            return false;
+        Command &c = push(Op::BeginLayer);
+        c.resource = texture;
+        c.rect = area;
+        m_layerClipStacks.push_back(std::move(m_clipStack));
+        m_clipStack.assign(1, area);
+        return true;
+    }
+
+    void RecordingRenderer::endLayer() {
+        if (m_layerClipStacks.empty()) {
+            SQUIDL_LOG_WARNING
+                << "RecordingRenderer: endLayer without matching beginLayer.";
+            return;
+        }
+        push(Op::EndLayer);
+        m_clipStack = std::move(m_layerClipStacks.back());
+        m_layerClipStacks.pop_back();
+    }
+
+} // namespace Squidl::Renderers
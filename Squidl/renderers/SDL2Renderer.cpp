@@ -1,24 +1,34 @@
 // squidl/renderers/SDL2Renderer.cpp
 #include "Squidl/renderers/SDL2Renderer.h"
-#include "Squidl/base/UIElement.h" // For UIElement::update
+#include "Squidl/base/UIElement.h" // For UIElement::draw
 #include "Squidl/core/UIContext.h" // For UIContext
 #include "Squidl/utils/Logger.h"   // For logging (if needed)
-#include <SDL2_gfxPrimitives.h>
+#include "Squidl/utils/Profiler.h" // For SQUIDL_PROFILE_ZONE
 #include <SDL_image.h> // For SDL_image functions (if loading textures directly in renderer)
 
 namespace Squidl::Renderers {
 
     SDL2Renderer::SDL2Renderer(SDL_Renderer *renderer)
-        : m_sdlRenderer(renderer) {
+        : m_sdlRenderer(renderer), m_textCache(renderer),
+          m_glyphAtlas(renderer), m_quads(renderer),
+          m_shapes(renderer, m_quads) {
         if (!m_sdlRenderer) {
             SQUIDL_LOG_ERROR
                 << "SDL2Renderer: Initialized with a null SDL_Renderer.";
         }
     }
 
+    SDL2Renderer::~SDL2Renderer() {
+        const auto &stats = m_textCache.getStats();
+        SQUIDL_LOG_DEBUG << "SDL2Renderer: Text cache hits: " << stats.hits
+                         << ", misses: " << stats.misses
+                         << ", evictions: " << stats.evictions;
+    }
+
     void
     SDL2Renderer::render(std::shared_ptr<Squidl::Base::UIElement> rootElement,
                          Squidl::Core::UIContext &ctx) {
+        SQUIDL_PROFILE_ZONE_OBJ("SDL2Renderer::render", this);
         if (!m_sdlRenderer) {
             SQUIDL_LOG_ERROR
                 << "SDL2Renderer: Cannot render: SDL_Renderer is null.";
@@ -30,12 +40,15 @@ namespace Squidl::Renderers {
             return;
         }
 
-        // Call update on the root element, passing the IRenderer reference
-        // This is the key change for polymorphism
-        rootElement->update(ctx, *this); // Pass 'this' as IRenderer&
+        // Draw the root element (or its cached layer), passing the IRenderer
+        // reference
+        rootElement->draw(ctx, *this); // Pass 'this' as IRenderer&
+        // Callers may present right after render(), so nothing stays queued
+        m_quads.flush();
     }
 
     void SDL2Renderer::setDrawColor(Squidl::Utils::Color color) {
+        SQUIDL_PROFILE_ZONE_OBJ("SDL2Renderer::setDrawColor", this);
         if (m_sdlRenderer) {
             SDL_SetRenderDrawColor(m_sdlRenderer, color.r, color.g, color.b,
                                    color.a);
@@ -43,7 +56,9 @@ namespace Squidl::Renderers {
     }
 
     void SDL2Renderer::clearScreen(Squidl::Utils::Color color) {
+        SQUIDL_PROFILE_ZONE_OBJ("SDL2Renderer::clearScreen", this);
         if (m_sdlRenderer) {
+            m_quads.flush();
             SDL_SetRenderDrawColor(m_sdlRenderer, color.r, color.g, color.b,
                                    color.a);
             SDL_RenderClear(m_sdlRenderer);
@@ -52,114 +67,285 @@ namespace Squidl::Renderers {
 
     void SDL2Renderer::drawLine(int x1, int y1, int x2, int y2,
                                 Squidl::Utils::Color color) {
+        SQUIDL_PROFILE_ZONE_OBJ("SDL2Renderer::drawLine", this);
+        m_quads.flush();
         SDL_SetRenderDrawColor(m_sdlRenderer, color.r, color.g, color.b,
                                color.a);
         
-        SDL_RenderDrawLine(m_sdlRenderer, x1, y1, x2, y2);
+        SDL_RenderDrawLine(m_sdlRenderer, x1 - m_origin.x, y1 - m_origin.y,
+                           x2 - m_origin.x, y2 - m_origin.y);
         // SDL_RenderDrawLineF();
     }
 
     void SDL2Renderer::drawFilledRect(const Squidl::Utils::UIRect &rect,
                                       Squidl::Utils::Color color) {
-        if (m_sdlRenderer) {
-            SDL_SetRenderDrawColor(m_sdlRenderer, color.r, color.g, color.b,
-                                   color.a);
-            SDL_Rect sdlRect = rect;
-            SDL_RenderFillRect(m_sdlRenderer, &sdlRect);
-        }
+        SQUIDL_PROFILE_ZONE_OBJ("SDL2Renderer::drawFilledRect", this);
+        if (m_sdlRenderer)
+            m_quads.addRect(toTarget(rect), color);
     }
 
     void SDL2Renderer::fillRoundedRect(const Squidl::Utils::UIRect &rect,
                                        int radius, Squidl::Utils::Color color) {
-        if (m_sdlRenderer) {
-            roundedBoxRGBA(m_sdlRenderer, rect.x, rect.y, rect.x + rect.w - 1,
-                           rect.y + rect.h - 1, radius, color.r, color.g,
-                           color.b, color.a);
-        }
+        SQUIDL_PROFILE_ZONE_OBJ("SDL2Renderer::fillRoundedRect", this);
+        if (!m_sdlRenderer)
+            return;
+        const SDL_Rect r = toTarget(rect);
+        if (!m_shapes.draw(r, radius, 0, color))
+            m_quads.addRoundedRect(r, radius, color);
     }
 
     void SDL2Renderer::drawRoundedRect(const Squidl::Utils::UIRect &rect,
                                        int radius, Squidl::Utils::Color color) {
-        SDL_SetRenderDrawColor(m_sdlRenderer, color.r, color.g, color.b,
-                               color.a);
-        if (m_sdlRenderer) {
-            roundedRectangleRGBA(m_sdlRenderer, rect.x, rect.y,
-                                 rect.x + rect.w - 1, rect.y + rect.h - 1,
-                                 radius, color.r, color.g, color.b, color.a);
-        }
+        SQUIDL_PROFILE_ZONE_OBJ("SDL2Renderer::drawRoundedRect", this);
+        if (!m_sdlRenderer)
+            return;
+        const SDL_Rect r = toTarget(rect);
+        if (!m_shapes.draw(r, radius, 1, color))
+            m_quads.addRoundedOutline(r, radius, color);
     }
 
     void SDL2Renderer::drawOutlineRect(const Squidl::Utils::UIRect &rect,
                                        Squidl::Utils::Color color) {
-        if (m_sdlRenderer) {
-            SDL_SetRenderDrawColor(m_sdlRenderer, color.r, color.g, color.b,
-                                   color.a);
-            SDL_Rect sdlRect = rect;
-            SDL_RenderDrawRect(m_sdlRenderer, &sdlRect);
-        }
+        SQUIDL_PROFILE_ZONE_OBJ("SDL2Renderer::drawOutlineRect", this);
+        if (m_sdlRenderer)
+            m_quads.addOutline(toTarget(rect), color);
     }
 
     void SDL2Renderer::drawTexture(SDL_Texture *texture,
                                    const SDL_Rect *srcRect,
                                    const SDL_Rect *destRect, float opacity) {
-        if (m_sdlRenderer && texture) {
+        SQUIDL_PROFILE_ZONE_OBJ("SDL2Renderer::drawTexture", this);
+        if (!m_sdlRenderer || !texture)
+            return;
+
+        // Without a destination the texture covers the whole target
+        if (!destRect) {
+            m_quads.flush();
             Uint8 current_alpha;
             SDL_GetTextureAlphaMod(texture,
                                    &current_alpha); // Save current alpha
-            SDL_SetTextureAlphaMod(texture, static_cast<Uint8>(opacity * 255));
-
-            SDL_RenderCopy(m_sdlRenderer, texture, srcRect, destRect);
-
+            SDL_SetTextureAlphaMod(texture,
+                                   static_cast<Uint8>(current_alpha * opacity));
+            SDL_RenderCopy(m_sdlRenderer, texture, srcRect, nullptr);
             SDL_SetTextureAlphaMod(texture,
                                    current_alpha); // Restore original alpha
+            return;
         }
+
+        // Drawn as a textured quad, so consecutive regions of one texture
+        // (TextureAtlas pages) share a draw call. SDL_RenderGeometry ignores
+        // the texture's color and alpha mods, so they go into the vertex
+        // color, the alpha scaled by opacity as in the branch above.
+        int w = 0, h = 0;
+        if (SDL_QueryTexture(texture, nullptr, nullptr, &w, &h) != 0 ||
+            w <= 0 || h <= 0)
+            return;
+        const SDL_Rect src = srcRect ? *srcRect : SDL_Rect{0, 0, w, h};
+        const SDL_Rect dst = toTarget(*destRect);
+        if (src.w <= 0 || src.h <= 0 || dst.w <= 0 || dst.h <= 0)
+            return;
+        Uint8 r = 255, g = 255, b = 255, a = 255;
+        SDL_GetTextureColorMod(texture, &r, &g, &b);
+        SDL_GetTextureAlphaMod(texture, &a);
+        m_quads.setTexture(texture);
+        m_quads.addQuad(
+            {static_cast<float>(dst.x), static_cast<float>(dst.y),
+             static_cast<float>(dst.w), static_cast<float>(dst.h)},
+            {static_cast<float>(src.x) / w, static_cast<float>(src.y) / h,
+             static_cast<float>(src.w) / w, static_cast<float>(src.h) / h},
+            Squidl::Utils::Color(r, g, b, static_cast<Uint8>(a * opacity)));
     }
 
     void SDL2Renderer::drawText(TTF_Font *font, const std::string &text,
                                 Squidl::Utils::Color color,
                                 const Squidl::Utils::UIRect &destRect) {
+        SQUIDL_PROFILE_ZONE_OBJ("SDL2Renderer::drawText", this);
         if (!m_sdlRenderer || !font || text.empty())
             return;
+        m_quads.flush();
 
-        // Create surface from text
-        SDL_Surface *textSurface = TTF_RenderUTF8_Blended(
-            font, text.c_str(), static_cast<SDL_Color>(color));
-        if (!textSurface) {
-            SQUIDL_LOG_ERROR << "SDL2Renderer: Failed to create text surface: "
-                             << TTF_GetError();
+        if (m_textMode == TextRenderMode::GlyphAtlas) {
+            m_glyphAtlas.drawText(font, text, color, destRect.x - m_origin.x,
+                                  destRect.y - m_origin.y);
             return;
         }
 
-        // Create texture from surface
-        SDL_Texture *textTexture =
-            SDL_CreateTextureFromSurface(m_sdlRenderer, textSurface);
-        if (!textTexture) {
-            SQUIDL_LOG_ERROR << "SDL2Renderer: Failed to create text texture: "
-                             << SDL_GetError();
-            SDL_FreeSurface(textSurface);
+        // Rasterization happens only on a cache miss; static text reuses the
+        // texture produced in an earlier frame.
+        SDL_Texture *textTexture = m_textCache.acquire(font, text, color);
+        if (!textTexture)
             return;
-        }
 
-        // Render the texture
-        SDL_Rect sdlDestRect = destRect;
+        SDL_Rect sdlDestRect = toTarget(destRect);
         SDL_RenderCopy(m_sdlRenderer, textTexture, nullptr, &sdlDestRect);
+    }
+
+    void SDL2Renderer::purgeFont(TTF_Font *font) {
+        m_textCache.removeFont(font);
+        m_glyphAtlas.removeFont(font);
+    }
 
-        // Clean up
-        SDL_DestroyTexture(textTexture);
-        SDL_FreeSurface(textSurface);
+    bool SDL2Renderer::currentClip(Squidl::Utils::UIRect &out) const {
+        if (!m_clipStack.empty()) {
+            out = m_hasBaseClip ? m_clipStack.back().intersection(m_baseClip)
+                                : m_clipStack.back();
+            return true;
+        }
+        if (m_hasBaseClip) {
+            out = m_baseClip;
+            return true;
+        }
+        return false;
     }
 
     void SDL2Renderer::setClipRect(const Squidl::Utils::UIRect &rect) {
+        SQUIDL_PROFILE_ZONE_OBJ("SDL2Renderer::setClipRect", this);
         if (m_sdlRenderer) {
-            SDL_Rect sdlClipRect = rect;
-            SDL_RenderSetClipRect(m_sdlRenderer, &sdlClipRect);
+            Squidl::Utils::UIRect clip;
+            applyClipRect(currentClip(clip) ? rect.intersection(clip) : rect);
         }
     }
 
     void SDL2Renderer::resetClipRect() {
-        if (m_sdlRenderer) {
+        SQUIDL_PROFILE_ZONE_OBJ("SDL2Renderer::resetClipRect", this);
+        if (!m_sdlRenderer)
+            return;
+        Squidl::Utils::UIRect clip;
+        if (currentClip(clip)) {
+            applyClipRect(clip);
+        } else {
+            m_quads.flush();
             SDL_RenderSetClipRect(m_sdlRenderer, nullptr);
         }
     }
 
+    void SDL2Renderer::pushClipRect(const Squidl::Utils::UIRect &rect) {
+        SQUIDL_PROFILE_ZONE_OBJ("SDL2Renderer::pushClipRect", this);
+        m_clipStack.push_back(m_clipStack.empty()
+                                  ? rect
+                                  : rect.intersection(m_clipStack.back()));
+        resetClipRect();
+    }
+
+    void SDL2Renderer::popClipRect() {
+        SQUIDL_PROFILE_ZONE_OBJ("SDL2Renderer::popClipRect", this);
+        if (m_clipStack.empty()) {
+            SQUIDL_LOG_WARNING
+                << "SDL2Renderer: popClipRect without matching push.";
+            return;
+        }
+        m_clipStack.pop_back();
+        resetClipRect();
+    }
+
+    bool
+    SDL2Renderer::isRectVisible(const Squidl::Utils::UIRect &rect) const {
+        Squidl::Utils::UIRect clip;
+        return currentClip(clip) ? rect.intersects(clip) : !rect.isEmpty();
+    }
+
+    SDL_Texture *SDL2Renderer::createLayerTexture(int w, int h) {
+        if (!m_sdlRenderer || w <= 0 || h <= 0)
+            return nullptr;
+        SDL_Texture *texture =
+            SDL_CreateTexture(m_sdlRenderer, SDL_PIXELFORMAT_ARGB8888,
+                              SDL_TEXTUREACCESS_TARGET, w, h);
+        if (!texture) {
+            SQUIDL_LOG_ERROR << "SDL2Renderer: Failed to create a " << w << "x"
+                             << h << " layer: " << SDL_GetError();
+            return nullptr;
+        }
+
+        // Blending into a transparent layer leaves colors multiplied by
+        // their alpha, so the layer must be composited as premultiplied
+        // (src + dst * (1 - srcA)) to look the same as drawing directly
+        if (m_layerBlendMode == SDL_BLENDMODE_INVALID) {
+            m_layerBlendMode = SDL_ComposeCustomBlendMode(
+                SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA,
+                SDL_BLENDOPERATION_ADD, SDL_BLENDFACTOR_ONE,
+                SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD);
+        }
+        if (SDL_SetTextureBlendMode(texture, m_layerBlendMode) != 0) {
+            SQUIDL_LOG_WARNING << "SDL2Renderer: Premultiplied blending is "
+                                  "not supported, translucent layer edges "
+                                  "will look darker.";
+            m_layerBlendMode = SDL_BLENDMODE_BLEND;
+            SDL_SetTextureBlendMode(texture, m_layerBlendMode);
+        }
+        return texture;
+    }
+
+    bool SDL2Renderer::beginLayer(SDL_Texture *texture,
+                                  const Squidl::Utils::UIRect &area) {
+        SQUIDL_PROFILE_ZONE_OBJ("SDL2Renderer::beginLayer", this);
+        if (!m_sdlRenderer || !texture)
+            return false;
+        m_quads.flush();
+        SDL_Texture *previous = SDL_GetRenderTarget(m_sdlRenderer);
+        if (SDL_SetRenderTarget(m_sdlRenderer, texture) != 0) {
+            SQUIDL_LOG_ERROR << "SDL2Renderer: Failed to bind a layer: "
+                             << SDL_GetError();
+            return false;
+        }
+
+        m_layerStack.push_back({previous, m_origin, m_hasBaseClip, m_baseClip,
+                                std::move(m_clipStack)});
+        m_clipStack.clear();
+        m_origin = {area.x, area.y};
+        // The whole layer is kept, so the damage clip of the window does
+        // not apply inside it
+        m_hasBaseClip = true;
+        m_baseClip = area;
+
+        SDL_RenderSetClipRect(m_sdlRenderer, nullptr);
+        SDL_SetRenderDrawColor(m_sdlRenderer, 0, 0, 0, 0);
+        SDL_RenderClear(m_sdlRenderer);
+        resetClipRect();
+        return true;
+    }
+
+    void SDL2Renderer::endLayer() {
+        SQUIDL_PROFILE_ZONE_OBJ("SDL2Renderer::endLayer", this);
+        if (m_layerStack.empty()) {
+            SQUIDL_LOG_WARNING
+                << "SDL2Renderer: endLayer without matching beginLayer.";
+            return;
+        }
+        m_quads.flush();
+        LayerState &state = m_layerStack.back();
+        SDL_SetRenderTarget(m_sdlRenderer, state.target);
+        m_origin = state.origin;
+        m_hasBaseClip = state.hasBaseClip;
+        m_baseClip = state.baseClip;
+        m_clipStack = std::move(state.clipStack);
+        m_layerStack.pop_back();
+        resetClipRect();
+    }
+
+    void SDL2Renderer::setBaseClipRect(const Squidl::Utils::UIRect &rect) {
+        m_hasBaseClip = true;
+        m_baseClip = rect;
+        resetClipRect();
+    }
+
+    void SDL2Renderer::resetBaseClipRect() {
+        m_hasBaseClip = false;
+        resetClipRect();
+    }
+
+    void SDL2Renderer::flush() {
+        SQUIDL_PROFILE_ZONE_OBJ("SDL2Renderer::flush", this);
+        m_quads.flush();
+    }
+
+    void SDL2Renderer::applyClipRect(const Squidl::Utils::UIRect &rect) {
+        // Batched shapes were clipped by the previous rect
+        m_quads.flush();
+        // SDL disables clipping for an empty rect, so an empty area is
+        // expressed as a rect outside of the render target
+        SDL_Rect sdlClipRect = rect.isEmpty() ? SDL_Rect{-1, -1, 1, 1}
+                                              : toTarget(rect);
+        SDL_RenderSetClipRect(m_sdlRenderer, &sdlClipRect);
+    }
+
 } // namespace Squidl::Renderers
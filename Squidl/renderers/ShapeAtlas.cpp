@@ -0,0 +1,193 @@
+// squidl/renderers/ShapeAtlas.cpp
+#include "Squidl/renderers/ShapeAtlas.h"
+#include "Squidl/utils/Logger.h" // For logging
+#include <algorithm>             // For std::min, std::max, std::clamp
+#include <cmath>                 // For std::sqrt
+
+namespace Squidl::Renderers {
+
+    namespace {
+        // Gap kept between cells so filtering never samples a neighbour
+        constexpr int CellPadding = 1;
+        // Opaque block reserved at the top-left corner for solid shapes
+        constexpr int WhiteBlock = 3;
+
+        // Fraction of the pixel centered at (px, py) covered by a
+        // (2r+1)-sized rounded rect of radius r, or by its outline of the
+        // given thickness. The distance is measured from the inner box the
+        // corner circles are centered on.
+        float coverage(float px, float py, float size, float radius,
+                       int thickness) {
+            const float qx =
+                std::max({radius - px, px - (size - radius), 0.0f});
+            const float qy =
+                std::max({radius - py, py - (size - radius), 0.0f});
+            const float inside = radius - std::sqrt(qx * qx + qy * qy);
+            const float outer = std::clamp(inside + 0.5f, 0.0f, 1.0f);
+            if (thickness <= 0)
+                return outer;
+            const float inner =
+                std::clamp(inside - thickness + 0.5f, 0.0f, 1.0f);
+            return std::max(0.0f, outer - inner);
+        }
+    } // namespace
+
+    ShapeAtlas::ShapeAtlas(SDL_Renderer *renderer, QuadBatch &batch,
+                           int pageSize)
+        : m_sdlRenderer(renderer), m_batch(batch),
+          m_pageSize(std::max(pageSize, 2 * MaxRadius + 1 + WhiteBlock)) {}
+
+    ShapeAtlas::~ShapeAtlas() {
+        if (m_texture)
+            SDL_DestroyTexture(m_texture);
+    }
+
+    void ShapeAtlas::clear() {
+        // Pending quads may still reference the texture
+        m_batch.setTexture(nullptr);
+        m_batch.setSolidTexture(nullptr, {});
+        if (m_texture) {
+            SDL_DestroyTexture(m_texture);
+            m_texture = nullptr;
+        }
+        m_cells.clear();
+        m_full = false;
+        m_stats.shapes = 0;
+    }
+
+    void ShapeAtlas::resetCounters() {
+        m_stats.rasterized = 0;
+        m_stats.drawn = 0;
+        m_stats.rejected = 0;
+    }
+
+    bool ShapeAtlas::draw(const SDL_Rect &rect, int radius, int thickness,
+                          Squidl::Utils::Color color) {
+        radius = std::min(radius, std::min(rect.w, rect.h) / 2);
+        if (radius <= 0 || thickness < 0)
+            return false;
+        if (radius > MaxRadius || thickness > radius) {
+            ++m_stats.rejected;
+            return false;
+        }
+        if (!m_texture && !createPage())
+            return false;
+        const SDL_Rect *cell = findOrRasterize(radius, thickness);
+        if (!cell) {
+            ++m_stats.rejected;
+            return false;
+        }
+
+        m_batch.setTexture(m_texture);
+        const float scale = 1.0f / m_pageSize;
+        const int x[4] = {rect.x, rect.x + radius, rect.x + rect.w - radius,
+                          rect.x + rect.w};
+        const int y[4] = {rect.y, rect.y + radius, rect.y + rect.h - radius,
+                          rect.y + rect.h};
+        // The middle slices sample the center of the middle texel only, so
+        // stretching them does not blend in the corners
+        const float u[3] = {static_cast<float>(cell->x),
+                            cell->x + radius + 0.5f,
+                            static_cast<float>(cell->x + radius + 1)};
+        const float v[3] = {static_cast<float>(cell->y),
+                            cell->y + radius + 0.5f,
+                            static_cast<float>(cell->y + radius + 1)};
+        for (int row = 0; row < 3; ++row) {
+            if (y[row + 1] <= y[row])
+                continue;
+            const float vh = row == 1 ? 0.0f : static_cast<float>(radius);
+            for (int col = 0; col < 3; ++col) {
+                if (x[col + 1] <= x[col])
+                    continue;
+                const float uw = col == 1 ? 0.0f : static_cast<float>(radius);
+                m_batch.addQuad({static_cast<float>(x[col]),
+                                 static_cast<float>(y[row]),
+                                 static_cast<float>(x[col + 1] - x[col]),
+                                 static_cast<float>(y[row + 1] - y[row])},
+                                {u[col] * scale, v[row] * scale, uw * scale,
+                                 vh * scale},
+                                color);
+            }
+        }
+        ++m_stats.drawn;
+        return true;
+    }
+
+    bool ShapeAtlas::createPage() {
+        if (!m_sdlRenderer)
+            return false;
+        m_texture =
+            SDL_CreateTexture(m_sdlRenderer, SDL_PIXELFORMAT_ARGB8888,
+                              SDL_TEXTUREACCESS_STATIC, m_pageSize, m_pageSize);
+        if (!m_texture) {
+            SQUIDL_LOG_ERROR << "ShapeAtlas: Failed to create atlas page: "
+                             << SDL_GetError();
+            return false;
+        }
+        SDL_SetTextureBlendMode(m_texture, SDL_BLENDMODE_BLEND);
+
+        // Start from fully transparent pixels, the texture content is
+        // undefined otherwise
+        std::vector<Uint32> blank(static_cast<std::size_t>(m_pageSize) *
+                                  m_pageSize);
+        SDL_UpdateTexture(m_texture, nullptr, blank.data(),
+                          m_pageSize * static_cast<int>(sizeof(Uint32)));
+
+        m_packer.reset(m_pageSize, m_pageSize);
+        Squidl::Utils::UIRect slot;
+        m_packer.insert(WhiteBlock + CellPadding, WhiteBlock + CellPadding,
+                        slot);
+        const std::vector<Uint32> white(WhiteBlock * WhiteBlock, 0xFFFFFFFFu);
+        const SDL_Rect dst{slot.x, slot.y, WhiteBlock, WhiteBlock};
+        SDL_UpdateTexture(m_texture, &dst, white.data(),
+                          WhiteBlock * static_cast<int>(sizeof(Uint32)));
+        const float center = (slot.x + WhiteBlock * 0.5f) / m_pageSize;
+        m_batch.setSolidTexture(
+            m_texture, {center, (slot.y + WhiteBlock * 0.5f) / m_pageSize});
+        return true;
+    }
+
+    const SDL_Rect *ShapeAtlas::findOrRasterize(int radius, int thickness) {
+        const Uint32 key = static_cast<Uint32>(radius) << 16 |
+                           static_cast<Uint32>(thickness);
+        auto it = m_cells.find(key);
+        if (it != m_cells.end())
+            return &it->second;
+        if (m_full)
+            return nullptr;
+
+        const int size = 2 * radius + 1;
+        Squidl::Utils::UIRect slot;
+        if (!m_packer.insert(size + CellPadding, size + CellPadding, slot)) {
+            SQUIDL_LOG_WARNING << "ShapeAtlas: Atlas is full, shapes that are "
+                                  "not cached yet fall back to geometry.";
+            m_full = true;
+            return nullptr;
+        }
+
+        m_pixels.resize(static_cast<std::size_t>(size) * size);
+        const float r = static_cast<float>(radius);
+        for (int py = 0; py < size; ++py) {
+            for (int px = 0; px < size; ++px) {
+                const float a = coverage(px + 0.5f, py + 0.5f,
+                                         static_cast<float>(size), r,
+                                         thickness);
+                const Uint32 alpha = static_cast<Uint32>(a * 255.0f + 0.5f);
+                m_pixels[static_cast<std::size_t>(py) * size + px] =
+                    alpha << 24 | 0x00FFFFFFu;
+            }
+        }
+
+        const SDL_Rect dst{slot.x, slot.y, size, size};
+        if (SDL_UpdateTexture(m_texture, &dst, m_pixels.data(),
+                              size * static_cast<int>(sizeof(Uint32))) != 0) {
+            SQUIDL_LOG_ERROR << "ShapeAtlas: Failed to upload shape: "
+                             << SDL_GetError();
+            return nullptr;
+        }
+        ++m_stats.rasterized;
+        m_stats.shapes = m_cells.size() + 1;
+        return &(m_cells[key] = dst);
+    }
+
+} // namespace Squidl::Renderers
@@ -0,0 +1,155 @@
+// squidl/renderers/TextTextureCache.cpp
+#include "Squidl/renderers/TextTextureCache.h"
+#include "Squidl/utils/Logger.h" // For logging
+#include <functional>            // For std::hash
+
+namespace Squidl::Renderers {
+
+    namespace {
+        Uint32 packColor(Squidl::Utils::Color color) {
+            return (static_cast<Uint32>(color.r) << 24) |
+                   (static_cast<Uint32>(color.g) << 16) |
+                   (static_cast<Uint32>(color.b) << 8) |
+                   static_cast<Uint32>(color.a);
+        }
+
+        void hashCombine(std::size_t &seed, std::size_t value) {
+            seed ^= value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+        }
+    } // namespace
+
+    std::size_t TextTextureCache::KeyHash::operator()(const KeyView &key) const {
+        std::size_t seed = std::hash<std::string_view>{}(key.text);
+        hashCombine(seed, std::hash<const void *>{}(key.font));
+        hashCombine(seed, std::hash<int>{}(key.style));
+        hashCombine(seed, std::hash<Uint32>{}(key.color));
+        return seed;
+    }
+
+    TextTextureCache::TextTextureCache(SDL_Renderer *renderer,
+                                       std::size_t memoryBudget,
+                                       std::size_t maxEntries)
+        : m_sdlRenderer(renderer), m_memoryBudget(memoryBudget),
+          m_maxEntries(maxEntries) {}
+
+    TextTextureCache::~TextTextureCache() { clear(); }
+
+    SDL_Texture *TextTextureCache::acquire(TTF_Font *font,
+                                           const std::string &text,
+                                           Squidl::Utils::Color color,
+                                           int *outW, int *outH) {
+        if (!m_sdlRenderer || !font || text.empty())
+            return nullptr;
+
+        const KeyView lookup{font, TTF_GetFontStyle(font), packColor(color),
+                             text};
+        auto found = m_index.find(lookup);
+        if (found != m_index.end()) {
+            ++m_stats.hits;
+            // Move the entry to the front of the LRU list
+            m_entries.splice(m_entries.begin(), m_entries, found->second);
+            const Entry &entry = *found->second;
+            if (outW)
+                *outW = entry.w;
+            if (outH)
+                *outH = entry.h;
+            return entry.texture;
+        }
+
+        ++m_stats.misses;
+
+        SDL_Surface *textSurface = TTF_RenderUTF8_Blended(
+            font, text.c_str(), static_cast<SDL_Color>(color));
+        if (!textSurface) {
+            SQUIDL_LOG_ERROR
+                << "TextTextureCache: Failed to create text surface: "
+                << TTF_GetError();
+            return nullptr;
+        }
+
+        SDL_Texture *textTexture =
+            SDL_CreateTextureFromSurface(m_sdlRenderer, textSurface);
+        const int w = textSurface->w;
+        const int h = textSurface->h;
+        SDL_FreeSurface(textSurface);
+        if (!textTexture) {
+            SQUIDL_LOG_ERROR
+                << "TextTextureCache: Failed to create text texture: "
+                << SDL_GetError();
+            return nullptr;
+        }
+
+        m_entries.push_front(Entry{font, lookup.style, lookup.color, text,
+                                   textTexture, w, h,
+                                   static_cast<std::size_t>(w) * h * 4});
+        auto it = m_entries.begin();
+        // The key views the string owned by the list node, which never moves
+        m_index.emplace(KeyView{it->font, it->style, it->color, it->text}, it);
+        m_stats.entries = m_entries.size();
+        m_stats.bytes += it->bytes;
+
+        if (outW)
+            *outW = w;
+        if (outH)
+            *outH = h;
+
+        // Never evict the entry we are about to hand out
+        trim();
+        return textTexture;
+    }
+
+    void TextTextureCache::removeFont(TTF_Font *font) {
+        for (auto it = m_entries.begin(); it != m_entries.end();) {
+            auto next = std::next(it);
+            if (it->font == font)
+                destroyEntry(it);
+            it = next;
+        }
+    }
+
+    void TextTextureCache::clear() {
+        while (!m_entries.empty())
+            destroyEntry(m_entries.begin());
+    }
+
+    void TextTextureCache::setMemoryBudget(std::size_t bytes) {
+        m_memoryBudget = bytes;
+        trim();
+    }
+
+    void TextTextureCache::setMaxEntries(std::size_t count) {
+        m_maxEntries = count;
+        trim();
+    }
+
+    void TextTextureCache::resetCounters() {
+        m_stats.hits = 0;
+        m_stats.misses = 0;
+        m_stats.evictions = 0;
+    }
+
+    void TextTextureCache::trim() {
+        // Keep at least the most recently used entry alive
+        while (m_entries.size() > 1 && (m_stats.bytes > m_memoryBudget ||
+                                        m_entries.size() > m_maxEntries)) {
+            evictLeastRecent();
+        }
+    }
+
+    void TextTextureCache::evictLeastRecent() {
+        if (m_entries.empty())
+            return;
+        destroyEntry(std::prev(m_entries.end()));
+        ++m_stats.evictions;
+    }
+
+    void TextTextureCache::destroyEntry(EntryList::iterator it) {
+        m_index.erase(KeyView{it->font, it->style, it->color, it->text});
+        if (it->texture)
+            SDL_DestroyTexture(it->texture);
+        m_stats.bytes -= it->bytes;
+        m_entries.erase(it);
+        m_stats.entries = m_entries.size();
+    }
+
+} // namespace Squidl::Renderers
@@ -0,0 +1,189 @@
+// squidl/renderers/TextureAtlas.cpp
+#include "Squidl/renderers/TextureAtlas.h"
+#include "Squidl/renderers/QuadBatch.h" // For QuadBatch::destroyTexture
+#include "Squidl/utils/Logger.h" // For logging
+#include <SDL_image.h>           // For IMG_Load, IMG_Load_RW
+#include <algorithm>             // For std::clamp
+
+namespace Squidl::Renderers {
+
+    namespace {
+        // Edge pixels repeated around every image
+        constexpr int Border = 1;
+    } // namespace
+
+    TextureAtlas::TextureAtlas(SDL_Renderer *renderer, int pageSize)
+        : m_sdlRenderer(renderer), m_pageSize(pageSize) {}
+
+    TextureAtlas::~TextureAtlas() { clear(); }
+
+    void TextureAtlas::clear() {
+        for (Page &page : m_pages) {
+            if (page.texture)
+                QuadBatch::destroyTexture(page.texture);
+        }
+        m_pages.clear();
+        m_regions.clear();
+    }
+
+    AtlasRegion TextureAtlas::add(const std::string &name,
+                                  SDL_Surface *surface) {
+        auto it = m_regions.find(name);
+        if (it != m_regions.end())
+            return it->second;
+        if (!surface || !m_sdlRenderer)
+            return {};
+
+        const int w = surface->w;
+        const int h = surface->h;
+        const int paddedW = w + 2 * Border;
+        const int paddedH = h + 2 * Border;
+        if (w <= 0 || h <= 0 || paddedW > m_pageSize || paddedH > m_pageSize) {
+            SQUIDL_LOG_WARNING << "TextureAtlas: Image '" << name << "' of "
+                               << w << "x" << h
+                               << " does not fit into an atlas page.";
+            ++m_rejected;
+            return {};
+        }
+
+        // Converted before a slot is taken: the packer cannot give it back
+        SDL_Surface *converted = surface;
+        if (surface->format->format != SDL_PIXELFORMAT_ARGB8888) {
+            converted =
+                SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_ARGB8888, 0);
+            if (!converted) {
+                SQUIDL_LOG_ERROR << "TextureAtlas: Failed to convert image '"
+                                 << name << "': " << SDL_GetError();
+                ++m_rejected;
+                return {};
+            }
+        }
+
+        // Copy the image with its edges repeated into the border
+        if (SDL_MUSTLOCK(converted))
+            SDL_LockSurface(converted);
+        m_pixels.resize(static_cast<std::size_t>(paddedW) * paddedH);
+        const auto *src = static_cast<const Uint8 *>(converted->pixels);
+        for (int py = 0; py < paddedH; ++py) {
+            const int sy = std::clamp(py - Border, 0, h - 1);
+            const auto *row = reinterpret_cast<const Uint32 *>(
+                src + static_cast<std::size_t>(sy) * converted->pitch);
+            Uint32 *dst = &m_pixels[static_cast<std::size_t>(py) * paddedW];
+            for (int px = 0; px < paddedW; ++px)
+                dst[px] = row[std::clamp(px - Border, 0, w - 1)];
+        }
+        if (SDL_MUSTLOCK(converted))
+            SDL_UnlockSurface(converted);
+        if (converted != surface)
+            SDL_FreeSurface(converted);
+
+        // Earlier pages may still have room for small images
+        Squidl::Utils::UIRect slot;
+        int page = -1;
+        for (std::size_t i = 0; i < m_pages.size(); ++i) {
+            if (m_pages[i].packer.insert(paddedW, paddedH, slot)) {
+                page = static_cast<int>(i);
+                break;
+            }
+        }
+        if (page < 0) {
+            if (!addPage()) {
+                ++m_rejected;
+                return {};
+            }
+            page = static_cast<int>(m_pages.size()) - 1;
+            m_pages[page].packer.insert(paddedW, paddedH, slot);
+        }
+
+        const SDL_Rect dst{slot.x, slot.y, paddedW, paddedH};
+        if (SDL_UpdateTexture(m_pages[page].texture, &dst, m_pixels.data(),
+                              paddedW * static_cast<int>(sizeof(Uint32))) !=
+            0) {
+            // The slot stays taken, but is only wasted space
+            SQUIDL_LOG_ERROR << "TextureAtlas: Failed to upload image '"
+                             << name << "': " << SDL_GetError();
+            ++m_rejected;
+            return {};
+        }
+
+        AtlasRegion region;
+        region.texture = m_pages[page].texture;
+        region.rect = {slot.x + Border, slot.y + Border, w, h};
+        m_regions.emplace(name, region);
+        return region;
+    }
+
+    AtlasRegion TextureAtlas::addFromFile(const std::string &path) {
+        auto it = m_regions.find(path);
+        if (it != m_regions.end())
+            return it->second;
+        SDL_Surface *surface = IMG_Load(path.c_str());
+        if (!surface) {
+            SQUIDL_LOG_ERROR << "TextureAtlas: Failed to load image from file '"
+                             << path << "': " << IMG_GetError();
+            return {};
+        }
+        AtlasRegion region = add(path, surface);
+        SDL_FreeSurface(surface);
+        return region;
+    }
+
+    AtlasRegion TextureAtlas::addFromRW(const std::string &name,
+                                        SDL_RWops *rw) {
+        auto it = m_regions.find(name);
+        if (it != m_regions.end()) {
+            if (rw)
+                SDL_RWclose(rw);
+            return it->second;
+        }
+        SDL_Surface *surface = rw ? IMG_Load_RW(rw, 1) : nullptr;
+        if (!surface) {
+            SQUIDL_LOG_ERROR << "TextureAtlas: Failed to load image '" << name
+                             << "': " << IMG_GetError();
+            return {};
+        }
+        AtlasRegion region = add(name, surface);
+        SDL_FreeSurface(surface);
+        return region;
+    }
+
+    AtlasRegion TextureAtlas::find(const std::string &name) const {
+        auto it = m_regions.find(name);
+        return it != m_regions.end() ? it->second : AtlasRegion();
+    }
+
+    TextureAtlasStats TextureAtlas::getStats() const {
+        TextureAtlasStats stats;
+        stats.images = m_regions.size();
+        stats.pages = m_pages.size();
+        stats.rejected = m_rejected;
+        if (!m_pages.empty()) {
+            float covered = 0.0f;
+            for (const Page &page : m_pages)
+                covered += page.packer.getOccupancy();
+            stats.occupancy = covered / m_pages.size();
+        }
+        return stats;
+    }
+
+    bool TextureAtlas::addPage() {
+        SDL_Texture *texture =
+            SDL_CreateTexture(m_sdlRenderer, SDL_PIXELFORMAT_ARGB8888,
+                              SDL_TEXTUREACCESS_STATIC, m_pageSize, m_pageSize);
+        if (!texture) {
+            SQUIDL_LOG_ERROR << "TextureAtlas: Failed to create atlas page: "
+                             << SDL_GetError();
+            return false;
+        }
+        SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+
+        Page page;
+        page.texture = texture;
+        page.packer.reset(m_pageSize, m_pageSize);
+        m_pages.push_back(std::move(page));
+        SQUIDL_LOG_DEBUG << "TextureAtlas: Allocated page " << m_pages.size()
+                         << " (" << m_pageSize << "x" << m_pageSize << ").";
+        return true;
+    }
+
+} // namespace Squidl::Renderers
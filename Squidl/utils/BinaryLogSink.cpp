@@ -0,0 +1,136 @@
+// squidl/utils/BinaryLogSink.cpp
+#include "Squidl/utils/BinaryLogSink.h"
+#include <chrono>
+#include <cstring> // Для std::memcpy, std::memset
+#include <iostream>
+
+namespace Squidl::Utils {
+
+    using namespace BinaryLog;
+
+    BinaryLogSink::BinaryLogSink(const std::string &path,
+                                 std::size_t fileSize,
+                                 std::size_t locationsSize) {
+        const std::uint64_t headerSize =
+            alignUp(sizeof(FileHeader), RecordAlignment);
+        const std::uint64_t locations = alignUp(locationsSize, RecordAlignment);
+        // Кольцо должно вмещать хотя бы несколько записей
+        if (fileSize < headerSize + locations + 4096) {
+            std::cerr << "BinaryLogSink: File size " << fileSize
+                      << " is too small for " << path << std::endl;
+            return;
+        }
+        // Logger здесь использовать нельзя - приёмник сам часть логгера
+        if (!m_file.create(path, fileSize)) {
+            std::cerr << "BinaryLogSink: " << m_file.getError() << std::endl;
+            return;
+        }
+
+        std::uint8_t *base = m_file.writableData();
+        m_header = reinterpret_cast<FileHeader *>(base);
+        std::memcpy(m_header->magic, FileMagic, sizeof(FileMagic));
+        m_header->version = FormatVersion;
+        m_header->headerSize = static_cast<std::uint32_t>(sizeof(FileHeader));
+        m_header->fileSize = fileSize;
+        m_header->locationsOffset = headerSize;
+        m_header->locationsSize = locations;
+        m_header->locationsUsed = 0;
+        m_header->ringOffset = headerSize + locations;
+        m_header->ringSize = (fileSize - m_header->ringOffset) /
+                             RecordAlignment * RecordAlignment;
+        m_header->writeOffset = 0;
+        m_header->wrapCount = 0;
+        m_header->recordCount = 0;
+        m_header->droppedCount = 0;
+
+        m_locations = base + m_header->locationsOffset;
+        m_ring = base + m_header->ringOffset;
+    }
+
+    BinaryLogSink::~BinaryLogSink() {
+        if (m_header)
+            m_file.flush(true);
+    }
+
+    void BinaryLogSink::writeLocation(const LogLocation &location) {
+        const std::uint32_t fileLength =
+            location.file
+                ? static_cast<std::uint32_t>(std::strlen(location.file))
+                : 0;
+        const std::uint64_t size =
+            alignUp(sizeof(LocationEntry) + fileLength, 4);
+        if (m_header->locationsUsed + size > m_header->locationsSize)
+            return; // Таблица заполнена - запись останется только с id
+
+        std::uint8_t *at = m_locations + m_header->locationsUsed;
+        LocationEntry entry{location.id,
+                            static_cast<std::uint32_t>(location.line),
+                            fileLength};
+        std::memcpy(at, &entry, sizeof(entry));
+        if (fileLength)
+            std::memcpy(at + sizeof(entry), location.file, fileLength);
+        m_header->locationsUsed += size;
+    }
+
+    void BinaryLogSink::write(const LogRecord &record) {
+        if (!m_header)
+            return;
+
+        if (record.location.id != 0 &&
+            m_knownLocations.insert(record.location.id).second) {
+            writeLocation(record.location);
+        }
+
+        const std::uint64_t ringSize = m_header->ringSize;
+        const std::uint64_t size =
+            alignUp(sizeof(RecordHeader) + record.args.size(), RecordAlignment);
+        if (size > ringSize / 2) {
+            // Такая запись вытеснила бы почти весь лог
+            ++m_header->droppedCount;
+            return;
+        }
+
+        std::uint64_t offset = m_header->writeOffset;
+        if (offset + size > ringSize) {
+            if (ringSize - offset >= sizeof(RecordHeader)) {
+                RecordHeader end{};
+                end.magic = RecordMagic;
+                end.size = 0;
+                std::memcpy(m_ring + offset, &end, sizeof(end));
+            }
+            offset = 0;
+            ++m_header->wrapCount;
+        }
+
+        RecordHeader header{};
+        header.magic = RecordMagic;
+        header.size = static_cast<std::uint32_t>(size);
+        header.timestampNs = static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                record.time.time_since_epoch())
+                .count());
+        header.locationId = record.location.id;
+        header.thread = record.thread;
+        header.argsSize = static_cast<std::uint32_t>(record.args.size());
+        header.level = static_cast<std::uint8_t>(record.level);
+
+        std::uint8_t *at = m_ring + offset;
+        std::memcpy(at, &header, sizeof(header));
+        if (!record.args.empty())
+            std::memcpy(at + sizeof(header), record.args.data(),
+                        record.args.size());
+        const std::size_t used = sizeof(header) + record.args.size();
+        std::memset(at + used, 0, static_cast<std::size_t>(size - used));
+
+        m_header->writeOffset = offset + size;
+        ++m_header->recordCount;
+    }
+
+    void BinaryLogSink::flush() {
+        // Только планируем запись страниц: частый синхронный сброс и есть
+        // лишний износ флеш-памяти
+        if (m_header)
+            m_file.flush(false);
+    }
+
+} // namespace Squidl::Utils
@@ -0,0 +1,171 @@
+// squidl/utils/LogSink.cpp
+#include "Squidl/utils/LogSink.h"
+#include <cstdio> // Для std::rename, std::remove
+#include <ctime>  // Для localtime_r / localtime_s
+#include <iostream>
+
+namespace Squidl::Utils {
+
+    std::string LogSink::formatTime(std::chrono::system_clock::time_point t) {
+        const std::time_t tt = std::chrono::system_clock::to_time_t(t);
+        std::tm tm{};
+        // std::localtime не потокобезопасен, а приёмник может работать в
+        // фоновом потоке
+#ifdef _WIN32
+        localtime_s(&tm, &tt);
+#else
+        localtime_r(&tt, &tm);
+#endif
+        char buffer[32];
+        const std::size_t n =
+            std::strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S", &tm);
+        return std::string(buffer, n);
+    }
+
+    const char *LogSink::levelToString(LogLevel level) {
+        switch (level) {
+        case LogLevel::Debug:
+            return "DEBUG";
+        case LogLevel::Info:
+            return "INFO";
+        case LogLevel::Warning:
+            return "WARNING";
+        case LogLevel::Error:
+            return "ERROR";
+        case LogLevel::Fatal:
+            return "FATAL";
+        default:
+            return "UNKNOWN";
+        }
+    }
+
+    // ---------------------------- ConsoleLogSink ---------------------------
+
+    void ConsoleLogSink::write(const LogRecord &record) {
+        if (m_colored) {
+            // Выбор цвета в зависимости от уровня
+            const std::string *colorCode = &ConsoleColors::RESET;
+            switch (record.level) {
+            case LogLevel::Debug:
+                colorCode = &ConsoleColors::CYAN;
+                break;
+            case LogLevel::Info:
+                colorCode = &ConsoleColors::GREEN;
+                break;
+            case LogLevel::Warning:
+                colorCode = &ConsoleColors::YELLOW;
+                break;
+            case LogLevel::Error:
+                colorCode = &ConsoleColors::RED;
+                break;
+            case LogLevel::Fatal:
+                colorCode = &ConsoleColors::BRIGHT_RED;
+                break;
+            default:
+                break;
+            }
+            std::cout << *colorCode;
+        }
+        std::cout << "[" << formatTime(record.time) << "] ["
+                  << levelToString(record.level) << "] "
+                  << record.formatMessage();
+        if (m_colored)
+            std::cout << ConsoleColors::RESET;
+        // Ошибки сбрасываются сразу, чтобы не потеряться при аварийном выходе
+        if (record.level >= LogLevel::Error)
+            std::cout << std::endl;
+        else
+            std::cout << '\n';
+    }
+
+    void ConsoleLogSink::flush() { std::cout.flush(); }
+
+    // ----------------------------- FileLogSink -----------------------------
+
+    FileLogSink::FileLogSink(const std::string &path, bool append)
+        : m_path(path),
+          m_file(path, append ? std::ios::out | std::ios::app
+                              : std::ios::out | std::ios::trunc) {
+        if (!m_file.is_open()) {
+            // Logger здесь использовать нельзя - приёмник сам часть логгера
+            std::cerr << "FileLogSink: Failed to open " << path << std::endl;
+        }
+    }
+
+    std::size_t FileLogSink::writeLine(const LogRecord &record) {
+        std::string line;
+        line.reserve(record.args.size() + 48);
+        line += '[';
+        line += formatTime(record.time);
+        line += "] [";
+        line += levelToString(record.level);
+        line += "] [T";
+        line += std::to_string(record.thread);
+        line += "] ";
+        line += record.formatMessage();
+        line += '\n';
+        m_file << line;
+        return line.size();
+    }
+
+    void FileLogSink::write(const LogRecord &record) {
+        if (!m_file.is_open())
+            return;
+        writeLine(record);
+        if (record.level >= LogLevel::Error)
+            m_file.flush();
+    }
+
+    void FileLogSink::flush() {
+        if (m_file.is_open())
+            m_file.flush();
+    }
+
+    // -------------------------- RotatingFileLogSink -------------------------
+
+    RotatingFileLogSink::RotatingFileLogSink(const std::string &path,
+                                             std::size_t maxBytes,
+                                             std::size_t maxFiles)
+        : FileLogSink(path, true), m_maxBytes(maxBytes),
+          m_maxFiles(maxFiles) {
+        if (m_file.is_open()) {
+            m_file.seekp(0, std::ios::end);
+            const auto pos = m_file.tellp();
+            m_size = pos > 0 ? static_cast<std::size_t>(pos) : 0;
+        }
+    }
+
+    void RotatingFileLogSink::write(const LogRecord &record) {
+        if (!m_file.is_open())
+            return;
+        if (m_maxBytes > 0 && m_size >= m_maxBytes)
+            rotate();
+        if (!m_file.is_open())
+            return;
+        m_size += writeLine(record);
+        if (record.level >= LogLevel::Error)
+            m_file.flush();
+    }
+
+    void RotatingFileLogSink::rotate() {
+        m_file.close();
+        if (m_maxFiles == 0) {
+            std::remove(m_path.c_str());
+        } else {
+            // path.(N-1) -> path.N, ..., path -> path.1
+            std::remove((m_path + "." + std::to_string(m_maxFiles)).c_str());
+            for (std::size_t i = m_maxFiles; i > 1; --i) {
+                std::rename((m_path + "." + std::to_string(i - 1)).c_str(),
+                            (m_path + "." + std::to_string(i)).c_str());
+            }
+            std::rename(m_path.c_str(), (m_path + ".1").c_str());
+        }
+        m_file.open(m_path, std::ios::out | std::ios::trunc);
+        m_size = 0;
+        if (!m_file.is_open()) {
+            std::cerr << "RotatingFileLogSink: Failed to reopen " << m_path
+                      << std::endl;
+        }
+    }
+
+} // namespace Squidl::Utils
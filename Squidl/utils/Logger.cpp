@@ -0,0 +1,366 @@
+// squidl/utils/Logger.cpp
+#include "Squidl/utils/Logger.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint> // Для std::intptr_t
+#include <cstdlib> // Для std::atexit
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Squidl::Utils {
+
+    namespace {
+
+        std::uint32_t currentThreadId() {
+            static std::atomic<std::uint32_t> nextId{0};
+            thread_local const std::uint32_t id =
+                nextId.fetch_add(1, std::memory_order_relaxed) + 1;
+            return id;
+        }
+
+        // Ограниченная lock-free очередь (схема Д. Вьюкова). Каждая ячейка
+        // хранит номер последовательности: seq == pos - ячейка свободна для
+        // записи с позиции pos, seq == pos + 1 - в ней готовая запись.
+        // Безопасна для нескольких производителей и потребителей; из
+        // потребителей это фоновый поток и производители с политикой
+        // DropOldest
+        class LogQueue {
+          public:
+            explicit LogQueue(std::size_t capacity) {
+                std::size_t size = 2;
+                while (size < capacity)
+                    size <<= 1;
+                m_cells.reset(new Cell[size]);
+                m_mask = size - 1;
+                for (std::size_t i = 0; i < size; ++i)
+                    m_cells[i].seq.store(i, std::memory_order_relaxed);
+            }
+
+            // При неудаче запись не перемещается
+            bool tryPush(LogRecord &record) {
+                std::size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+                for (;;) {
+                    Cell &cell = m_cells[pos & m_mask];
+                    const std::size_t seq =
+                        cell.seq.load(std::memory_order_acquire);
+                    const auto diff = static_cast<std::intptr_t>(seq) -
+                                      static_cast<std::intptr_t>(pos);
+                    if (diff == 0) {
+                        if (m_enqueuePos.compare_exchange_weak(
+                                pos, pos + 1, std::memory_order_relaxed)) {
+                            cell.record = std::move(record);
+                            cell.seq.store(pos + 1, std::memory_order_release);
+                            return true;
+                        }
+                    } else if (diff < 0) {
+                        return false; // Очередь полна
+                    } else {
+                        pos = m_enqueuePos.load(std::memory_order_relaxed);
+                    }
+                }
+            }
+
+            bool tryPop(LogRecord &out) {
+                std::size_t pos = m_dequeuePos.load(std::memory_order_relaxed);
+                for (;;) {
+                    Cell &cell = m_cells[pos & m_mask];
+                    const std::size_t seq =
+                        cell.seq.load(std::memory_order_acquire);
+                    const auto diff = static_cast<std::intptr_t>(seq) -
+                                      static_cast<std::intptr_t>(pos + 1);
+                    if (diff == 0) {
+                        if (m_dequeuePos.compare_exchange_weak(
+                                pos, pos + 1, std::memory_order_relaxed)) {
+                            out = std::move(cell.record);
+                            cell.seq.store(pos + m_mask + 1,
+                                           std::memory_order_release);
+                            return true;
+                        }
+                    } else if (diff < 0) {
+                        return false; // Очередь пуста
+                    } else {
+                        pos = m_dequeuePos.load(std::memory_order_relaxed);
+                    }
+                }
+            }
+
+            bool empty() const {
+                return m_dequeuePos.load(std::memory_order_acquire) ==
+                       m_enqueuePos.load(std::memory_order_acquire);
+            }
+
+          private:
+            struct Cell {
+                std::atomic<std::size_t> seq{0};
+                LogRecord record;
+            };
+
+            std::unique_ptr<Cell[]> m_cells;
+            std::size_t m_mask = 0;
+            // Разные кэш-линии, чтобы производители не мешали потребителю
+            alignas(64) std::atomic<std::size_t> m_enqueuePos{0};
+            alignas(64) std::atomic<std::size_t> m_dequeuePos{0};
+        };
+
+        struct AsyncState {
+            explicit AsyncState(const LogAsyncOptions &options)
+                : queue(options.capacity), overflow(options.overflow) {}
+
+            LogQueue queue;
+            LogOverflowPolicy overflow;
+            std::thread worker;
+            std::atomic<bool> stop{false};
+            // Производители внутри submit; остановка ждёт, пока их не станет
+            std::atomic<int> producers{0};
+            // Поставлено / обработано (записано или отброшено) - для flush()
+            std::atomic<std::uint64_t> submitted{0};
+            std::atomic<std::uint64_t> completed{0};
+            // Будим поток, только если он действительно спит
+            std::mutex wakeMutex;
+            std::condition_variable wake;
+            std::atomic<bool> sleeping{false};
+        };
+
+        struct LoggerState {
+            std::mutex sinkMutex;
+            std::vector<std::shared_ptr<LogSink>> sinks;
+            std::shared_ptr<LogSink> defaultSink =
+                std::make_shared<ConsoleLogSink>();
+
+            std::mutex asyncMutex; // enableAsync / disableAsync
+            std::atomic<AsyncState *> async{nullptr};
+            // Остановленные состояния не удаляются: производитель мог
+            // успеть прочитать указатель до остановки
+            std::vector<std::unique_ptr<AsyncState>> retired;
+            bool atexitRegistered = false;
+
+            std::atomic<std::uint64_t> dropped{0};
+        };
+
+        // Намеренно не уничтожается: логировать могут деструкторы других
+        // статических объектов. Фоновый поток останавливается через atexit
+        LoggerState &state() {
+            static LoggerState *s = new LoggerState();
+            return *s;
+        }
+
+        void writeToSinks(LoggerState &st, const LogRecord &record) {
+            std::lock_guard<std::mutex> lock(st.sinkMutex);
+            if (st.sinks.empty()) {
+                st.defaultSink->write(record);
+                return;
+            }
+            for (const auto &sink : st.sinks)
+                sink->write(record);
+        }
+
+        void flushSinks(LoggerState &st) {
+            std::lock_guard<std::mutex> lock(st.sinkMutex);
+            if (st.sinks.empty())
+                st.defaultSink->flush();
+            for (const auto &sink : st.sinks)
+                sink->flush();
+        }
+
+        void wakeWorker(AsyncState &a) {
+            if (a.sleeping.load()) {
+                std::lock_guard<std::mutex> lock(a.wakeMutex);
+                a.wake.notify_one();
+            }
+        }
+
+        void workerLoop(LoggerState &st, AsyncState &a) {
+            LogRecord record;
+            for (;;) {
+                bool wrote = false;
+                while (a.queue.tryPop(record)) {
+                    writeToSinks(st, record);
+                    a.completed.fetch_add(1, std::memory_order_release);
+                    wrote = true;
+                }
+                if (wrote) {
+                    flushSinks(st);
+                    continue;
+                }
+                if (a.stop.load())
+                    break;
+
+                std::unique_lock<std::mutex> lock(a.wakeMutex);
+                a.sleeping.store(true);
+                // Таймаут страхует от пропущенного пробуждения
+                a.wake.wait_for(lock, std::chrono::milliseconds(50), [&] {
+                    return a.stop.load() || !a.queue.empty();
+                });
+                a.sleeping.store(false);
+            }
+        }
+
+        void pushAsync(LoggerState &st, AsyncState &a, LogRecord &record) {
+            a.submitted.fetch_add(1);
+            switch (a.overflow) {
+            case LogOverflowPolicy::Block:
+                while (!a.queue.tryPush(record)) {
+                    wakeWorker(a);
+                    std::this_thread::yield();
+                }
+                break;
+            case LogOverflowPolicy::DropNewest:
+                if (!a.queue.tryPush(record)) {
+                    st.dropped.fetch_add(1, std::memory_order_relaxed);
+                    a.completed.fetch_add(1, std::memory_order_release);
+                    return;
+                }
+                break;
+            case LogOverflowPolicy::DropOldest: {
+                LogRecord oldest;
+                while (!a.queue.tryPush(record)) {
+                    if (a.queue.tryPop(oldest)) {
+                        st.dropped.fetch_add(1, std::memory_order_relaxed);
+                        a.completed.fetch_add(1, std::memory_order_release);
+                    }
+                }
+                break;
+            }
+            }
+            wakeWorker(a);
+        }
+
+        // Вызывается под asyncMutex
+        void stopAsyncLocked(LoggerState &st) {
+            AsyncState *a = st.async.exchange(nullptr);
+            if (!a)
+                return;
+            while (a->producers.load() != 0)
+                std::this_thread::yield();
+            {
+                std::lock_guard<std::mutex> lock(a->wakeMutex);
+                a->stop.store(true);
+                a->wake.notify_one();
+            }
+            if (a->worker.joinable())
+                a->worker.join();
+            flushSinks(st);
+            st.retired.emplace_back(a);
+        }
+
+    } // namespace
+
+    // ------------------------------ LogStreamProxy ---------------------------
+
+    LogStreamProxy::LogStreamProxy(LogLevel level,
+                                   const LogLocation &location)
+        : m_level(level), m_enabled(Logger::isEnabled(level)),
+          m_location(location) {}
+
+    LogStreamProxy::~LogStreamProxy() {
+        if (!m_enabled)
+            return;
+        LogRecord record;
+        record.level = m_level;
+        record.time = std::chrono::system_clock::now();
+        record.location = m_location;
+        record.args = std::move(m_args);
+        Logger::submit(std::move(record));
+    }
+
+    // ---------------------------------- Logger -------------------------------
+
+    void Logger::addSink(std::shared_ptr<LogSink> sink) {
+        if (!sink)
+            return;
+        LoggerState &st = state();
+        std::lock_guard<std::mutex> lock(st.sinkMutex);
+        st.sinks.push_back(std::move(sink));
+    }
+
+    void Logger::removeSink(const std::shared_ptr<LogSink> &sink) {
+        LoggerState &st = state();
+        std::lock_guard<std::mutex> lock(st.sinkMutex);
+        for (auto it = st.sinks.begin(); it != st.sinks.end(); ++it) {
+            if (*it == sink) {
+                st.sinks.erase(it);
+                return;
+            }
+        }
+    }
+
+    void Logger::clearSinks() {
+        LoggerState &st = state();
+        std::lock_guard<std::mutex> lock(st.sinkMutex);
+        st.sinks.clear();
+    }
+
+    void Logger::enableAsync(const LogAsyncOptions &options) {
+        LoggerState &st = state();
+        std::lock_guard<std::mutex> lock(st.asyncMutex);
+        stopAsyncLocked(st);
+
+        auto *a = new AsyncState(options);
+        a->worker = std::thread(workerLoop, std::ref(st), std::ref(*a));
+        st.async.store(a);
+        if (!st.atexitRegistered) {
+            // Дописываем очередь до выхода из программы
+            std::atexit([] { Logger::disableAsync(); });
+            st.atexitRegistered = true;
+        }
+    }
+
+    void Logger::disableAsync() {
+        LoggerState &st = state();
+        std::lock_guard<std::mutex> lock(st.asyncMutex);
+        stopAsyncLocked(st);
+    }
+
+    bool Logger::isAsync() { return state().async.load() != nullptr; }
+
+    void Logger::flush() {
+        LoggerState &st = state();
+        AsyncState *a = st.async.load();
+        if (a) {
+            a->producers.fetch_add(1);
+            if (st.async.load() == a) {
+                const std::uint64_t target = a->submitted.load();
+                while (a->completed.load(std::memory_order_acquire) <
+                       target) {
+                    wakeWorker(*a);
+                    std::this_thread::yield();
+                }
+            }
+            a->producers.fetch_sub(1);
+        }
+        flushSinks(st);
+    }
+
+    std::uint64_t Logger::getDroppedCount() {
+        return state().dropped.load(std::memory_order_relaxed);
+    }
+
+    void Logger::submit(LogRecord &&record) {
+        LoggerState &st = state();
+        if (record.thread == 0)
+            record.thread = currentThreadId();
+        const bool fatal = record.level == LogLevel::Fatal;
+
+        AsyncState *a = st.async.load();
+        if (a) {
+            // Повторная проверка после регистрации: остановка сначала
+            // снимает указатель, а потом ждёт ушедших производителей
+            a->producers.fetch_add(1);
+            if (st.async.load() == a) {
+                pushAsync(st, *a, record);
+                a->producers.fetch_sub(1);
+                if (fatal)
+                    flush();
+                return;
+            }
+            a->producers.fetch_sub(1);
+        }
+
+        writeToSinks(st, record);
+        if (fatal)
+            flushSinks(st);
+    }
+
+} // namespace Squidl::Utils
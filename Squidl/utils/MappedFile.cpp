@@ -0,0 +1,208 @@
+// squidl/utils/MappedFile.cpp
+#include "Squidl/utils/MappedFile.h"
+#include <cstring> // For std::strerror
+#include <utility> // For std::swap
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Squidl::Utils {
+
+    MappedFile::~MappedFile() { close(); }
+
+    MappedFile::MappedFile(MappedFile &&other) noexcept { *this = std::move(other); }
+
+    MappedFile &MappedFile::operator=(MappedFile &&other) noexcept {
+        if (this != &other) {
+            close();
+            std::swap(m_data, other.m_data);
+            std::swap(m_size, other.m_size);
+            std::swap(m_writable, other.m_writable);
+            std::swap(m_path, other.m_path);
+            std::swap(m_error, other.m_error);
+#ifdef _WIN32
+            std::swap(m_file, other.m_file);
+            std::swap(m_mapping, other.m_mapping);
+#else
+            std::swap(m_fd, other.m_fd);
+#endif
+        }
+        return *this;
+    }
+
+    bool MappedFile::fail(const std::string &what) {
+#ifdef _WIN32
+        m_error = what + " '" + m_path + "' (error " +
+                  std::to_string(GetLastError()) + ")";
+#else
+        m_error = what + " '" + m_path + "': " + std::strerror(errno);
+#endif
+        const std::string error = m_error;
+        close();
+        m_error = error;
+        return false;
+    }
+
+#ifdef _WIN32
+
+    bool MappedFile::openRead(const std::string &path) {
+        close();
+        m_path = path;
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                                  nullptr, OPEN_EXISTING,
+                                  FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+            return fail("Failed to open");
+        m_file = file;
+
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file, &size))
+            return fail("Failed to stat");
+        if (size.QuadPart == 0)
+            return fail("Cannot map empty file");
+
+        m_mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0,
+                                       nullptr);
+        if (!m_mapping)
+            return fail("Failed to map");
+        m_data = static_cast<std::uint8_t *>(
+            MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+        if (!m_data)
+            return fail("Failed to map");
+        m_size = static_cast<std::size_t>(size.QuadPart);
+        m_writable = false;
+        return true;
+    }
+
+    bool MappedFile::create(const std::string &path, std::size_t size) {
+        close();
+        m_path = path;
+        if (size == 0)
+            return fail("Cannot map empty file");
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE,
+                                  FILE_SHARE_READ, nullptr, CREATE_ALWAYS,
+                                  FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+            return fail("Failed to create");
+        m_file = file;
+
+        const auto size64 = static_cast<std::uint64_t>(size);
+        m_mapping = CreateFileMappingA(
+            file, nullptr, PAGE_READWRITE, static_cast<DWORD>(size64 >> 32),
+            static_cast<DWORD>(size64 & 0xFFFFFFFFu), nullptr);
+        if (!m_mapping)
+            return fail("Failed to map");
+        m_data = static_cast<std::uint8_t *>(
+            MapViewOfFile(m_mapping, FILE_MAP_ALL_ACCESS, 0, 0, size));
+        if (!m_data)
+            return fail("Failed to map");
+        m_size = size;
+        m_writable = true;
+        return true;
+    }
+
+    void MappedFile::close() {
+        if (m_data)
+            UnmapViewOfFile(m_data);
+        if (m_mapping)
+            CloseHandle(static_cast<HANDLE>(m_mapping));
+        if (m_file)
+            CloseHandle(static_cast<HANDLE>(m_file));
+        m_data = nullptr;
+        m_mapping = nullptr;
+        m_file = nullptr;
+        m_size = 0;
+        m_writable = false;
+        m_error.clear();
+    }
+
+    bool MappedFile::flush(bool synchronous) {
+        if (!m_data || !m_writable)
+            return true;
+        if (!FlushViewOfFile(m_data, m_size))
+            return false;
+        return !synchronous ||
+               FlushFileBuffers(static_cast<HANDLE>(m_file)) != 0;
+    }
+
+#else
+
+    bool MappedFile::openRead(const std::string &path) {
+        close();
+        m_path = path;
+        m_fd = ::open(path.c_str(), O_RDONLY);
+        if (m_fd < 0)
+            return fail("Failed to open");
+
+        struct stat st;
+        if (::fstat(m_fd, &st) != 0)
+            return fail("Failed to stat");
+        if (st.st_size == 0) {
+            errno = EINVAL;
+            return fail("Cannot map empty file");
+        }
+
+        void *data = ::mmap(nullptr, static_cast<std::size_t>(st.st_size),
+                            PROT_READ, MAP_SHARED, m_fd, 0);
+        if (data == MAP_FAILED)
+            return fail("Failed to map");
+        m_data = static_cast<std::uint8_t *>(data);
+        m_size = static_cast<std::size_t>(st.st_size);
+        m_writable = false;
+        return true;
+    }
+
+    bool MappedFile::create(const std::string &path, std::size_t size) {
+        close();
+        m_path = path;
+        if (size == 0) {
+            errno = EINVAL;
+            return fail("Cannot map empty file");
+        }
+        m_fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (m_fd < 0)
+            return fail("Failed to create");
+        if (::ftruncate(m_fd, static_cast<off_t>(size)) != 0)
+            return fail("Failed to resize");
+
+        void *data = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED,
+                            m_fd, 0);
+        if (data == MAP_FAILED)
+            return fail("Failed to map");
+        m_data = static_cast<std::uint8_t *>(data);
+        m_size = size;
+        m_writable = true;
+        return true;
+    }
+
+    void MappedFile::close() {
+        if (m_data)
+            ::munmap(m_data, m_size);
+        if (m_fd >= 0)
+            ::close(m_fd);
+        m_data = nullptr;
+        m_fd = -1;
+        m_size = 0;
+        m_writable = false;
+        m_error.clear();
+    }
+
+    bool MappedFile::flush(bool synchronous) {
+        if (!m_data || !m_writable)
+            return true;
+        return ::msync(m_data, m_size, synchronous ? MS_SYNC : MS_ASYNC) == 0;
+    }
+
+#endif
+
+} // namespace Squidl::Utils
@@ -0,0 +1,199 @@
+// squidl/utils/Profiler.cpp
+#include "Squidl/utils/Profiler.h"
+#include "Squidl/utils/Logger.h" // For logging
+#include <chrono>
+#include <cstdio> // For std::snprintf
+#include <fstream>
+#include <memory>
+
+namespace Squidl::Utils {
+
+    std::atomic<bool> Profiler::s_enabled{false};
+
+    namespace {
+        constexpr std::size_t DefaultCapacity = std::size_t(1) << 16;
+
+        // A slot is guarded by a sequence number (seqlock): odd while a
+        // writer fills it, 2 * index + 2 once event number `index` is
+        // complete. Readers never block writers and drop torn slots.
+        struct Slot {
+            std::atomic<std::uint64_t> seq{0};
+            std::atomic<const char *> name{nullptr};
+            std::atomic<const void *> object{nullptr};
+            std::atomic<std::uint64_t> startNs{0};
+            std::atomic<std::uint64_t> durationNs{0};
+            std::atomic<std::uint32_t> thread{0};
+        };
+
+        struct Ring {
+            std::unique_ptr<Slot[]> slots;
+            std::size_t mask = 0;
+            std::atomic<std::uint64_t> head{0}; // Next event index
+
+            explicit Ring(std::size_t capacity) { resize(capacity); }
+
+            void resize(std::size_t capacity) {
+                std::size_t size = 2;
+                while (size < capacity)
+                    size <<= 1;
+                slots.reset(new Slot[size]);
+                mask = size - 1;
+                head.store(0, std::memory_order_relaxed);
+            }
+        };
+
+        // Allocated on first use, so the buffer costs nothing until the
+        // profiler is actually enabled
+        Ring &ring() {
+            static Ring r(DefaultCapacity);
+            return r;
+        }
+
+        const std::chrono::steady_clock::time_point &epoch() {
+            static const auto start = std::chrono::steady_clock::now();
+            return start;
+        }
+
+        std::uint32_t currentThreadId() {
+            static std::atomic<std::uint32_t> nextId{0};
+            thread_local const std::uint32_t id =
+                nextId.fetch_add(1, std::memory_order_relaxed) + 1;
+            return id;
+        }
+
+        void writeJsonString(std::ostream &os, const char *s) {
+            os << '"';
+            for (; s && *s; ++s) {
+                const char c = *s;
+                if (c == '"' || c == '\\')
+                    os << '\\' << c;
+                else if (static_cast<unsigned char>(c) < 0x20)
+                    os << ' ';
+                else
+                    os << c;
+            }
+            os << '"';
+        }
+    } // namespace
+
+    std::uint64_t Profiler::now() {
+        const auto &start = epoch();
+        return static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - start)
+                .count());
+    }
+
+    void Profiler::setCapacity(std::size_t events) {
+        ring().resize(events);
+    }
+
+    std::size_t Profiler::getCapacity() { return ring().mask + 1; }
+
+    void Profiler::record(const char *name, const void *object,
+                          std::uint64_t startNs, std::uint64_t endNs) {
+        Ring &r = ring();
+        const std::uint64_t index =
+            r.head.fetch_add(1, std::memory_order_relaxed);
+        Slot &slot = r.slots[index & r.mask];
+
+        slot.seq.store(2 * index + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.name.store(name, std::memory_order_relaxed);
+        slot.object.store(object, std::memory_order_relaxed);
+        slot.startNs.store(startNs, std::memory_order_relaxed);
+        slot.durationNs.store(endNs > startNs ? endNs - startNs : 0,
+                              std::memory_order_relaxed);
+        slot.thread.store(currentThreadId(), std::memory_order_relaxed);
+        slot.seq.store(2 * index + 2, std::memory_order_release);
+    }
+
+    std::vector<ProfileEvent> Profiler::snapshot() {
+        Ring &r = ring();
+        const std::uint64_t head = r.head.load(std::memory_order_acquire);
+        const std::uint64_t capacity = r.mask + 1;
+        const std::uint64_t begin = head > capacity ? head - capacity : 0;
+
+        std::vector<ProfileEvent> events;
+        events.reserve(static_cast<std::size_t>(head - begin));
+        for (std::uint64_t index = begin; index < head; ++index) {
+            const Slot &slot = r.slots[index & r.mask];
+            const std::uint64_t before =
+                slot.seq.load(std::memory_order_acquire);
+            if (before != 2 * index + 2)
+                continue; // Still being written or already overwritten
+
+            ProfileEvent e;
+            e.name = slot.name.load(std::memory_order_relaxed);
+            e.object = slot.object.load(std::memory_order_relaxed);
+            e.startNs = slot.startNs.load(std::memory_order_relaxed);
+            e.durationNs = slot.durationNs.load(std::memory_order_relaxed);
+            e.thread = slot.thread.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.seq.load(std::memory_order_relaxed) != before)
+                continue;
+            events.push_back(e);
+        }
+        return events;
+    }
+
+    std::uint64_t Profiler::getDroppedCount() {
+        Ring &r = ring();
+        const std::uint64_t head = r.head.load(std::memory_order_relaxed);
+        const std::uint64_t capacity = r.mask + 1;
+        return head > capacity ? head - capacity : 0;
+    }
+
+    void Profiler::clear() {
+        Ring &r = ring();
+        for (std::size_t i = 0; i <= r.mask; ++i)
+            r.slots[i].seq.store(0, std::memory_order_relaxed);
+        r.head.store(0, std::memory_order_release);
+    }
+
+    bool Profiler::writeChromeTrace(const std::string &path) {
+        const std::vector<ProfileEvent> events = snapshot();
+
+        std::ofstream out(path, std::ios::out | std::ios::trunc);
+        if (!out) {
+            SQUIDL_LOG_ERROR << "Profiler: Failed to open trace file: "
+                             << path;
+            return false;
+        }
+
+        out << "{\"displayTimeUnit\":\"ms\",\"otherData\":{\"dropped\":"
+            << getDroppedCount() << "},\"traceEvents\":[";
+        char numbers[96];
+        bool first = true;
+        for (const ProfileEvent &e : events) {
+            out << (first ? "\n" : ",\n");
+            first = false;
+            out << "{\"name\":";
+            writeJsonString(out, e.name ? e.name : "?");
+            // Complete events; timestamps are microseconds
+            std::snprintf(numbers, sizeof(numbers),
+                          ",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f",
+                          static_cast<double>(e.startNs) / 1000.0,
+                          static_cast<double>(e.durationNs) / 1000.0);
+            out << ",\"cat\":\"squidl\"" << numbers
+                << ",\"pid\":1,\"tid\":" << e.thread;
+            if (e.object) {
+                std::snprintf(numbers, sizeof(numbers), "%p",
+                              const_cast<void *>(e.object));
+                out << ",\"args\":{\"object\":\"" << numbers << "\"}";
+            }
+            out << '}';
+        }
+        out << "\n]}\n";
+
+        if (!out) {
+            SQUIDL_LOG_ERROR << "Profiler: Failed to write trace file: "
+                             << path;
+            return false;
+        }
+        SQUIDL_LOG_INFO << "Profiler: Wrote " << events.size()
+                        << " events to " << path;
+        return true;
+    }
+
+} // namespace Squidl::Utils
@@ -0,0 +1,109 @@
+// squidl/utils/SkylinePacker.cpp
+#include "Squidl/utils/SkylinePacker.h"
+#include <algorithm> // For std::max
+#include <climits>   // For INT_MAX
+
+namespace Squidl::Utils {
+
+    SkylinePacker::SkylinePacker(int width, int height) {
+        reset(width, height);
+    }
+
+    void SkylinePacker::reset(int width, int height) {
+        m_width = std::max(0, width);
+        m_height = std::max(0, height);
+        m_usedArea = 0;
+        m_skyline.clear();
+        if (m_width > 0)
+            m_skyline.push_back({0, 0, m_width});
+    }
+
+    bool SkylinePacker::insert(int w, int h, UIRect &out) {
+        if (w <= 0 || h <= 0 || w > m_width || h > m_height)
+            return false;
+
+        int bestY = INT_MAX;
+        int bestWidth = INT_MAX;
+        std::size_t bestIndex = m_skyline.size();
+
+        for (std::size_t i = 0; i < m_skyline.size(); ++i) {
+            const int y = fitAt(i, w, h);
+            if (y < 0)
+                continue;
+            // Lowest position first, then the narrowest segment to keep
+            // wide gaps available for wide rectangles
+            if (y + h < bestY ||
+                (y + h == bestY && m_skyline[i].w < bestWidth)) {
+                bestY = y + h;
+                bestWidth = m_skyline[i].w;
+                bestIndex = i;
+                out = UIRect(m_skyline[i].x, y, w, h);
+            }
+        }
+
+        if (bestIndex == m_skyline.size())
+            return false;
+
+        addSegment(bestIndex, out);
+        m_usedArea += static_cast<long long>(w) * h;
+        return true;
+    }
+
+    float SkylinePacker::getOccupancy() const {
+        const long long total = static_cast<long long>(m_width) * m_height;
+        return total > 0 ? static_cast<float>(m_usedArea) / total : 0.0f;
+    }
+
+    int SkylinePacker::fitAt(std::size_t index, int w, int h) const {
+        const int x = m_skyline[index].x;
+        if (x + w > m_width)
+            return -1;
+
+        int remaining = w;
+        int y = m_skyline[index].y;
+        std::size_t i = index;
+        while (remaining > 0) {
+            if (i >= m_skyline.size())
+                return -1;
+            y = std::max(y, m_skyline[i].y);
+            if (y + h > m_height)
+                return -1;
+            remaining -= m_skyline[i].w;
+            ++i;
+        }
+        return y;
+    }
+
+    void SkylinePacker::addSegment(std::size_t index, const UIRect &placed) {
+        m_skyline.insert(m_skyline.begin() + index,
+                         {placed.x, placed.y + placed.h, placed.w});
+
+        // Trim or remove the segments now covered by the new one
+        for (std::size_t i = index + 1; i < m_skyline.size();) {
+            const Segment &prev = m_skyline[i - 1];
+            Segment &seg = m_skyline[i];
+            const int prevEnd = prev.x + prev.w;
+            if (seg.x >= prevEnd)
+                break;
+            const int shrink = prevEnd - seg.x;
+            seg.x += shrink;
+            seg.w -= shrink;
+            if (seg.w <= 0) {
+                m_skyline.erase(m_skyline.begin() + i);
+                continue;
+            }
+            break;
+        }
+
+        // Merge neighbouring segments of equal height
+        for (std::size_t i = 0; i + 1 < m_skyline.size();) {
+            if (m_skyline[i].y == m_skyline[i + 1].y) {
+                m_skyline[i].w += m_skyline[i + 1].w;
+                m_skyline.erase(m_skyline.begin() + i + 1);
+            } else {
+                ++i;
+            }
+        }
+    }
+
+} // namespace Squidl::Utils
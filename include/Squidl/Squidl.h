@@ -15,6 +15,8 @@
 #include "SquidlConfig.h"
 
 // --- Core Components ---
+#include "Squidl/core/ElementArena.h"
+#include "Squidl/core/ElementStore.h"
 #include "Squidl/core/EventDispatcher.h"
 #include "Squidl/core/UIAlignment.h"
 #include "Squidl/core/UIAnchor.h"
@@ -33,6 +35,7 @@
 #include "Squidl/elements/Backdrop.h"
 #include "Squidl/elements/Button.h"
 #include "Squidl/elements/Checkbox.h"
+#include "Squidl/elements/FlatView.h"
 #include "Squidl/elements/Input.h"
 #include "Squidl/elements/Label.h"
 #include "Squidl/elements/ToggleSwitch.h"
@@ -44,7 +47,10 @@
 #include "Squidl/layouts/GridLayout.h"
 #include "Squidl/layouts/HBoxLayout.h"
 #include "Squidl/layouts/Layout.h"
+#include "Squidl/layouts/ScrollView.h"
 #include "Squidl/layouts/VBoxLayout.h"
+#include "Squidl/layouts/VirtualGridLayout.h"
+#include "Squidl/layouts/VirtualListLayout.h"
 
 // --- Managers ---
 #include "Squidl/managers/FontManager.h"
@@ -54,13 +60,24 @@
 #include "Squidl/managers/UIThemeManager.h"
 
 // --- Renderers ---
+#include "Squidl/renderers/GlyphAtlas.h"
+#include "Squidl/renderers/RecordingRenderer.h"
 #include "Squidl/renderers/SDL2Renderer.h"
+#include "Squidl/renderers/TextTextureCache.h"
+#include "Squidl/renderers/TextureAtlas.h"
 
 // --- Utilities ---
 #include "Squidl/utils/Color.h"
 #include "Squidl/utils/UIRect.h" 
 #include "Squidl/utils/Point.h"
+#include "Squidl/utils/Profiler.h"
+#include "Squidl/utils/BinaryLogSink.h"
+#include "Squidl/utils/LogArgs.h"
+#include "Squidl/utils/LogSink.h"
 #include "Squidl/utils/Logger.h"
+#include "Squidl/utils/MappedFile.h"
+#include "Squidl/utils/Size.h"
+#include "Squidl/utils/SkylinePacker.h"
 #include "Squidl/utils/Timer.h"
 
 // Note: Editor-specific headers are generally not included in the main
@@ -29,6 +29,24 @@
     #define SQUIDL_API
 #endif
 
+// Profiling zones (see Squidl/utils/Profiler.h). Configured by the
+// SQUIDL_PROFILER CMake option; 0 compiles every zone out
+#ifndef SQUIDL_PROFILER_ENABLED
+    #define SQUIDL_PROFILER_ENABLED 1
+#endif
+
+// Lowest level of SQUIDL_LOG_* statements compiled into the code:
+// 0 Debug, 1 Info, 2 Warning, 3 Error, 4 Fatal, 5 none. Statements below it
+// expand to nothing. Configured by the SQUIDL_MIN_LOG_LEVEL CMake variable;
+// by default release (NDEBUG) builds drop Debug
+#ifndef SQUIDL_MIN_LOG_LEVEL
+    #ifdef NDEBUG
+        #define SQUIDL_MIN_LOG_LEVEL 1
+    #else
+        #define SQUIDL_MIN_LOG_LEVEL 0
+    #endif
+#endif
+
 // Define common namespaces for convenience
 namespace Squidl {
     // Top-level namespace for the entire library
@@ -2,6 +2,7 @@
 #include <SDL.h>     // For SDL_Texture (still used for now)
 #include <SDL_ttf.h> // For TTF_Font (still used for now)
 #include <algorithm> // For std::clamp
+#include <cstdint>   // For std::uint32_t
 #include <memory>    // For std::shared_ptr, std::weak_ptr
 
 #include "Squidl/SquidlConfig.h"     // For SQUIDL_API
@@ -11,6 +12,7 @@
 #include "Squidl/core/UIEvent.h"     // <--- ADDED: Include UIEvent.h
 #include "Squidl/utils/Color.h"      // Use Squidl::Utils::Color
 #include "Squidl/utils/Point.h"      // For Squidl::Utils::Point
+#include "Squidl/utils/Size.h"       // For Squidl::Utils::Size
 #include "Squidl/utils/UIRect.h"     // Use Squidl::Utils::UIRect
 
 // Forward declarations for types used as pointers/references
@@ -26,11 +28,19 @@ namespace Squidl::Base {
         : public std::enable_shared_from_this<
               UIElement> { // <--- ADDED: Inherit from enable_shared_from_this
       public:
-        virtual ~UIElement() = default;
+        virtual ~UIElement();
 
         virtual bool update(Squidl::Core::UIContext &ctx,
                             Squidl::Core::IRenderer &renderer) = 0;
 
+        /**
+         * @brief Draws the element: composites its cached layer if it has
+         * one (see setCachedLayer()), otherwise calls update(). Parents draw
+         * their children through this method.
+         */
+        bool draw(Squidl::Core::UIContext &ctx,
+                  Squidl::Core::IRenderer &renderer);
+
         virtual Squidl::Utils::UIRect getRect() const { return rect; };
         virtual void setRect(const Squidl::Utils::UIRect &newRect);
 
@@ -40,6 +50,25 @@ namespace Squidl::Base {
         Squidl::Utils::UIRect getLocalRect() const;
 
         virtual void autosize() = 0;
+
+        // ---------------- Measure / arrange ------------------
+        /**
+         * @brief Measure pass: returns the element's desired size.
+         * Runs autosize() only when the cached result was invalidated, so
+         * repeated layout passes (e.g. during a window resize) do not
+         * re-measure text. Layouts call this on children before arranging
+         * them through setRect().
+         */
+        Squidl::Utils::Size measure();
+
+        /**
+         * @brief Drops the cached desired size of this element and of every
+         * ancestor, whose size may depend on it. Call it whenever content or
+         * constraints that affect autosize() change.
+         */
+        void invalidateMeasure();
+        bool isMeasureValid() const { return measureValid; }
+        bool isLayoutValid() const { return layoutValid; }
         virtual void applyConstraints() {
             if (rect.w < minW)
                 rect.w = minW;
@@ -51,37 +80,73 @@ namespace Squidl::Base {
                 rect.h = maxH;
         };
         void setMinSize(int w, int h) {
+            const Squidl::Utils::UIRect old = rect;
             minW = w;
             minH = h;
             applyConstraints();
+            rectChanged(old);
+            invalidateMeasure();
         }
 
         void setMaxSize(int w, int h) {
+            const Squidl::Utils::UIRect old = rect;
             maxW = w;
             maxH = h;
             applyConstraints();
+            rectChanged(old);
+            invalidateMeasure();
         }
 
-        virtual void setFont(TTF_Font *f) { font = f; }
+        virtual void setFont(TTF_Font *f) {
+            if (font != f) {
+                font = f;
+                invalidate();
+                invalidateMeasure();
+            }
+        }
         virtual TTF_Font *getFont() { return font; }
 
         // Changed parameter and return types to Squidl::Utils::Color
-        void setBackgroundColor(Squidl::Utils::Color color) { bgColor = color; }
+        void setBackgroundColor(Squidl::Utils::Color color) {
+            if (bgColor != color) {
+                bgColor = color;
+                invalidate();
+            }
+        }
         Squidl::Utils::Color getBackgroundColor() const { return bgColor; }
         void setBackdrop(std::shared_ptr<Squidl::Elements::Backdrop> b) {
             backdrop = std::move(b);
+            invalidate();
+        }
+        void setBorderColor(Squidl::Utils::Color color) {
+            if (borderColor != color) {
+                borderColor = color;
+                invalidate();
+            }
         }
-        void setBorderColor(Squidl::Utils::Color color) { borderColor = color; }
         Squidl::Utils::Color getBorderColor() const { return borderColor; }
-        void setBorderless(bool value) { borderless = value; }
+        void setBorderless(bool value) {
+            if (borderless != value) {
+                borderless = value;
+                invalidate();
+            }
+        }
         bool isBorderless() { return borderless; }
 
         void setOpacity(float value) {
-            opacity = std::clamp(value, 0.0f, 1.0f);
+            value = std::clamp(value, 0.0f, 1.0f);
+            if (opacity != value) {
+                opacity = value;
+                invalidate();
+            }
         }
         float getOpacity() const { return opacity; }
         void setBorderOpacity(float value) {
-            borderOpacity = std::clamp(value, 0.0f, 1.0f);
+            value = std::clamp(value, 0.0f, 1.0f);
+            if (borderOpacity != value) {
+                borderOpacity = value;
+                invalidate();
+            }
         }
         float getBorderOpacity() const { return borderOpacity; }
 
@@ -144,6 +209,97 @@ namespace Squidl::Base {
             // элементом, оно может быть передано дальше.
         }
 
+        /**
+         * @brief Типы событий, которые элемент хочет получать.
+         * Читается при регистрации в EventDispatcher: элемент попадает только
+         * в корзины указанных типов. По умолчанию - все события.
+         */
+        virtual Squidl::Core::EventMask getEventMask() const {
+            return Squidl::Core::EventMask::All;
+        }
+
+        /**
+         * @brief Может ли элемент получать фокус ввода. Клавиатурные и
+         * текстовые события доставляются только элементу в фокусе.
+         */
+        virtual bool isFocusable() const { return false; }
+
+        /**
+         * @brief Вызывается EventDispatcher при получении или потере фокуса.
+         */
+        virtual void onFocusChanged(bool focused) {}
+
+        /**
+         * @brief Обрезает ли элемент своих детей по своему прямоугольнику
+         * (ScrollView). Такие элементы также ограничивают попадание мыши в
+         * детей.
+         */
+        virtual bool clipsChildren() const { return false; }
+
+        /**
+         * @brief Не скрыта ли точка обрезкой предков (clipsChildren()).
+         * EventDispatcher не доставляет события мыши элементам, часть
+         * которых под курсором обрезана.
+         */
+        bool isPointVisible(int x, int y) const;
+
+        // ---------------- Invalidation ------------------
+        /**
+         * @brief Marks the whole element as needing a repaint.
+         */
+        void invalidate() { invalidateRect(rect); }
+
+        /**
+         * @brief Marks an area as needing a repaint.
+         * The request bubbles up through getParent(); the root element
+         * accumulates the union of all damaged areas until takeDamage() is
+         * called by whoever renders the tree.
+         * @param area The damaged area in window coordinates.
+         */
+        virtual void invalidateRect(const Squidl::Utils::UIRect &area);
+
+        /**
+         * @brief Checks whether damage has accumulated on this (root) element.
+         */
+        bool hasDamage() const { return !damage.isEmpty(); }
+
+        /**
+         * @brief Returns the accumulated damage and clears it.
+         */
+        Squidl::Utils::UIRect takeDamage();
+
+        // ---------------- Cached layer ------------------
+        /**
+         * @brief Caches the element and its subtree in an offscreen layer.
+         * The subtree is rendered into a texture once and then composited
+         * with a single drawTexture() until something inside it is
+         * invalidated. Meant for complex but static panels: while the layer
+         * is valid, update() of the subtree does not run, so animated
+         * content (e.g. a blinking cursor) should stay outside, and content
+         * overflowing the element's rect is cut off.
+         * @note The layer texture belongs to the SDL_Renderer; disable the
+         * layer before destroying it.
+         */
+        void setCachedLayer(bool value);
+        bool isCachedLayer() const { return cachedLayer; }
+
+        // ---------------- Pointer capture ------------------
+        /**
+         * @brief While capturing, the element receives every pointer event
+         * regardless of the cursor position, e.g. a pressed button has to see
+         * the release outside of its rect.
+         */
+        void setPointerCapture(bool value);
+        bool hasPointerCapture() const { return pointerCapture; }
+
+        /**
+         * @brief Counters bumped whenever any element changes its rect or
+         * pointer capture. Hit-test structures compare them to find out
+         * whether they have to be rebuilt.
+         */
+        static std::uint32_t getGeometryGeneration();
+        static std::uint32_t getCaptureGeneration();
+
         // ---------------- Paddings ------------------
         Squidl::Core::Padding padding = 5;
         Squidl::Core::Padding margin = 0;
@@ -155,6 +311,19 @@ namespace Squidl::Base {
         virtual void updateBackdrop(Squidl::Core::UIContext &ctx,
                                     Squidl::Core::IRenderer &renderer) = 0;
 
+        // Invalidates both the old and the current rect if they differ
+        void rectChanged(const Squidl::Utils::UIRect &oldRect);
+
+        // Union of damaged areas; only accumulates on elements without parent
+        Squidl::Utils::UIRect damage;
+
+        // Measure cache: desiredSize is valid while measureValid is set.
+        // layoutValid tells layouts that their children did not change since
+        // the last arrange, so an unchanged rect needs no work.
+        Squidl::Utils::Size desiredSize;
+        bool measureValid = false;
+        bool layoutValid = false;
+
         std::weak_ptr<UIElement> parent;
 
         Squidl::Utils::UIRect rect;
@@ -171,7 +340,16 @@ namespace Squidl::Base {
         float opacity = 1.0f;
         float borderOpacity = 1.0f;
         bool borderless = false;
-
+        bool pointerCapture = false;
+
+        // Cached layer; layerValid is cleared by any invalidation inside the
+        // subtree except the ones raised while the layer is being redrawn
+        bool cachedLayer = false;
+        bool layerValid = false;
+        bool layerDrawing = false;
+        bool layerResult = false; // update() result of the last redraw
+        SDL_Texture *layerTexture = nullptr;
+        Squidl::Utils::Size layerSize;
 
 
         // -----Parent/Childs Controlable -------------
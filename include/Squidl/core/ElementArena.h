@@ -0,0 +1,158 @@
+// include/Squidl/core/ElementArena.h
+#pragma once
+
+#include "Squidl/SquidlConfig.h" // For SQUIDL_API
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace Squidl::Core {
+
+    /**
+     * @brief Пул памяти для элементов UI.
+     * @ingroup Core
+     * Выделяет память крупными блоками и раздаёт её элементам (вместе с
+     * управляющим блоком shared_ptr) через std::allocate_shared, поэтому
+     * элементы одного экрана лежат в памяти рядом, а построение и снос
+     * экрана не обращаются к общей куче на каждый элемент. Освобождённые
+     * участки возвращаются в списки по классам размера и переиспользуются
+     * следующим экраном. Блоки возвращаются системе, когда уничтожен
+     * последний элемент и последняя ссылка на пул (каждый элемент держит
+     * пул живым через свой аллокатор).
+     *
+     * Пул не потокобезопасен: элементы создаются и уничтожаются в потоке UI.
+     */
+    class SQUIDL_API ElementArena
+        : public std::enable_shared_from_this<ElementArena> {
+      public:
+        static constexpr std::size_t DefaultBlockSize = 64 * 1024;
+
+        static std::shared_ptr<ElementArena>
+        create(std::size_t blockSize = DefaultBlockSize);
+
+        ~ElementArena();
+
+        ElementArena(const ElementArena &) = delete;
+        ElementArena &operator=(const ElementArena &) = delete;
+
+        void *allocate(std::size_t size, std::size_t alignment);
+        void deallocate(void *p, std::size_t size,
+                        std::size_t alignment) noexcept;
+
+        /**
+         * @brief Создаёт элемент в пуле.
+         */
+        template <typename T, typename... Args>
+        std::shared_ptr<T> make(Args &&...args);
+
+        // Статистика
+        std::size_t getBlockCount() const { return m_blocks.size(); }
+        std::size_t getBytesReserved() const { return m_bytesReserved; }
+        std::size_t getBytesInUse() const { return m_bytesInUse; }
+        std::size_t getAllocationCount() const { return m_allocations; }
+
+        /**
+         * @brief Делает пул текущим для makeElement() в этом потоке на
+         * время жизни объекта (вложенные области восстанавливают прежний
+         * пул). Через текущий пул составные элементы (Button, Input)
+         * размещают и свои внутренние элементы.
+         */
+        class SQUIDL_API Scope {
+          public:
+            explicit Scope(ElementArena &arena);
+            ~Scope();
+            Scope(const Scope &) = delete;
+            Scope &operator=(const Scope &) = delete;
+
+          private:
+            ElementArena *m_previous;
+        };
+
+        // Текущий пул потока или nullptr
+        static ElementArena *current();
+
+      private:
+        explicit ElementArena(std::size_t blockSize);
+
+        // Участки до MaxPooledSize байт раздаются из блоков по классам с
+        // шагом Granularity; крупнее и с большим выравниванием - из кучи
+        static constexpr std::size_t Granularity = 16;
+        static constexpr std::size_t MaxPooledSize = 2048;
+        static constexpr std::size_t ClassCount = MaxPooledSize / Granularity;
+
+        struct FreeNode {
+            FreeNode *next;
+        };
+
+        static bool isPooled(std::size_t size, std::size_t alignment) {
+            return size <= MaxPooledSize && alignment <= Granularity;
+        }
+
+        std::size_t m_blockSize;
+        std::vector<std::unique_ptr<unsigned char[]>> m_blocks;
+        unsigned char *m_cursor = nullptr; // Свободное место в текущем блоке
+        std::size_t m_remaining = 0;
+        FreeNode *m_freeLists[ClassCount] = {};
+        std::size_t m_bytesReserved = 0;
+        std::size_t m_bytesInUse = 0;
+        std::size_t m_allocations = 0;
+    };
+
+    /**
+     * @brief Аллокатор для std::allocate_shared поверх ElementArena.
+     * @ingroup Core
+     */
+    template <typename T> class ArenaAllocator {
+      public:
+        using value_type = T;
+
+        explicit ArenaAllocator(std::shared_ptr<ElementArena> arena) noexcept
+            : m_arena(std::move(arena)) {}
+        template <typename U>
+        ArenaAllocator(const ArenaAllocator<U> &other) noexcept
+            : m_arena(other.getArena()) {}
+
+        T *allocate(std::size_t n) {
+            return static_cast<T *>(
+                m_arena->allocate(n * sizeof(T), alignof(T)));
+        }
+        void deallocate(T *p, std::size_t n) noexcept {
+            m_arena->deallocate(p, n * sizeof(T), alignof(T));
+        }
+
+        const std::shared_ptr<ElementArena> &getArena() const noexcept {
+            return m_arena;
+        }
+
+        template <typename U>
+        bool operator==(const ArenaAllocator<U> &other) const noexcept {
+            return m_arena == other.getArena();
+        }
+        template <typename U>
+        bool operator!=(const ArenaAllocator<U> &other) const noexcept {
+            return m_arena != other.getArena();
+        }
+
+      private:
+        std::shared_ptr<ElementArena> m_arena;
+    };
+
+    template <typename T, typename... Args>
+    std::shared_ptr<T> ElementArena::make(Args &&...args) {
+        return std::allocate_shared<T>(ArenaAllocator<T>(shared_from_this()),
+                                       std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Создаёт элемент в текущем пуле потока (ElementArena::Scope),
+     * а без него - обычным std::make_shared.
+     */
+    template <typename T, typename... Args>
+    std::shared_ptr<T> makeElement(Args &&...args) {
+        if (ElementArena *arena = ElementArena::current())
+            return arena->make<T>(std::forward<Args>(args)...);
+        return std::make_shared<T>(std::forward<Args>(args)...);
+    }
+
+} // namespace Squidl::Core
@@ -0,0 +1,175 @@
+// include/Squidl/core/ElementStore.h
+#pragma once
+
+#include "Squidl/SquidlConfig.h" // For SQUIDL_API
+#include "Squidl/utils/Color.h"  // For Squidl::Utils::Color
+#include "Squidl/utils/Point.h"  // For Squidl::Utils::Point
+#include "Squidl/utils/Size.h"   // For Squidl::Utils::Size
+#include "Squidl/utils/UIRect.h" // For Squidl::Utils::UIRect
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace Squidl::Core {
+
+    using ElementId = std::uint32_t;
+    constexpr ElementId InvalidElementId =
+        std::numeric_limits<ElementId>::max();
+
+    /**
+     * @brief Флаги плоского элемента.
+     */
+    enum class FlatFlags : std::uint8_t {
+        None = 0,
+        Visible = 1 << 0, // Собственная видимость
+        Border = 1 << 1,  // Рисовать рамку
+        Shown = 1 << 2,   // Видим с учётом предков (вычисляется)
+        Dirty = 1 << 3,   // Изменён с последнего updateLayout()
+    };
+
+    constexpr FlatFlags operator|(FlatFlags a, FlatFlags b) {
+        return static_cast<FlatFlags>(static_cast<std::uint8_t>(a) |
+                                      static_cast<std::uint8_t>(b));
+    }
+    constexpr bool hasFlag(std::uint8_t flags, FlatFlags f) {
+        return (flags & static_cast<std::uint8_t>(f)) != 0;
+    }
+
+    /**
+     * @brief Плоское хранилище элементов в виде структуры массивов.
+     * @ingroup Core
+     * Альтернатива дереву UIElement для больших однотипных сеток (тысячи
+     * ячеек панели датчиков): прямоугольники, цвета, прозрачность, флаги и
+     * индексы родителей лежат в отдельных непрерывных массивах и
+     * индексируются ElementId. Родитель всегда добавляется раньше детей,
+     * поэтому проход раскладки (updateLayout) и отрисовки - один линейный
+     * проход по массивам без виртуальных вызовов и разыменования
+     * shared_ptr.
+     *
+     * Прямоугольники задаются относительно родителя (корни - относительно
+     * origin в updateLayout). Видимость и прозрачность наследуются.
+     * Изменения копятся в области повреждения (takeDamage), которую
+     * FlatView передаёт в UIElement::invalidateRect.
+     */
+    class SQUIDL_API ElementStore {
+      public:
+        /**
+         * @brief Добавляет элемент.
+         * @param parent Родитель (уже добавленный) или InvalidElementId.
+         * @param localRect Прямоугольник относительно родителя.
+         * @return Идентификатор нового элемента или InvalidElementId, если
+         * родитель не существует.
+         */
+        ElementId add(ElementId parent, const Squidl::Utils::UIRect &localRect);
+
+        void reserve(std::size_t count);
+        void clear();
+        std::size_t size() const { return m_parents.size(); }
+        bool contains(ElementId id) const { return id < m_parents.size(); }
+
+        // Сеттеры помечают элемент изменённым
+        void setLocalRect(ElementId id, const Squidl::Utils::UIRect &rect);
+        void setBackgroundColor(ElementId id, Squidl::Utils::Color color);
+        void setBorderColor(ElementId id, Squidl::Utils::Color color);
+        void setTextColor(ElementId id, Squidl::Utils::Color color);
+        void setOpacity(ElementId id, float opacity);
+        void setVisible(ElementId id, bool visible);
+        void setBorder(ElementId id, bool border);
+        void setText(ElementId id, std::string text);
+
+        /**
+         * @brief Раскладывает подряд идущие элементы сеткой.
+         * @param first Первый элемент диапазона.
+         * @param count Количество элементов.
+         * @param columns Количество колонок.
+         * @param cell Размер ячейки.
+         * @param spacing Промежуток между ячейками.
+         * @param offset Положение первой ячейки относительно родителя.
+         */
+        void arrangeGrid(ElementId first, std::size_t count, int columns,
+                         Squidl::Utils::Size cell, int spacing,
+                         Squidl::Utils::Point offset = {0, 0});
+
+        /**
+         * @brief Вычисляет мировые прямоугольники, видимость и итоговую
+         * прозрачность одним проходом от корней к листьям.
+         * Ничего не делает, если с прошлого вызова ничего не менялось и
+         * origin тот же.
+         * @param origin Точка отсчёта для корневых элементов.
+         */
+        void updateLayout(Squidl::Utils::Point origin);
+        bool isLayoutDirty() const { return m_layoutDirty; }
+
+        /**
+         * @brief Элемент, видимый в точке (x, y), с учётом порядка
+         * отрисовки (последний нарисованный - сверху).
+         * @return ElementId или InvalidElementId.
+         */
+        ElementId hitTest(int x, int y) const;
+
+        /**
+         * @brief Возвращает накопленную область повреждения и очищает её.
+         */
+        Squidl::Utils::UIRect takeDamage();
+
+        /**
+         * @brief Объединение мировых прямоугольников видимых элементов.
+         */
+        Squidl::Utils::UIRect getBounds() const;
+
+        // Прямой доступ к массивам для проходов отрисовки
+        const std::vector<ElementId> &getParents() const { return m_parents; }
+        const std::vector<Squidl::Utils::UIRect> &getLocalRects() const {
+            return m_localRects;
+        }
+        const std::vector<Squidl::Utils::UIRect> &getWorldRects() const {
+            return m_worldRects;
+        }
+        const std::vector<Squidl::Utils::Color> &getBackgroundColors() const {
+            return m_bgColors;
+        }
+        const std::vector<Squidl::Utils::Color> &getBorderColors() const {
+            return m_borderColors;
+        }
+        const std::vector<Squidl::Utils::Color> &getTextColors() const {
+            return m_textColors;
+        }
+        // Итоговая прозрачность (собственная, умноженная на родительскую)
+        const std::vector<float> &getEffectiveOpacities() const {
+            return m_effectiveOpacity;
+        }
+        const std::vector<std::uint8_t> &getFlags() const { return m_flags; }
+        const std::vector<std::string> &getTexts() const { return m_texts; }
+
+        // Размеры текста заполняет владелец шрифта (FlatView); w < 0 -
+        // текст ещё не измерен
+        std::vector<Squidl::Utils::Size> &getTextSizes() { return m_textSizes; }
+
+        float getOpacity(ElementId id) const { return m_opacity[id]; }
+        bool isShown(ElementId id) const {
+            return hasFlag(m_flags[id], FlatFlags::Shown);
+        }
+
+      private:
+        void markDirty(ElementId id);
+
+        std::vector<ElementId> m_parents;
+        std::vector<Squidl::Utils::UIRect> m_localRects;
+        std::vector<Squidl::Utils::UIRect> m_worldRects;
+        std::vector<Squidl::Utils::Color> m_bgColors;
+        std::vector<Squidl::Utils::Color> m_borderColors;
+        std::vector<Squidl::Utils::Color> m_textColors;
+        std::vector<float> m_opacity;
+        std::vector<float> m_effectiveOpacity;
+        std::vector<std::uint8_t> m_flags;
+        std::vector<std::string> m_texts;
+        std::vector<Squidl::Utils::Size> m_textSizes;
+
+        Squidl::Utils::Point m_origin = {0, 0};
+        Squidl::Utils::UIRect m_damage;
+        bool m_layoutDirty = false;
+    };
+
+} // namespace Squidl::Core
@@ -4,9 +4,12 @@
 #include "Squidl/SquidlConfig.h"   // For SQUIDL_API
 #include "Squidl/base/UIElement.h" // For UIElement (forward declaration)
 #include "Squidl/core/UIEvent.h"   // For UIEvent and derived types
+#include "Squidl/utils/UIRect.h"   // For Squidl::Utils::UIRect
+#include <cstdint>                 // For std::uint32_t
 #include <functional>              // For std::function
 #include <map>                     // For std::map
 #include <memory>                  // For std::weak_ptr, std::shared_ptr
+#include <unordered_map>           // For registered listeners
 #include <vector>
 
 namespace Squidl::Base {
@@ -19,18 +22,32 @@ namespace Squidl::Core {
      * @brief Диспетчер событий UI.
      * @ingroup Core
      * Отвечает за рассылку событий зарегистрированным слушателям.
+     *
+     * Слушатели раскладываются по корзинам типов событий согласно
+     * UIElement::getEventMask(), и событие перебирает только свою корзину.
+     * Клавиатурные и текстовые события доставляются только элементу в фокусе
+     * (если он есть).
+     *
+     * События мыши доставляются не всем слушателям, а только элементам под
+     * курсором, найденным через равномерную сетку по getRect(). Кроме них
+     * событие получают элементы с захватом указателя и элементы, бывшие под
+     * курсором в прошлый раз (чтобы они увидели уход мыши). Сетка
+     * перестраивается лениво, когда меняется геометрия элементов. Элемент
+     * не считается находящимся под курсором, если точка обрезана предком
+     * (UIElement::clipsChildren(), например ScrollView).
      */
     class SQUIDL_API EventDispatcher {
       public:
         EventDispatcher();
 
         /**
-         * @brief Добавляет UIElement в качестве слушателя для всех событий.
+         * @brief Добавляет UIElement в качестве слушателя событий из его
+         * getEventMask().
          * @param element Указатель на UIElement, который будет получать
          * события.
          * @note Элемент должен быть жив, пока он зарегистрирован. Используется
          * weak_ptr для предотвращения циклических зависимостей и обработки
-         * удаленных элементов.
+         * удаленных элементов. Маска читается один раз при добавлении.
          */
         void addListener(std::shared_ptr<Squidl::Base::UIElement> element);
 
@@ -41,19 +58,101 @@ namespace Squidl::Core {
         void removeListener(std::shared_ptr<Squidl::Base::UIElement> element);
 
         /**
-         * @brief Рассылает событие всем зарегистрированным слушателям.
+         * @brief Рассылает событие зарегистрированным слушателям его типа.
          * @param event Событие для рассылки.
          */
         void dispatchEvent(UIEvent &event); // Принимаем по ссылке, чтобы
                                             // handled мог быть изменен
 
+        /**
+         * @brief Передает фокус ввода элементу.
+         * Фокус также переходит к верхнему фокусируемому элементу под
+         * курсором при нажатии кнопки мыши.
+         * @param element Новый элемент в фокусе или nullptr для снятия фокуса.
+         */
+        void setFocus(std::shared_ptr<Squidl::Base::UIElement> element);
+        void clearFocus() { setFocus(nullptr); }
+        std::shared_ptr<Squidl::Base::UIElement> getFocus() const {
+            return focus.lock();
+        }
+
+        /**
+         * @brief Количество элементов, получивших последнее событие мыши.
+         */
+        std::size_t getLastMouseTargetCount() const {
+            return lastMouseTargets;
+        }
+
       private:
-        // Используем vector для простоты, можно оптимизировать с map<EventType,
-        // vector<...>> если элементов и типов событий будет очень много.
-        std::vector<std::weak_ptr<Squidl::Base::UIElement>> listeners;
+        struct Bucket {
+            std::vector<std::weak_ptr<Squidl::Base::UIElement>> elements;
+            bool hasExpired = false; // Найдены "мертвые" weak_ptr
+        };
+
+        // Корзины слушателей по типу события
+        std::map<EventType, Bucket> buckets;
+        // Зарегистрированные элементы, для быстрой проверки повторов
+        std::unordered_map<const Squidl::Base::UIElement *,
+                           std::weak_ptr<Squidl::Base::UIElement>>
+            registered;
+        std::weak_ptr<Squidl::Base::UIElement> focus;
+
+        // Рассылка по корзине в обратном порядке добавления
+        void dispatchToBucket(UIEvent &event, Bucket &bucket);
+        // Доставка зафиксированным получателям до обработки события;
+        // возвращает число получивших его элементов
+        std::size_t
+        deliver(UIEvent &event,
+                const std::vector<std::shared_ptr<Squidl::Base::UIElement>>
+                    &receivers);
+        std::vector<std::shared_ptr<Squidl::Base::UIElement>>
+        takeDeliveryBuffer();
+        void returnDeliveryBuffer(
+            std::vector<std::shared_ptr<Squidl::Base::UIElement>> buffer);
+
+        // Вспомогательная функция для очистки "мертвых" weak_ptr корзины
+        void cleanupBucket(EventType type, Bucket &bucket);
+
+        // ---------------- Пространственный индекс ------------------
+        void dispatchMouseEvent(MouseEvent &event);
+        void updateFocusOnPress();
+        void rebuildHitGrid();
+        void rebuildCaptured();
+        void collectHits(int x, int y, std::vector<std::uint32_t> &out);
+        void mouseListenersChanged() {
+            gridDirty = capturedDirty = hoveredStale = true;
+        }
+
+        // Крупные элементы не раскладываются по ячейкам, а проверяются
+        // напрямую
+        static constexpr int MaxCellsPerElement = 64;
+        static constexpr int MaxGridCells = 16384;
+
+        // Индексы в корзине событий мыши
+        std::vector<std::vector<std::uint32_t>> gridCells;
+        std::vector<std::uint32_t> largeElements;
+        Squidl::Utils::UIRect gridBounds;
+        int cellSize = 64;
+        int gridCols = 0;
+        int gridRows = 0;
+        bool gridDirty = true;
+        std::uint32_t gridGeneration = 0;
+
+        std::vector<std::uint32_t> captured;
+        bool capturedDirty = true;
+        std::uint32_t capturedGeneration = 0;
+
+        // Элементы, бывшие под курсором при прошлом событии мыши. Индексы
+        // пересчитываются по weak_ptr, если список слушателей изменился
+        std::vector<std::weak_ptr<Squidl::Base::UIElement>> hovered;
+        std::vector<std::uint32_t> hoveredIndices;
+        bool hoveredStale = false;
+        std::size_t lastMouseTargets = 0;
 
-        // Вспомогательная функция для очистки "мертвых" weak_ptr
-        void cleanupListeners();
+        // Буферы, переиспользуемые между событиями
+        std::vector<std::uint32_t> hits;
+        std::vector<std::uint32_t> targets;
+        std::vector<std::shared_ptr<Squidl::Base::UIElement>> deliveryBuffer;
     };
 
 } // namespace Squidl::Core
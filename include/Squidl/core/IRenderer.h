@@ -122,18 +122,86 @@ namespace Squidl::Core {
 
         /**
          * @brief Sets the clipping rectangle for all subsequent drawing
-         * operations. Drawing will only occur within this rectangle.
+         * operations. Drawing will only occur within this rectangle and
+         * within the innermost rectangle pushed with pushClipRect().
          *
          * @param rect The UIRect to set as the clipping area.
          */
         virtual void setClipRect(const Squidl::Utils::UIRect &rect) = 0;
 
         /**
-         * @brief Resets the clipping rectangle, allowing drawing to the entire
-         * target.
+         * @brief Resets the clipping rectangle to the innermost pushed one,
+         * or to the entire target if none is pushed.
          */
         virtual void resetClipRect() = 0;
 
+        /**
+         * @brief Pushes a clipping rectangle, intersected with the current
+         * innermost one. Containers use it so that the clip of their
+         * children nests inside their own.
+         *
+         * @param rect The UIRect to clip to until the matching popClipRect().
+         */
+        virtual void pushClipRect(const Squidl::Utils::UIRect &rect) = 0;
+
+        /**
+         * @brief Restores the clipping rectangle active before the matching
+         * pushClipRect().
+         */
+        virtual void popClipRect() = 0;
+
+        /**
+         * @brief Checks whether anything drawn inside a rectangle can be
+         * visible through the current clipping. Elements call it to skip
+         * drawing entirely when they are culled.
+         *
+         * @param rect The area the caller is about to draw into.
+         * @return false if drawing into rect would have no effect.
+         */
+        virtual bool isRectVisible(const Squidl::Utils::UIRect &rect) const = 0;
+
+        /**
+         * @brief Creates a texture that can be used as a layer with
+         * beginLayer(). Layers hold premultiplied alpha and are set up to be
+         * composited with drawTexture().
+         *
+         * @param w Width of the layer in pixels.
+         * @param h Height of the layer in pixels.
+         * @return The texture, owned by the caller
+         * (Squidl::Renderers::QuadBatch::destroyTexture), or nullptr if
+         * layers are not supported.
+         */
+        virtual SDL_Texture *createLayerTexture(int w, int h) = 0;
+
+        /**
+         * @brief Redirects all drawing into a layer texture until the
+         * matching endLayer(). The layer is cleared to transparent first.
+         * Drawing keeps using window coordinates: the texture covers area,
+         * and clipping starts over with area as the only clip rect.
+         *
+         * @param texture A texture from createLayerTexture(), at least as
+         * large as area.
+         * @param area The part of the window the layer stands for.
+         * @return false if the layer could not be bound; drawing then still
+         * goes to the current target and endLayer() must not be called.
+         */
+        virtual bool beginLayer(SDL_Texture *texture,
+                                const Squidl::Utils::UIRect &area) = 0;
+
+        /**
+         * @brief Restores the target and clipping active before the matching
+         * beginLayer().
+         */
+        virtual void endLayer() = 0;
+
+        /**
+         * @brief Submits drawing the renderer has batched so far. Called
+         * before presenting or reading the target (e.g. copying a canvas);
+         * changes of target and clipping done through IRenderer flush
+         * automatically.
+         */
+        virtual void flush() = 0;
+
         // Potentially more drawing primitives
         // virtual void drawLine(Squidl::Utils::Point p1, Squidl::Utils::Point
         // p2, Squidl::Utils::Color color) = 0; virtual void
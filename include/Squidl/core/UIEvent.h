@@ -3,8 +3,9 @@
 
 #include "Squidl/SquidlConfig.h" // For SQUIDL_API
 #include "Squidl/utils/Point.h"  // For Squidl::Utils::Point
-#include <SDL.h>  // For SDL_Scancode, SDL_Keymod, SDL_BUTTON_LEFT etc.
-#include <string> // For std::string
+#include <SDL.h>    // For SDL_Scancode, SDL_Keymod, SDL_BUTTON_LEFT etc.
+#include <cstdint>  // For std::uint8_t
+#include <string>   // For std::string
 
 namespace Squidl::Core {
 
@@ -22,6 +23,51 @@ namespace Squidl::Core {
         // FocusEvent)
     };
 
+    /**
+     * @brief Набор типов событий, на которые подписан элемент.
+     * @ingroup Core
+     */
+    enum class EventMask : std::uint8_t {
+        None = 0,
+        Mouse = 1 << 0,
+        Keyboard = 1 << 1,
+        TextInput = 1 << 2,
+        Resize = 1 << 3,
+        All = Mouse | Keyboard | TextInput | Resize,
+    };
+
+    inline EventMask operator|(EventMask a, EventMask b) {
+        return static_cast<EventMask>(static_cast<std::uint8_t>(a) |
+                                      static_cast<std::uint8_t>(b));
+    }
+
+    inline EventMask operator&(EventMask a, EventMask b) {
+        return static_cast<EventMask>(static_cast<std::uint8_t>(a) &
+                                      static_cast<std::uint8_t>(b));
+    }
+
+    inline bool hasFlag(EventMask value, EventMask flag) {
+        return static_cast<std::uint8_t>(value & flag) != 0;
+    }
+
+    /**
+     * @brief Возвращает флаг маски, соответствующий типу события.
+     */
+    inline EventMask toEventMask(EventType type) {
+        switch (type) {
+        case EventType::MouseEvent:
+            return EventMask::Mouse;
+        case EventType::KeyboardEvent:
+            return EventMask::Keyboard;
+        case EventType::TextInputEvent:
+            return EventMask::TextInput;
+        case EventType::ResizeEvent:
+            return EventMask::Resize;
+        default:
+            return EventMask::None;
+        }
+    }
+
     /**
      * @brief Базовая структура для всех событий UI.
      * @ingroup Core
@@ -3,12 +3,18 @@
 
 #include "Squidl/SquidlConfig.h"   // For SQUIDL_API
 #include "Squidl/base/UIElement.h" // For std::shared_ptr<UIElement>
+#include "Squidl/core/ElementArena.h"
 #include "Squidl/core/EventDispatcher.h"
 #include "Squidl/core/IRenderer.h"
 #include "Squidl/core/UIContext.h"
+#include "Squidl/renderers/RecordingRenderer.h"
 #include <SDL.h>  // For SDL_Event, SDL_Renderer
 #include <memory> // For std::unique_ptr, std::shared_ptr
 
+namespace Squidl::Renderers {
+    class SDL2Renderer;
+}
+
 namespace Squidl::Core {
 
     /**
@@ -39,8 +45,33 @@ namespace Squidl::Core {
 
         /**
          * @brief Обновляет состояние UI и отрисовывает его.
+         * @return true, если кадр был отрисован и его нужно показать
+         * (SDL_RenderPresent); false, если в режиме удержания кадр совпал с
+         * предыдущим и показ можно пропустить.
+         */
+        bool updateAndRender();
+
+        /**
+         * @brief Включает режим удержания кадра (retained mode).
+         * Кадр сначала записывается в буфер команд и сравнивается с
+         * предыдущим; неизменённые кадры не отрисовываются.
+         * @param enabled true для включения режима.
          */
-        void updateAndRender();
+        void setRetainedMode(bool enabled);
+        bool isRetainedMode() const { return m_retainedMode; }
+
+        /**
+         * @brief Включает режим перерисовки только повреждённых областей.
+         * UI рисуется в постоянную текстуру-холст; каждый кадр
+         * перерисовывается лишь объединение областей, переданных элементами
+         * через UIElement::invalidateRect(), после чего холст копируется в
+         * задний буфер. Совместим с режимом удержания кадра.
+         * @note Холст освобождается в деструкторе UIManager, поэтому
+         * UIManager должен быть уничтожен до SDL_Renderer.
+         * @param enabled true для включения режима.
+         */
+        void setDirtyRectMode(bool enabled);
+        bool isDirtyRectMode() const { return m_dirtyRectMode; }
 
         /**
          * @brief Добавляет элемент UI в список слушателей событий.
@@ -54,6 +85,16 @@ namespace Squidl::Core {
          */
         void removeUIElement(std::shared_ptr<Squidl::Base::UIElement> element);
 
+        /**
+         * @brief Пул памяти для элементов этого UI.
+         * Элементы, созданные через getElementArena()->make<T>() или
+         * makeElement<T>() внутри ElementArena::Scope, размещаются в нём
+         * вместе с внутренними элементами составных виджетов.
+         */
+        const std::shared_ptr<ElementArena> &getElementArena() const {
+            return m_elementArena;
+        }
+
         // Getters
         UIContext &getUIContext() { return m_context; }
         EventDispatcher &getEventDispatcher() { return m_eventDispatcher; }
@@ -62,10 +103,25 @@ namespace Squidl::Core {
         } // For texture loading in Backdrop etc.
 
       private:
+        // Пересоздаёт холст при изменении размера вывода
+        bool ensureCanvas();
+        void releaseCanvas();
+
         UIContext m_context;
         EventDispatcher m_eventDispatcher;
+        std::shared_ptr<ElementArena> m_elementArena = ElementArena::create();
         std::shared_ptr<Squidl::Base::UIElement> m_rootElement;
         std::unique_ptr<IRenderer> m_uiRenderer; // Наш абстрактный рендерер
+        // Записывает кадры поверх m_uiRenderer в режиме удержания
+        std::unique_ptr<Squidl::Renderers::RecordingRenderer> m_recorder;
+        bool m_retainedMode = false;
+        // Холст режима повреждённых областей
+        Squidl::Renderers::SDL2Renderer *m_sdl2Renderer = nullptr;
+        SDL_Texture *m_canvas = nullptr;
+        int m_canvasW = 0;
+        int m_canvasH = 0;
+        bool m_dirtyRectMode = false;
+        bool m_fullRepaint = true; // Содержимое холста потеряно
         SDL_Window *m_sdlWindow = nullptr;
         SDL_Renderer *m_sdlRenderer =
             nullptr; // Сырой указатель на рендерер SDL
@@ -5,8 +5,14 @@
 #include "Squidl/utils/Color.h"  // <--- Use Squidl::Utils::Color
 #include "Squidl/utils/UIRect.h" // <--- Use Squidl::Utils::UIRect
 #include <SDL.h>                 // For SDL_Texture (still used for now)
+#include <memory>                // For std::shared_ptr
 #include <string>                // For setTextureFromFile
 
+namespace Squidl::Managers {
+    class TextureManager;
+    class TextureResource;
+} // namespace Squidl::Managers
+
 namespace Squidl::Elements {
     class SQUIDL_API Backdrop : public Squidl::Base::UIElement {
       public:
@@ -14,19 +20,33 @@ namespace Squidl::Elements {
         ~Backdrop(); // Destructor to manage texture ownership
 
         void setTexture(SDL_Texture *tex, bool owns = false);
+        // Draws only srcRect of the texture, e.g. an AtlasRegion of a
+        // TextureAtlas (not owned)
+        void setTextureRegion(SDL_Texture *tex, const SDL_Rect &srcRect);
         void setTextureFromFile(
             SDL_Renderer *renderer,
             const std::string &path); // Still needs SDL_Renderer* for loading
+        // Loads the image in the background; the background color is drawn
+        // as a placeholder until the texture is ready
+        void setTextureFromFile(Squidl::Managers::TextureManager &textures,
+                                const std::string &path);
 
         // Update signature changed to IRenderer&
         bool update(Squidl::Core::UIContext &ctx,
                     Squidl::Core::IRenderer &renderer) override;
         void autosize() override;
+        Squidl::Core::EventMask getEventMask() const override {
+            return Squidl::Core::EventMask::None;
+        }
 
       private:
         SDL_Texture *texture = nullptr;
         bool ownsTexture =
             false; // Flag to indicate if this Backdrop owns the texture
+        SDL_Rect sourceRect{0, 0, 0, 0};
+        bool hasSourceRect = false;
+        // Texture loaded through a TextureManager, used instead of texture
+        std::shared_ptr<Squidl::Managers::TextureResource> managedTexture;
 
         // UpdateBackdrop signature changed to IRenderer&
         void updateBackdrop(Squidl::Core::UIContext &ctx,
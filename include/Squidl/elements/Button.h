@@ -19,26 +19,45 @@ namespace Squidl::Elements {
                     Squidl::Core::IRenderer &renderer) override;
 
         // State colors
-        void setHoveredColor(Squidl::Utils::Color color) { hoverColor = color; }
+        void setHoveredColor(Squidl::Utils::Color color) {
+            hoverColor = color;
+            invalidate();
+        }
         void setPressedColor(Squidl::Utils::Color color) {
             pressedColor = color;
+            invalidate();
         }
         void setDisabledColor(Squidl::Utils::Color color) {
             disabledColor = color;
+            invalidate();
         }
         void setSelectedColor(Squidl::Utils::Color color) {
             selectedColor = color;
+            invalidate();
         }
 
-        void setEnabled(bool value) { enabled = value; }
-        void setSelected(bool value) { selected = value; }
+        void setEnabled(bool value) {
+            if (enabled != value) {
+                enabled = value;
+                invalidate();
+            }
+        }
+        void setSelected(bool value) {
+            if (selected != value) {
+                selected = value;
+                invalidate();
+            }
+        }
 
         void setToggleMode(bool value) { toggleMode = value; }
         bool isSelected() const { return selected; }
 
         void autosize() override;
 
-        void setLabel(std::shared_ptr<Label> value) { label = value; }
+        void setLabel(std::shared_ptr<Label> value) {
+            label = value;
+            invalidate();
+        }
         std::shared_ptr<Label> getLabel() const { return label; }
         void setLabelText(const std::string &text);
         std::string getLabelText() const {
@@ -47,6 +66,9 @@ namespace Squidl::Elements {
 
         // Переопределение метода onEvent для обработки событий
         void onEvent(Squidl::Core::UIEvent &event) override;
+        Squidl::Core::EventMask getEventMask() const override {
+            return Squidl::Core::EventMask::Mouse;
+        }
 
         // Callback для обработки клика
         std::function<void()> onClick;
@@ -18,12 +18,20 @@ namespace Squidl::Elements {
         bool update(Squidl::Core::UIContext &ctx,
                     Squidl::Core::IRenderer &renderer) override;
         void onEvent(Squidl::Core::UIEvent &event) override;
+        Squidl::Core::EventMask getEventMask() const override {
+            return Squidl::Core::EventMask::Mouse;
+        }
         void autosize() override;
         void updateBackdrop(Squidl::Core::UIContext &ctx,
                             Squidl::Core::IRenderer &renderer) override;
 
         bool isChecked() const { return mIsChecked; }
-        void setChecked(bool checked) { mIsChecked = checked; }
+        void setChecked(bool checked) {
+            if (mIsChecked != checked) {
+                mIsChecked = checked;
+                invalidate();
+            }
+        }
         void setOnToggleCallback(std::function<void(bool)> callback) {
             mToggleCallback = callback;
         }
@@ -0,0 +1,82 @@
+// include/Squidl/elements/FlatView.h
+#pragma once
+#include <functional> // For std::function
+
+#include "Squidl/SquidlConfig.h"       // For SQUIDL_API
+#include "Squidl/base/UIElement.h"     // For Squidl::Base::UIElement
+#include "Squidl/core/ElementStore.h"  // For Squidl::Core::ElementStore
+#include "Squidl/core/IRenderer.h"     // For IRenderer
+#include "Squidl/utils/UIRect.h"       // For Squidl::Utils::UIRect
+
+namespace Squidl::Core {
+    class UIContext;
+}
+
+namespace Squidl::Elements {
+
+    /**
+     * @brief Hosts an ElementStore inside the regular element tree.
+     * @ingroup Elements
+     * The view is a single UIElement, so it costs one listener and one
+     * update() call no matter how many cells its store holds. Cells are
+     * laid out and drawn by linear sweeps over the store's arrays, culled
+     * against the view's rect. Root cells are positioned relative to the
+     * view's content area (rect minus padding).
+     *
+     * Modify cells through getStore() and call commit() afterwards, so the
+     * changed areas are invalidated before the next frame takes its damage.
+     */
+    class SQUIDL_API FlatView : public Squidl::Base::UIElement {
+      public:
+        FlatView(int x, int y, int w, int h, TTF_Font *font = nullptr);
+
+        Squidl::Core::ElementStore &getStore() { return m_store; }
+        const Squidl::Core::ElementStore &getStore() const { return m_store; }
+
+        /**
+         * @brief Recomputes cell layout after store changes and invalidates
+         * the areas that changed.
+         */
+        void commit();
+
+        void setRect(const Squidl::Utils::UIRect &newRect) override;
+        void setFont(TTF_Font *f) override;
+        void autosize() override;
+
+        bool update(Squidl::Core::UIContext &ctx,
+                    Squidl::Core::IRenderer &renderer) override;
+        void onEvent(Squidl::Core::UIEvent &event) override;
+        Squidl::Core::EventMask getEventMask() const override {
+            return Squidl::Core::EventMask::Mouse;
+        }
+
+        // Called with the topmost cell under a left click
+        void setOnCellClicked(std::function<void(Squidl::Core::ElementId)> cb) {
+            m_onCellClicked = std::move(cb);
+        }
+
+        // Horizontal inset of cell text
+        void setTextInset(int value) {
+            if (m_textInset != value) {
+                m_textInset = value;
+                invalidate();
+            }
+        }
+        int getTextInset() const { return m_textInset; }
+
+      protected:
+        void updateBackdrop(Squidl::Core::UIContext &ctx,
+                            Squidl::Core::IRenderer &renderer) override;
+
+      private:
+        Squidl::Utils::Point contentOrigin() const {
+            return {rect.x + padding.left, rect.y + padding.top};
+        }
+
+        Squidl::Core::ElementStore m_store;
+        Squidl::Utils::UIRect m_cellBounds; // Bounds seen by the last commit
+        std::function<void(Squidl::Core::ElementId)> m_onCellClicked;
+        int m_textInset = 4;
+    };
+
+} // namespace Squidl::Elements
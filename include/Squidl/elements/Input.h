@@ -28,6 +28,15 @@ namespace Squidl::Elements {
 
         // Переопределение метода onEvent для обработки событий
         void onEvent(Squidl::Core::UIEvent &event) override;
+        Squidl::Core::EventMask getEventMask() const override {
+            return Squidl::Core::EventMask::Mouse |
+                   Squidl::Core::EventMask::Keyboard |
+                   Squidl::Core::EventMask::TextInput;
+        }
+
+        // Фокусом управляет EventDispatcher (клик по полю или setFocus)
+        bool isFocusable() const override { return true; }
+        void onFocusChanged(bool focused) override;
 
         // Callback для изменения текста
         std::function<void(const std::string &)> onTextChange;
@@ -44,6 +53,9 @@ namespace Squidl::Elements {
         Uint32 cursorTimer = 0;  // Таймер для мигания курсора
         bool showCursor = false; // Флаг для отображения курсора
         int textOffsetX = 0; // Смещение текста для прокрутки внутри поля ввода
+        // Последняя отрисованная область курсора, чтобы мигание
+        // перерисовывало только её
+        Squidl::Utils::UIRect lastCursorRect;
 
         // Цвета для различных состояний
         Squidl::Utils::Color focusedBorderColor = {
@@ -62,5 +74,6 @@ namespace Squidl::Elements {
         void updateLabelTextAndColor(); // Обновить текст и цвет Label в
                                         // зависимости от состояния
         void adjustTextOffset();        // Корректировка смещения текста
+        void setFocused(bool value);    // Смена фокуса с перерисовкой
     };
 } // namespace Squidl::Elements
@@ -1,6 +1,7 @@
 #pragma once
 #include <SDL_ttf.h> // For TTF_Font
 #include <string>    // For std::string
+#include <vector>    // For cached text lines
 
 #include "Squidl/SquidlConfig.h"   // For SQUIDL_API and namespace declarations
 #include "Squidl/base/UIElement.h" // For Squidl::Base::UIElement
@@ -23,6 +24,10 @@ namespace Squidl::Elements {
         void setText(std::string t);
         std::string getText() const;
         void autosize() override;
+        // Метка не обрабатывает события
+        Squidl::Core::EventMask getEventMask() const override {
+            return Squidl::Core::EventMask::None;
+        }
         // UIContext now qualified by Squidl::Core namespace
         // Renderer now accepts IRenderer&
         bool update(Squidl::Core::UIContext &ctx,
@@ -32,10 +37,16 @@ namespace Squidl::Elements {
         // HorizontalAlign and VerticalAlign now qualified by Squidl::Core
         // namespace
         void setHorizontalAlignment(Squidl::Core::HorizontalAlign align) {
-            m_horizontalAlign = align;
+            if (m_horizontalAlign != align) {
+                m_horizontalAlign = align;
+                invalidate();
+            }
         }
         void setVerticalAlignment(Squidl::Core::VerticalAlign align) {
-            m_verticalAlign = align;
+            if (m_verticalAlign != align) {
+                m_verticalAlign = align;
+                invalidate();
+            }
         }
 
         // New padding methods
@@ -48,11 +59,21 @@ namespace Squidl::Elements {
         int getPaddingBottom() const { return paddingBottom; }
 
         // New methods for TextColor
-        void setTextColor(Squidl::Utils::Color color) { fgColor = color; }
+        void setTextColor(Squidl::Utils::Color color) {
+            if (fgColor != color) {
+                fgColor = color;
+                invalidate();
+            }
+        }
         Squidl::Utils::Color getTextColor() const { return fgColor; }
 
         // Новый метод для установки смещения текста для прокрутки/клиппирования
-        void setTextOffset(int offset) { m_textOffsetX = offset; }
+        void setTextOffset(int offset) {
+            if (m_textOffsetX != offset) {
+                m_textOffsetX = offset;
+                invalidate();
+            }
+        }
         int getTextOffset() const { return m_textOffsetX; }
 
       protected:
@@ -75,6 +96,22 @@ namespace Squidl::Elements {
         int paddingBottom = 5;
 
         int m_textOffsetX = 0; // Внутреннее смещение для отрисовки текста
+
+        // Кэш разбиения текста на строки и их ширин, чтобы не вызывать
+        // TTF_SizeUTF8 каждый кадр. Сбрасывается при смене текста или шрифта
+        struct TextLine {
+            std::string text;
+            int width = 0;
+        };
+        std::vector<TextLine> m_lines;
+        TTF_Font *m_linesFont = nullptr;
+        bool m_linesValid = false;
+        const std::vector<TextLine> &getLines();
+        // autosize задаёт размер только метке без явного размера
+        void invalidateAutosize() {
+            if (rect.w == 0 || rect.h == 0)
+                invalidateMeasure();
+        }
     };
 
 } // namespace Squidl::Elements
@@ -14,6 +14,9 @@ namespace Squidl::Elements {
         bool update(Squidl::Core::UIContext &ctx,
                     Squidl::Core::IRenderer &renderer) override;
         void onEvent(Squidl::Core::UIEvent &event) override;
+        Squidl::Core::EventMask getEventMask() const override {
+            return Squidl::Core::EventMask::Mouse;
+        }
         void updateBackdrop(Squidl::Core::UIContext &ctx,
                             Squidl::Core::IRenderer &renderer) override;
         void autosize() override;
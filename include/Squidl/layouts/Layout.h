@@ -7,6 +7,7 @@
 #include "Squidl/utils/UIRect.h" // Use Squidl::Utils::UIRect
 #include <SDL_ttf.h>
 #include <memory>
+#include <optional>
 #include <vector>
 
 namespace Squidl::Layouts {
@@ -30,6 +31,11 @@ namespace Squidl::Layouts {
 
         void setFont(TTF_Font *f) override;
 
+        // Layouts only arrange children and do not react to events
+        Squidl::Core::EventMask getEventMask() const override {
+            return Squidl::Core::EventMask::None;
+        }
+
         /**
          * @brief Возвращает список дочерних элементов.
          * @return Константная ссылка на вектор дочерних shared_ptr.
@@ -0,0 +1,120 @@
+#pragma once
+#include "Squidl/layouts/Layout.h"
+#include "Squidl/utils/Point.h" // For Squidl::Utils::Point
+#include "Squidl/utils/Size.h"  // For Squidl::Utils::Size
+#include <cstddef>
+#include <vector>
+
+namespace Squidl::Layouts {
+
+    /**
+     * @brief Scrollable viewport over a vertical stack of children.
+     * @ingroup Layouts
+     * Children are stacked like in a VBoxLayout at their measured height and
+     * shifted by the scroll offset. Drawing is clipped to the viewport (the
+     * rect minus padding) and only children intersecting it are updated or
+     * re-positioned when scrolling, so offscreen content costs nothing per
+     * frame. The view also clips mouse hit-testing of its children (see
+     * UIElement::clipsChildren()).
+     *
+     * The mouse wheel and dragging empty space scroll the view. With
+     * kinetic scrolling enabled, both keep gliding after the input stops and
+     * slow down by the friction factor.
+     */
+    class SQUIDL_API ScrollView : public Layout {
+      public:
+        explicit ScrollView(int spacing = 5, int padding = 0);
+
+        void setScrollOffset(Squidl::Utils::Point offset);
+        Squidl::Utils::Point getScrollOffset() const { return m_offset; }
+        void scrollBy(int dx, int dy) {
+            setScrollOffset({m_offset.x + dx, m_offset.y + dy});
+        }
+        Squidl::Utils::Point getMaxScrollOffset() const;
+        Squidl::Utils::Size getContentSize() const { return m_contentSize; }
+
+        /**
+         * @brief Scrolls just enough to bring a child into view.
+         */
+        void scrollToChild(const Squidl::Base::UIElement *child);
+
+        // Without horizontal scrolling children fit the viewport width
+        void setHorizontalScrollEnabled(bool value);
+        bool isHorizontalScrollEnabled() const { return m_horizontal; }
+
+        void setKineticScrolling(bool value);
+        bool isKineticScrolling() const { return m_kinetic; }
+        // Fraction of the velocity lost per second, 0..1
+        void setFriction(float value);
+        float getFriction() const { return m_friction; }
+        // Pixels per wheel notch
+        void setWheelStep(int value) { m_wheelStep = value; }
+        int getWheelStep() const { return m_wheelStep; }
+
+        void setScrollBarColor(Squidl::Utils::Color color) {
+            m_scrollBarColor = color;
+        }
+        bool isScrolling() const {
+            return m_dragging || m_velocity.x != 0.0f || m_velocity.y != 0.0f;
+        }
+
+        void setRect(const Squidl::Utils::UIRect &newRect) override;
+        bool update(Squidl::Core::UIContext &ctx,
+                    Squidl::Core::IRenderer &renderer) override;
+        void autosize() override;
+        void invalidateRect(const Squidl::Utils::UIRect &area) override;
+        void onEvent(Squidl::Core::UIEvent &event) override;
+        Squidl::Core::EventMask getEventMask() const override {
+            return Squidl::Core::EventMask::Mouse;
+        }
+        bool clipsChildren() const override { return true; }
+
+        Squidl::Utils::UIRect getViewport() const;
+
+      private:
+        struct Velocity {
+            float x = 0.0f;
+            float y = 0.0f;
+        };
+
+        // Computes child slots in content coordinates
+        void arrangeContent();
+        // Moves children into place; with all == false only the ones that
+        // are or were visible
+        void placeChildren(bool all);
+        void clampOffset();
+        void stopKinetic() { m_velocity = {}; }
+        void advanceKinetic();
+        // Damages a small area so update() runs again next frame
+        void requestKineticFrame();
+        void drawScrollBars(Squidl::Core::IRenderer &renderer) const;
+
+        Squidl::Utils::Point m_offset = {0, 0};
+        Squidl::Utils::Size m_contentSize;
+        // Child slots relative to the content origin, sorted by y
+        std::vector<Squidl::Utils::UIRect> m_slots;
+        std::size_t m_visibleBegin = 0;
+        std::size_t m_visibleEnd = 0;
+        bool m_horizontal = false;
+        bool m_ownDamage = false; // Damage of our own rect is not clipped
+
+        bool m_kinetic = true;
+        float m_friction = 0.95f;
+        int m_wheelStep = 48;
+        Velocity m_velocity; // Pixels per second
+        Uint32 m_lastTick = 0;
+        // Sub-pixel remainder of the kinetic motion
+        float m_remainderX = 0.0f;
+        float m_remainderY = 0.0f;
+
+        bool m_dragging = false;
+        Squidl::Utils::Point m_dragLast = {0, 0};
+        Uint32 m_dragTick = 0;
+
+        Squidl::Utils::Color m_scrollBarColor = {0, 0, 0, 110};
+
+        void updateBackdrop(Squidl::Core::UIContext &ctx,
+                            Squidl::Core::IRenderer &renderer) override;
+    };
+
+} // namespace Squidl::Layouts
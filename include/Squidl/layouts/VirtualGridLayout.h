@@ -0,0 +1,109 @@
+#pragma once
+#include "Squidl/layouts/Layout.h"
+#include "Squidl/utils/Size.h" // For Squidl::Utils::Size
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace Squidl::Layouts {
+
+    /**
+     * @brief Grid that only keeps widgets for the items inside its viewport.
+     * @ingroup Layouts
+     * Items are described by a count and a data source instead of child
+     * elements: the factory creates an item widget, the binder fills a
+     * widget for a given item index. Widgets scrolled out of view are
+     * recycled for the items scrolling in, so the cost of layout, update and
+     * memory follows the viewport size rather than the item count.
+     *
+     * Item widgets are not registered with the EventDispatcher; the layout
+     * forwards mouse events to the visible widget under the cursor (and to
+     * the one that was under it before, so it sees the cursor leave). The
+     * mouse wheel scrolls the grid when no item handles it.
+     *
+     * All rows have the same height. With itemSize.w == 0 the columns
+     * stretch to the available width.
+     */
+    class SQUIDL_API VirtualGridLayout : public Layout {
+      public:
+        using ItemFactory =
+            std::function<std::shared_ptr<Squidl::Base::UIElement>()>;
+        using ItemBinder =
+            std::function<void(Squidl::Base::UIElement &item, std::size_t index)>;
+
+        VirtualGridLayout(int columns, Squidl::Utils::Size itemSize,
+                          int spacing = 5, int padding = 5);
+
+        // Items come from the data source; adding children is not supported
+        void add(std::shared_ptr<Squidl::Base::UIElement> child) override;
+
+        void setDataSource(ItemFactory factory, ItemBinder binder);
+        void setItemCount(std::size_t count);
+        std::size_t getItemCount() const { return m_itemCount; }
+
+        void setColumns(int value);
+        int getColumns() const { return m_columns; }
+        void setItemSize(Squidl::Utils::Size size);
+        Squidl::Utils::Size getItemSize() const { return m_itemSize; }
+
+        /**
+         * @brief Rebinds every visible item, e.g. after the data changed.
+         */
+        void refreshItems();
+        /**
+         * @brief Rebinds one item if it is visible.
+         */
+        void refreshItem(std::size_t index);
+
+        // Vertical scroll position in pixels, clamped to the content
+        void setScrollOffset(int offset);
+        int getScrollOffset() const { return m_scrollOffset; }
+        int getMaxScrollOffset() const;
+        int getContentHeight() const;
+        void scrollToItem(std::size_t index);
+        void setWheelStep(int rows) { m_wheelRows = rows; }
+
+        // Visible items and their widgets, ordered by index
+        std::size_t getFirstVisibleIndex() const { return m_first; }
+        std::size_t getVisibleCount() const { return m_active.size(); }
+        std::shared_ptr<Squidl::Base::UIElement>
+        getItemWidget(std::size_t index) const;
+
+        void setRect(const Squidl::Utils::UIRect &newRect) override;
+        void setFont(TTF_Font *f) override;
+        bool update(Squidl::Core::UIContext &ctx,
+                    Squidl::Core::IRenderer &renderer) override;
+        void autosize() override;
+        void onEvent(Squidl::Core::UIEvent &event) override;
+        Squidl::Core::EventMask getEventMask() const override {
+            return Squidl::Core::EventMask::Mouse;
+        }
+
+      private:
+        int rowHeight() const { return m_itemSize.h + spacing; }
+        int cellWidth() const;
+        Squidl::Utils::UIRect itemRect(std::size_t index) const;
+        // Binds widgets to the items in the viewport and places them
+        void syncItems();
+        void releaseAll();
+        std::shared_ptr<Squidl::Base::UIElement> acquire();
+
+        ItemFactory m_factory;
+        ItemBinder m_binder;
+        std::size_t m_itemCount = 0;
+        int m_columns;
+        Squidl::Utils::Size m_itemSize;
+        int m_scrollOffset = 0;
+        int m_wheelRows = 3;
+
+        std::size_t m_first = 0; // Index of m_active[0]
+        std::vector<std::shared_ptr<Squidl::Base::UIElement>> m_active;
+        std::vector<std::shared_ptr<Squidl::Base::UIElement>> m_pool;
+        std::weak_ptr<Squidl::Base::UIElement> m_hovered;
+
+        void updateBackdrop(Squidl::Core::UIContext &ctx,
+                            Squidl::Core::IRenderer &renderer) override;
+    };
+
+} // namespace Squidl::Layouts
@@ -0,0 +1,19 @@
+#pragma once
+#include "Squidl/layouts/VirtualGridLayout.h"
+
+namespace Squidl::Layouts {
+
+    /**
+     * @brief Single-column VirtualGridLayout whose rows fill its width.
+     * @ingroup Layouts
+     */
+    class SQUIDL_API VirtualListLayout : public VirtualGridLayout {
+      public:
+        explicit VirtualListLayout(int rowHeight, int spacing = 1,
+                                   int padding = 0);
+
+        void setRowHeight(int value) { setItemSize({0, value}); }
+        int getRowHeight() const { return getItemSize().h; }
+    };
+
+} // namespace Squidl::Layouts
@@ -1,2 +1,110 @@
+#pragma once
+#include "Squidl/SquidlConfig.h"     // For SQUIDL_API
+#include "Squidl/utils/MappedFile.h" // For the shared font file mappings
+#include <SDL_ttf.h>                 // For TTF_Font
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <tuple>
+
 namespace Squidl::Managers {
-}
\ No newline at end of file
+
+    class ResourceManager;
+
+    /**
+     * @brief Ref-counted font handle. get() yields the TTF_Font* elements
+     * take; the face stays open while any handle to it exists.
+     */
+    using FontHandle = std::shared_ptr<TTF_Font>;
+
+    /**
+     * @brief Counters describing the state of a FontManager.
+     */
+    struct SQUIDL_API FontManagerStats {
+        std::size_t faces = 0;       // Open (path, size, style) faces
+        std::size_t files = 0;       // Mapped font files
+        std::size_t mappedBytes = 0; // Total size of the mapped files
+        std::size_t hits = 0;        // load() calls served from the cache
+        std::size_t misses = 0;      // load() calls that opened a face
+        std::size_t evictions = 0;   // Faces closed by evictUnused()
+    };
+
+    /**
+     * @brief Loads every (path, size, style) font face once.
+     * Font files are memory-mapped and every face opened from a file reads
+     * the same mapping through TTF_OpenFontRW, so five sizes of one font
+     * cost one mapping instead of five reads of the whole file.
+     *
+     * load() hands out ref-counted handles. Faces nobody holds a handle to
+     * stay cached until evictUnused() closes them; the evict callback runs
+     * for each of them first, so renderers can drop what they cached for
+     * the font (see SDL2Renderer::purgeFont()).
+     *
+     * With a ResourceManager set, fonts found in its archives are opened
+     * straight from the archive mapping instead.
+     *
+     * @note Fonts are closed when their last handle goes away, which must
+     * happen before TTF_Quit().
+     */
+    class SQUIDL_API FontManager {
+      public:
+        using EvictCallback = std::function<void(TTF_Font *font)>;
+
+        FontManager() = default;
+        ~FontManager();
+
+        FontManager(const FontManager &) = delete;
+        FontManager &operator=(const FontManager &) = delete;
+
+        /**
+         * @brief Returns a handle to a font face, opening it on first use.
+         * @param path Path of the .ttf/.otf file.
+         * @param size Point size.
+         * @param style TTF_STYLE_* flags.
+         * @return The handle, or nullptr if the font could not be loaded.
+         */
+        FontHandle load(const std::string &path, int size,
+                        int style = TTF_STYLE_NORMAL);
+
+        /**
+         * @brief Closes faces without handles and unmaps files no face uses.
+         * @return The number of faces closed.
+         */
+        std::size_t evictUnused();
+
+        void setEvictCallback(EvictCallback callback) {
+            m_onEvict = std::move(callback);
+        }
+
+        // Not owned, must outlive the manager; nullptr reads loose files only
+        void setResourceManager(ResourceManager *resources) {
+            m_resources = resources;
+        }
+
+        const FontManagerStats &getStats() const { return m_stats; }
+
+      private:
+        // Owns an open face and keeps the mapping it reads from alive
+        struct Face {
+            TTF_Font *font = nullptr;
+            std::shared_ptr<Squidl::Utils::MappedFile> file;
+            ~Face();
+        };
+
+        using FaceKey = std::tuple<std::string, int, int>;
+
+        std::shared_ptr<Squidl::Utils::MappedFile>
+        mapFile(const std::string &path);
+        void updateFileStats();
+
+        std::map<FaceKey, std::shared_ptr<Face>> m_faces;
+        std::map<std::string, std::weak_ptr<Squidl::Utils::MappedFile>>
+            m_files;
+        EvictCallback m_onEvict;
+        ResourceManager *m_resources = nullptr;
+        FontManagerStats m_stats;
+    };
+
+} // namespace Squidl::Managers
@@ -1,2 +1,88 @@
+#pragma once
+#include "Squidl/SquidlConfig.h"     // For SQUIDL_API
+#include "Squidl/utils/MappedFile.h" // For the mapped archives
+#include <SDL.h>                     // For SDL_RWops
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 namespace Squidl::Managers {
-}
\ No newline at end of file
+
+    /**
+     * @brief A file inside a mounted archive. data points into the mapping,
+     * which stays mapped while the view (or any copy of it) exists.
+     */
+    struct SQUIDL_API ResourceView {
+        const std::uint8_t *data = nullptr;
+        std::size_t size = 0;
+        std::shared_ptr<Squidl::Utils::MappedFile> archive;
+
+        explicit operator bool() const { return data != nullptr; }
+    };
+
+    /**
+     * @brief Serves assets from archives written by SquidlPack.
+     * A mounted archive is memory-mapped once and its index read into a hash
+     * map, so opening an asset costs a lookup instead of the open/stat/read
+     * of a loose file. Data is never copied: openRW() wraps the mapping in
+     * an SDL_RWops, which TTF_OpenFontRW and IMG_Load_RW read in place.
+     *
+     * Paths are looked up exactly as stored ('/' separators). Paths no
+     * archive contains fall back to loose files, so the loose assets keep
+     * working during development.
+     *
+     * Mount archives before loading from other threads; lookups are not
+     * synchronized with mount().
+     */
+    class SQUIDL_API ResourceManager {
+      public:
+        ResourceManager() = default;
+
+        ResourceManager(const ResourceManager &) = delete;
+        ResourceManager &operator=(const ResourceManager &) = delete;
+
+        /**
+         * @brief Maps an archive and adds its files. Files of later archives
+         * replace those with the same path in earlier ones.
+         * @return false if the archive could not be mapped or is invalid.
+         */
+        bool mount(const std::string &archivePath);
+
+        /**
+         * @brief Looks a file up in the mounted archives.
+         * @return An empty view if no archive contains it.
+         */
+        ResourceView find(const std::string &path) const;
+        bool contains(const std::string &path) const {
+            return m_entries.count(path) != 0;
+        }
+
+        /**
+         * @brief Opens a read-only SDL_RWops for an asset: a view of the
+         * mapping for archived files, the loose file otherwise. Empty
+         * archived files open as a stream with nothing to read.
+         * @note The archive must stay mounted while the RWops is in use;
+         * hold the ResourceView from find() to keep it mapped longer.
+         * @return The RWops, to be closed by the caller (or by passing
+         * freesrc = 1 to the SDL_ttf/SDL_image loader), or nullptr.
+         */
+        SDL_RWops *openRW(const std::string &path) const;
+
+        std::size_t getFileCount() const { return m_entries.size(); }
+        std::size_t getArchiveCount() const { return m_archives.size(); }
+
+      private:
+        struct Entry {
+            const std::uint8_t *data;
+            std::size_t size;
+            std::size_t archive; // Index into m_archives
+        };
+
+        std::vector<std::shared_ptr<Squidl::Utils::MappedFile>> m_archives;
+        std::unordered_map<std::string, Entry> m_entries;
+    };
+
+} // namespace Squidl::Managers
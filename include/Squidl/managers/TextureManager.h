@@ -1,2 +1,222 @@
+#pragma once
+#include "Squidl/SquidlConfig.h"              // For SQUIDL_API
+#include "Squidl/managers/ResourceManager.h" // For archived images
+#include <SDL.h> // For SDL_Renderer, SDL_Texture, SDL_Surface
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
 namespace Squidl::Managers {
-}
\ No newline at end of file
+
+    enum class TextureState {
+        Pending, // Decoding or uploading
+        Ready,
+        Failed
+    };
+
+    /**
+     * @brief An image loaded by a TextureManager.
+     * get() returns nullptr until the texture is Ready; draw a placeholder
+     * in the meantime. Only touched on the render thread.
+     */
+    class SQUIDL_API TextureResource {
+      public:
+        using ReadyCallback = std::function<void(TextureResource &texture)>;
+
+        explicit TextureResource(std::string path) : m_path(std::move(path)) {}
+        ~TextureResource();
+
+        TextureResource(const TextureResource &) = delete;
+        TextureResource &operator=(const TextureResource &) = delete;
+
+        SDL_Texture *get() const {
+            return isReady() ? m_levels.front().texture : nullptr;
+        }
+
+        /**
+         * @brief Picks the mip level to draw into a w x h rect: the smallest
+         * one that is still at least that large, so it is never magnified.
+         * @return The full-size texture without mip levels, nullptr until
+         * the texture is Ready.
+         */
+        SDL_Texture *getForSize(int w, int h) const;
+
+        TextureState getState() const { return m_state; }
+        bool isReady() const { return m_state == TextureState::Ready; }
+        const std::string &getPath() const { return m_path; }
+        int getWidth() const {
+            return m_levels.empty() ? 0 : m_levels.front().width;
+        }
+        int getHeight() const {
+            return m_levels.empty() ? 0 : m_levels.front().height;
+        }
+        // 1 without mip levels
+        std::size_t getLevelCount() const { return m_levels.size(); }
+
+      private:
+        friend class TextureManager;
+
+        struct Level {
+            SDL_Texture *texture = nullptr; // Owned
+            int width = 0;
+            int height = 0;
+        };
+
+        std::string m_path;
+        TextureState m_state = TextureState::Pending;
+        // [0] is the full-size image, each further level half the previous
+        std::vector<Level> m_levels;
+        // Run once the texture is Ready or Failed
+        std::vector<ReadyCallback> m_onReady;
+    };
+
+    /**
+     * @brief Ref-counted texture handle; the texture is destroyed with its
+     * last handle.
+     */
+    using TextureHandle = std::shared_ptr<TextureResource>;
+
+    /**
+     * @brief Counters describing the state of a TextureManager.
+     */
+    struct SQUIDL_API TextureManagerStats {
+        std::size_t textures = 0;      // Live textures, loaded or pending
+        std::size_t decoding = 0;      // Images queued for or in decoding
+        std::size_t uploading = 0;     // Decoded images waiting for upload
+        std::size_t uploadedBytes = 0; // Pixels uploaded so far
+        std::size_t hits = 0;          // load() calls served from the cache
+        std::size_t misses = 0;        // load() calls that started a decode
+        std::size_t failed = 0;        // Images that could not be loaded
+    };
+
+    /**
+     * @brief Loads image files into textures without blocking the UI.
+     * Images are decoded with IMG_Load on a pool of worker threads and
+     * converted to ARGB8888 there. The decoded surfaces are uploaded on the
+     * render thread by processUploads(), which stops once its per-frame
+     * time budget is spent; large images are uploaded in bands of rows over
+     * several frames, so a 4K background never stalls a single frame.
+     *
+     * load() deduplicates by path: every caller of a path shares one
+     * TextureResource while any handle to it exists. With a ResourceManager
+     * set, images found in its archives are decoded from the mapping.
+     *
+     * With mipmaps enabled the workers also compute a box-filtered chain of
+     * half-size levels down to MinMipSize. Elements drawing the image small
+     * (thumbnails, small backdrops) then pick a level with getForSize()
+     * instead of sampling the full-size texture. The chain adds up to a
+     * third to the image's memory.
+     *
+     * @note Textures belong to the SDL_Renderer, so every handle must be
+     * released before it is destroyed.
+     */
+    class SQUIDL_API TextureManager {
+      public:
+        static constexpr double DefaultUploadBudgetMs = 4.0;
+        // Mip chains stop before a level's longer side drops below this
+        static constexpr int MinMipSize = 16;
+
+        /**
+         * @brief Constructor.
+         * @param renderer The renderer textures are created for. Not owned.
+         * @param workers Number of decoding threads; 0 picks one from the
+         * number of hardware threads.
+         */
+        explicit TextureManager(SDL_Renderer *renderer, unsigned workers = 0);
+        ~TextureManager();
+
+        TextureManager(const TextureManager &) = delete;
+        TextureManager &operator=(const TextureManager &) = delete;
+
+        /**
+         * @brief Returns the texture of an image file, starting to load it
+         * if nobody holds it yet.
+         * @param path Path of the image.
+         * @param onReady Optional, called on the render thread from
+         * processUploads() once the texture is Ready or Failed. Not called
+         * if it already is when load() returns.
+         */
+        TextureHandle load(const std::string &path,
+                           TextureResource::ReadyCallback onReady = {});
+
+        /**
+         * @brief Uploads decoded images until the budget is spent. Call it
+         * once per frame on the render thread, before drawing.
+         * @param budgetMs Time the uploads may take. At least one band of
+         * rows is uploaded per call, so loading always makes progress.
+         * @return The number of textures that became Ready or Failed.
+         */
+        std::size_t processUploads(double budgetMs = DefaultUploadBudgetMs);
+
+        /**
+         * @brief true while images are being decoded or uploaded.
+         */
+        bool isLoading() const;
+
+        /**
+         * @brief Not owned, must outlive the manager; nullptr reads loose
+         * files only. Set it before the first load().
+         */
+        void setResourceManager(ResourceManager *resources) {
+            m_resources = resources;
+        }
+
+        /**
+         * @brief Enables mip chains for images loaded from now on. Images
+         * already loaded (or shared by path with them) keep theirs.
+         */
+        void setMipmaps(bool enabled) { m_mipmaps = enabled; }
+        bool isMipmaps() const { return m_mipmaps; }
+
+        TextureManagerStats getStats() const;
+
+      private:
+        struct Job {
+            std::string path;
+            std::weak_ptr<TextureResource> target;
+            ResourceView source; // Empty for loose files
+            bool mipmaps = false;
+            // ARGB8888 once decoded; [0] is full size, then the mip chain
+            std::vector<SDL_Surface *> levels;
+            std::string error;
+            std::size_t uploadLevel = 0;
+            int uploadedRows = 0;
+        };
+
+        void workerLoop();
+        static void decode(Job &job);
+        static void releaseLevels(Job &job);
+        // Uploads the next band of rows; true once the job is complete
+        bool uploadBand(Job &job, TextureResource &texture);
+        void finish(Job &job, TextureResource &texture);
+
+        SDL_Renderer *m_sdlRenderer; // Not owned
+        ResourceManager *m_resources = nullptr;
+        bool m_mipmaps = false;
+        std::map<std::string, std::weak_ptr<TextureResource>> m_textures;
+        std::size_t m_sweepAt; // Size at which load() drops expired entries
+
+        mutable std::mutex m_mutex; // Guards the queues and m_stop
+        std::condition_variable m_wake;
+        std::deque<std::unique_ptr<Job>> m_decodeQueue;
+        std::deque<std::unique_ptr<Job>> m_uploadQueue;
+        std::size_t m_decoding = 0; // Popped by a worker, not decoded yet
+        bool m_stop = false;
+        std::vector<std::thread> m_workers;
+
+        // Render thread only: the job being uploaded and the counters
+        std::unique_ptr<Job> m_current;
+        std::size_t m_uploadedBytes = 0;
+        std::size_t m_hits = 0;
+        std::size_t m_misses = 0;
+        std::size_t m_failed = 0;
+    };
+
+} // namespace Squidl::Managers
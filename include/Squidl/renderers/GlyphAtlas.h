@@ -0,0 +1,141 @@
+// include/Squidl/renderers/GlyphAtlas.h
+#pragma once
+
+#include "Squidl/SquidlConfig.h"       // For SQUIDL_API
+#include "Squidl/utils/Color.h"        // For Squidl::Utils::Color
+#include "Squidl/utils/SkylinePacker.h" // For atlas page layout
+#include <SDL.h>                       // For SDL_Renderer, SDL_Vertex
+#include <SDL_ttf.h>                   // For TTF_Font
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Squidl::Renderers {
+
+    /**
+     * @brief Counters describing the state of a GlyphAtlas.
+     * @ingroup Renderers
+     */
+    struct SQUIDL_API GlyphAtlasStats {
+        std::size_t glyphs = 0;         // Glyphs stored in the atlas
+        std::size_t pages = 0;          // Atlas textures allocated
+        std::size_t rasterized = 0;     // Glyphs rendered since the last reset
+        std::size_t drawCalls = 0;      // SDL_RenderGeometry submissions
+        std::size_t quads = 0;          // Glyph quads submitted
+        std::size_t rejected = 0;       // Glyphs left out since the last reset
+    };
+
+    /**
+     * @brief Text engine drawing strings from a shared glyph atlas.
+     * @ingroup Renderers
+     * Every glyph of a font is rasterized once (in white) into an atlas page
+     * texture. A string is then drawn as a batch of textured quads, tinted
+     * through the vertex color, with one SDL_RenderGeometry call per atlas
+     * page it touches. Changing text costs vertex writes only, which suits
+     * views whose content changes every frame.
+     *
+     * @note Like TextTextureCache, the atlas is keyed by TTF_Font pointer.
+     * Call removeFont() before closing a font.
+     *
+     * The number of pages is capped. Once every page is full, glyphs not
+     * rasterized yet are left out (counted in GlyphAtlasStats::rejected)
+     * and stay blank until clear(); removeFont() frees pages for glyphs
+     * that come later.
+     */
+    class SQUIDL_API GlyphAtlas {
+      public:
+        static constexpr int DefaultPageSize = 512;
+        static constexpr int DefaultMaxPages = 8;
+
+        /**
+         * @brief Constructor.
+         * @param renderer The SDL_Renderer pages are created for. Not owned.
+         * @param pageSize Width and height of each atlas page texture.
+         * @param maxPages Maximum number of page textures.
+         */
+        explicit GlyphAtlas(SDL_Renderer *renderer,
+                            int pageSize = DefaultPageSize,
+                            int maxPages = DefaultMaxPages);
+        ~GlyphAtlas();
+
+        GlyphAtlas(const GlyphAtlas &) = delete;
+        GlyphAtlas &operator=(const GlyphAtlas &) = delete;
+
+        /**
+         * @brief Draws a single line of UTF-8 text.
+         * @param font The font to render with.
+         * @param text The text to draw.
+         * @param color The text color.
+         * @param x Left edge of the text.
+         * @param y Top edge of the text line.
+         * @return false if nothing could be drawn.
+         */
+        bool drawText(TTF_Font *font, const std::string &text,
+                      Squidl::Utils::Color color, int x, int y);
+
+        /**
+         * @brief Drops every glyph of the given font. Pages left without
+         * glyphs are reused; space on shared pages is reclaimed on the next
+         * clear().
+         */
+        void removeFont(TTF_Font *font);
+
+        /**
+         * @brief Destroys every atlas page and glyph.
+         */
+        void clear();
+
+        const GlyphAtlasStats &getStats() const { return m_stats; }
+        void resetCounters();
+
+      private:
+        struct Glyph {
+            int page = -1;       // -1 for glyphs without pixels (spaces)
+            SDL_Rect src{0, 0, 0, 0};
+            int offsetX = 0;     // Horizontal offset of the bitmap
+            int advance = 0;
+        };
+
+        struct FontKey {
+            TTF_Font *font;
+            int style;
+            bool operator==(const FontKey &other) const {
+                return font == other.font && style == other.style;
+            }
+        };
+
+        struct FontKeyHash {
+            std::size_t operator()(const FontKey &key) const;
+        };
+
+        using GlyphMap = std::unordered_map<Uint32, Glyph>;
+
+        struct Page {
+            SDL_Texture *texture = nullptr;
+            Squidl::Utils::SkylinePacker packer;
+            std::size_t glyphs = 0; // Glyphs placed on the page
+        };
+
+        const Glyph *findOrRasterize(TTF_Font *font, GlyphMap &glyphs,
+                                     Uint32 codepoint);
+        bool placeGlyph(SDL_Surface *surface, Glyph &glyph);
+        bool addPage();
+        void clearPage(SDL_Texture *texture);
+        void flush(int page);
+
+        SDL_Renderer *m_sdlRenderer; // Not owned
+        int m_pageSize;
+        int m_maxPages;
+        bool m_warnedFull = false; // Logged once until clear()
+        std::vector<Page> m_pages;
+        std::unordered_map<FontKey, GlyphMap, FontKeyHash> m_fonts;
+
+        // Scratch buffers reused between calls to avoid reallocations
+        std::vector<SDL_Vertex> m_vertices;
+        std::vector<int> m_indices;
+
+        GlyphAtlasStats m_stats;
+    };
+
+} // namespace Squidl::Renderers
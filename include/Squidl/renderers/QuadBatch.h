@@ -0,0 +1,131 @@
+// include/Squidl/renderers/QuadBatch.h
+#pragma once
+
+#include "Squidl/SquidlConfig.h" // For SQUIDL_API
+#include "Squidl/utils/Color.h"  // For Squidl::Utils::Color
+#include <SDL.h>                 // For SDL_Renderer, SDL_Vertex
+#include <array>
+#include <cstddef>
+#include <vector>
+
+namespace Squidl::Renderers {
+
+    /**
+     * @brief Counters describing the work done by a QuadBatch.
+     * @ingroup Renderers
+     */
+    struct SQUIDL_API QuadBatchStats {
+        std::size_t drawCalls = 0; // SDL_RenderGeometry submissions
+        std::size_t shapes = 0;    // Quads and rounded shapes added
+        std::size_t triangles = 0; // Triangles submitted
+    };
+
+    /**
+     * @brief Accumulates solid and rounded shapes into one vertex buffer.
+     * @ingroup Renderers
+     * Shapes are tessellated into triangles on the CPU and submitted with a
+     * single SDL_RenderGeometry call when the batch is flushed, instead of
+     * one draw call (or, for SDL2_gfx shapes, one call per scanline) per
+     * shape. Rounded corners are fans whose segment count follows the
+     * radius.
+     *
+     * The owner flushes the batch whenever render state changes (clip rect,
+     * render target, non-batched drawing) and before presenting. Shapes
+     * sharing a texture batch together; setTexture() flushes on change.
+     * Textures that may still be queued are destroyed with destroyTexture().
+     */
+    class SQUIDL_API QuadBatch {
+      public:
+        /**
+         * @brief Constructor.
+         * @param renderer The SDL_Renderer to submit to. Not owned.
+         */
+        explicit QuadBatch(SDL_Renderer *renderer);
+        ~QuadBatch();
+
+        QuadBatch(const QuadBatch &) = delete;
+        QuadBatch &operator=(const QuadBatch &) = delete;
+
+        /**
+         * @brief Selects the texture of the following shapes, nullptr for
+         * solid color. Flushes if the texture changes.
+         */
+        void setTexture(SDL_Texture *texture);
+        SDL_Texture *getTexture() const { return m_texture; }
+
+        /**
+         * @brief Makes solid shapes sample one opaque white texel of a
+         * texture instead of using no texture, so they can share a batch
+         * with textured shapes from it. nullptr goes back to untextured.
+         * @param texture The texture holding the white texel.
+         * @param uv Normalized coordinates of the texel's center.
+         */
+        void setSolidTexture(SDL_Texture *texture, SDL_FPoint uv);
+
+        void addRect(const SDL_Rect &rect, Squidl::Utils::Color color);
+
+        /**
+         * @brief Adds a textured quad, tinted by the vertex color.
+         * @param rect Destination rectangle.
+         * @param uv Texture coordinates of the corners, normalized.
+         */
+        void addQuad(const SDL_FRect &rect, const SDL_FRect &uv,
+                     Squidl::Utils::Color color);
+
+        // Outline 1 pixel wide along the inside of rect
+        void addOutline(const SDL_Rect &rect, Squidl::Utils::Color color);
+
+        /**
+         * @brief Adds a filled rect with rounded corners. The radius is
+         * clamped to half of the smaller side.
+         */
+        void addRoundedRect(const SDL_Rect &rect, int radius,
+                            Squidl::Utils::Color color);
+
+        // Rounded outline 1 pixel wide along the inside of rect
+        void addRoundedOutline(const SDL_Rect &rect, int radius,
+                               Squidl::Utils::Color color);
+
+        /**
+         * @brief Submits the accumulated triangles.
+         */
+        void flush();
+        bool isEmpty() const { return m_indices.empty(); }
+
+        /**
+         * @brief Flushes every batch with shapes queued from a texture, so it
+         * can be destroyed. Must be called on the rendering thread.
+         */
+        static void releaseTexture(SDL_Texture *texture);
+
+        /**
+         * @brief releaseTexture() followed by SDL_DestroyTexture(). Use it for
+         * textures that may have been drawn through IRenderer::drawTexture.
+         */
+        static void destroyTexture(SDL_Texture *texture);
+
+        const QuadBatchStats &getStats() const { return m_stats; }
+        void resetCounters() { m_stats = {}; }
+
+      private:
+        static constexpr int MaxCornerSegments = 12;
+
+        // Corner contour of a rounded rect, clockwise from the top-left arc
+        void roundedContour(float x, float y, float w, float h, float radius,
+                            int segments);
+        static int segmentsFor(float radius);
+        // Unit quarter circle with the given number of segments
+        const std::vector<SDL_FPoint> &quarterCircle(int segments);
+
+        SDL_Renderer *m_sdlRenderer; // Not owned
+        SDL_Texture *m_texture = nullptr;
+        SDL_Texture *m_solidTexture = nullptr;
+        SDL_FPoint m_solidUV = {0.0f, 0.0f};
+        std::vector<SDL_Vertex> m_vertices;
+        std::vector<int> m_indices;
+        std::vector<SDL_FPoint> m_contour; // Scratch for rounded shapes
+        std::array<std::vector<SDL_FPoint>, MaxCornerSegments + 1> m_arcs;
+        QuadBatchStats m_stats;
+    };
+
+} // namespace Squidl::Renderers
@@ -0,0 +1,162 @@
+// include/Squidl/renderers/RecordingRenderer.h
+#pragma once
+
+#include "Squidl/core/IRenderer.h" // Inherit from IRenderer
+#include "Squidl/utils/Color.h"    // For Squidl::Utils::Color
+#include "Squidl/utils/UIRect.h"   // For Squidl::Utils::UIRect
+#include <SDL.h>                   // For SDL_Texture, SDL_Rect
+#include <SDL_ttf.h>               // For TTF_Font
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace Squidl::Renderers {
+
+    /**
+     * @brief Counters describing the work done by a RecordingRenderer.
+     * @ingroup Renderers
+     */
+    struct SQUIDL_API RecordingStats {
+        std::size_t framesRecorded = 0; // Frames passed through endFrame()
+        std::size_t framesReplayed = 0; // Frames forwarded to the target
+        std::size_t framesSkipped = 0;  // Frames identical to the previous one
+        std::size_t commands = 0;       // Commands in the last recorded frame
+    };
+
+    /**
+     * @brief Retained-mode IRenderer that records a frame before drawing it.
+     * @ingroup Renderers
+     * Every drawing call between beginFrame() and endFrame() is stored in a
+     * compact command buffer instead of being executed. endFrame() compares
+     * the buffer with the previous frame: if both are identical nothing is
+     * drawn and the caller can skip presenting; otherwise the commands are
+     * replayed into the target renderer.
+     *
+     * @note Textures are compared by pointer. When the pixels of a texture
+     * change without the pointer changing, call invalidate() so the next
+     * frame is replayed.
+     */
+    class SQUIDL_API RecordingRenderer : public Squidl::Core::IRenderer {
+      public:
+        /**
+         * @brief Constructor.
+         * @param target The renderer recorded frames are replayed into. Not
+         * owned, must outlive the RecordingRenderer.
+         */
+        explicit RecordingRenderer(Squidl::Core::IRenderer &target);
+
+        /**
+         * @brief Starts recording a new frame.
+         */
+        void beginFrame();
+
+        /**
+         * @brief Finishes the frame and replays it if it changed.
+         * @return true if the frame differs from the previous one and was
+         * drawn into the target; false if presenting can be skipped.
+         */
+        bool endFrame();
+
+        /**
+         * @brief Forces the next frame to be replayed even if it is identical
+         * (e.g. after the window was resized or exposed).
+         */
+        void invalidate() { m_forceReplay = true; }
+
+        const RecordingStats &getStats() const { return m_stats; }
+
+        // Implementation of all pure virtual methods from IRenderer
+        void render(std::shared_ptr<Squidl::Base::UIElement> rootElement,
+                    Squidl::Core::UIContext &ctx) override;
+        void setDrawColor(Squidl::Utils::Color color) override;
+        void clearScreen(Squidl::Utils::Color color) override;
+        void drawLine(int x1, int y1, int x2, int y2,
+                      Squidl::Utils::Color color) override;
+        void drawFilledRect(const Squidl::Utils::UIRect &rect,
+                            Squidl::Utils::Color color) override;
+        void fillRoundedRect(const Squidl::Utils::UIRect &rect, int radius,
+                             Squidl::Utils::Color color) override;
+        void drawRoundedRect(const Squidl::Utils::UIRect &rect, int radius,
+                             Squidl::Utils::Color color) override;
+        void drawOutlineRect(const Squidl::Utils::UIRect &rect,
+                             Squidl::Utils::Color color) override;
+        void drawTexture(SDL_Texture *texture, const SDL_Rect *srcRect,
+                         const SDL_Rect *destRect,
+                         float opacity = 1.0f) override;
+        void drawText(TTF_Font *font, const std::string &text,
+                      Squidl::Utils::Color color,
+                      const Squidl::Utils::UIRect &destRect) override;
+        void setClipRect(const Squidl::Utils::UIRect &rect) override;
+        void resetClipRect() override;
+        void pushClipRect(const Squidl::Utils::UIRect &rect) override;
+        void popClipRect() override;
+        // Tests against the recorded clip stack only, so the recorded frame
+        // does not depend on clipping done by the target
+        bool isRectVisible(const Squidl::Utils::UIRect &rect) const override;
+        SDL_Texture *createLayerTexture(int w, int h) override;
+        bool beginLayer(SDL_Texture *texture,
+                        const Squidl::Utils::UIRect &area) override;
+        void endLayer() override;
+        // Recorded frames are flushed into the target by endFrame()
+        void flush() override {}
+
+      private:
+        enum class Op : Uint8 {
+            SetDrawColor,
+            ClearScreen,
+            Line,
+            FilledRect,
+            FilledRoundedRect,
+            RoundedRect,
+            OutlineRect,
+            Texture,
+            Text,
+            SetClip,
+            ResetClip,
+            PushClip,
+            PopClip,
+            BeginLayer,
+            EndLayer,
+        };
+
+        // One recorded call. Strings live in the frame's text pool so the
+        // command itself stays trivially copyable.
+        struct Command {
+            Op op;
+            bool hasSrc;
+            bool hasDest;
+            Squidl::Utils::Color color;
+            Squidl::Utils::UIRect rect; // Rect, destination or line ends
+            Squidl::Utils::UIRect src;  // Texture source rect
+            int radius;
+            float opacity;
+            const void *resource; // TTF_Font* or SDL_Texture* (also layers)
+            std::size_t textOffset;
+            std::size_t textLength;
+        };
+
+        struct Frame {
+            std::vector<Command> commands;
+            std::string textPool;
+
+            void clear() {
+                commands.clear();
+                textPool.clear();
+            }
+        };
+
+        Command &push(Op op);
+        bool sameAsPrevious() const;
+        void replay(const Frame &frame);
+
+        Squidl::Core::IRenderer &m_target;
+        Frame m_current;
+        Frame m_previous;
+        bool m_forceReplay = true;
+        RecordingStats m_stats;
+        std::vector<Squidl::Utils::UIRect> m_clipStack; // Already intersected
+        // Clip stacks of the targets below the layers being recorded
+        std::vector<std::vector<Squidl::Utils::UIRect>> m_layerClipStacks;
+    };
+
+} // namespace Squidl::Renderers
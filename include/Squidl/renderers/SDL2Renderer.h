@@ -2,8 +2,14 @@
 #pragma once
 
 #include "Squidl/core/IRenderer.h" // Inherit from IRenderer
+#include "Squidl/renderers/GlyphAtlas.h"       // For atlas text rendering
+#include "Squidl/renderers/QuadBatch.h"        // For batched shapes
+#include "Squidl/renderers/ShapeAtlas.h"       // For cached rounded shapes
+#include "Squidl/renderers/TextTextureCache.h" // For cached text textures
+#include "Squidl/utils/Point.h"    // For the layer origin
 #include <SDL.h>                   // For SDL_Renderer
 #include <SDL_ttf.h> // For TTF_Font (as it's used in drawText signature)
+#include <vector>    // For the clip stack
 
 // Forward declarations
 namespace Squidl::Base {
@@ -16,10 +22,28 @@ namespace Squidl::Core {
 namespace Squidl::Renderers { // New namespace for specific renderer
                               // implementations
 
+    /**
+     * @brief Selects how SDL2Renderer::drawText produces text.
+     * @ingroup Renderers
+     */
+    enum class TextRenderMode {
+        TextureCache, // One cached texture per string; best for static text
+        GlyphAtlas,   // Batched quads from a glyph atlas; best for text that
+                      // changes every frame
+    };
+
     /**
      * @brief Concrete SDL2 implementation of the UI renderer.
      * @ingroup Renderers
      * Implements the IRenderer interface using SDL2 functions for rendering.
+     * Rects and rounded rects are batched (see QuadBatch) and submitted when
+     * render state changes, at the end of render() or when flush() is
+     * called. Rounded rects come from
+     * anti-aliased nine-slice textures (see ShapeAtlas) when possible.
+     * Textures drawn into a destination rect join the batch as well, so
+     * regions of one TextureAtlas page need a single draw call. Such
+     * textures must be destroyed with QuadBatch::destroyTexture(), which
+     * submits the quads still queued from them.
      */
     class SQUIDL_API SDL2Renderer : public Squidl::Core::IRenderer {
       public:
@@ -27,8 +51,11 @@ namespace Squidl::Renderers { // New namespace for specific renderer
          * @brief Constructor.
          * @param renderer Pointer to the SDL_Renderer. SDL2Renderer does not
          * own this pointer and does not free it upon destruction.
+         * @note Cached textures are released in the destructor, so the
+         * SDL2Renderer must be destroyed before the SDL_Renderer.
          */
         SDL2Renderer(SDL_Renderer *renderer);
+        ~SDL2Renderer() override;
 
         // Implementation of all pure virtual methods from IRenderer
         void render(std::shared_ptr<Squidl::Base::UIElement> rootElement,
@@ -57,9 +84,96 @@ namespace Squidl::Renderers { // New namespace for specific renderer
                       const Squidl::Utils::UIRect &destRect) override;
         void setClipRect(const Squidl::Utils::UIRect &rect) override;
         void resetClipRect() override;
+        void pushClipRect(const Squidl::Utils::UIRect &rect) override;
+        void popClipRect() override;
+        bool isRectVisible(const Squidl::Utils::UIRect &rect) const override;
+        SDL_Texture *createLayerTexture(int w, int h) override;
+        bool beginLayer(SDL_Texture *texture,
+                        const Squidl::Utils::UIRect &area) override;
+        void endLayer() override;
+        void flush() override;
+
+        /**
+         * @brief Returns the batch collecting rects and rounded rects.
+         * Read its counters to see how many draw calls the shapes took.
+         */
+        QuadBatch &getQuadBatch() { return m_quads; }
+        const QuadBatch &getQuadBatch() const { return m_quads; }
+
+        /**
+         * @brief Returns the cache of rounded rect textures.
+         */
+        ShapeAtlas &getShapeAtlas() { return m_shapes; }
+        const ShapeAtlas &getShapeAtlas() const { return m_shapes; }
+
+        /**
+         * @brief Returns the cache holding rendered text between frames.
+         * Use it to tune the memory budget, read the hit/miss counters or
+         * drop the entries of a font before closing it.
+         */
+        TextTextureCache &getTextCache() { return m_textCache; }
+        const TextTextureCache &getTextCache() const { return m_textCache; }
+
+        void setTextRenderMode(TextRenderMode mode) { m_textMode = mode; }
+        TextRenderMode getTextRenderMode() const { return m_textMode; }
+
+        /**
+         * @brief Returns the glyph atlas used in TextRenderMode::GlyphAtlas.
+         */
+        GlyphAtlas &getGlyphAtlas() { return m_glyphAtlas; }
+        const GlyphAtlas &getGlyphAtlas() const { return m_glyphAtlas; }
+
+        /**
+         * @brief Releases everything cached for a font. Call this before
+         * closing a TTF_Font that was drawn with this renderer.
+         */
+        void purgeFont(TTF_Font *font);
+
+        /**
+         * @brief Restricts all drawing to an area, e.g. the damaged part of a
+         * frame. All clipping and isRectVisible() intersect with it, and
+         * resetClipRect() returns to it instead of disabling clipping. An
+         * empty rect blocks drawing.
+         */
+        void setBaseClipRect(const Squidl::Utils::UIRect &rect);
+
+        /**
+         * @brief Removes the base clip area set by setBaseClipRect().
+         */
+        void resetBaseClipRect();
 
       private:
+        // State replaced by beginLayer() and restored by endLayer()
+        struct LayerState {
+            SDL_Texture *target;
+            Squidl::Utils::Point origin;
+            bool hasBaseClip;
+            Squidl::Utils::UIRect baseClip;
+            std::vector<Squidl::Utils::UIRect> clipStack;
+        };
+
+        // Converts window coordinates into coordinates of the current target
+        SDL_Rect toTarget(const Squidl::Utils::UIRect &rect) const {
+            return {rect.x - m_origin.x, rect.y - m_origin.y, rect.w, rect.h};
+        }
+        void applyClipRect(const Squidl::Utils::UIRect &rect);
+        // Innermost pushed clip combined with the base clip; false if
+        // drawing is not clipped at all
+        bool currentClip(Squidl::Utils::UIRect &out) const;
+
         SDL_Renderer *m_sdlRenderer; // Pointer to the underlying SDL_Renderer
+        TextTextureCache m_textCache; // Rendered text reused across frames
+        GlyphAtlas m_glyphAtlas;      // Per-glyph atlas for dynamic text
+        QuadBatch m_quads;            // Shapes waiting for submission
+        ShapeAtlas m_shapes;          // Draws into m_quads, declared after it
+        TextRenderMode m_textMode = TextRenderMode::TextureCache;
+        bool m_hasBaseClip = false;
+        Squidl::Utils::UIRect m_baseClip;
+        std::vector<Squidl::Utils::UIRect> m_clipStack; // Already intersected
+        std::vector<LayerState> m_layerStack;
+        // Window position of the current target's top-left corner
+        Squidl::Utils::Point m_origin;
+        SDL_BlendMode m_layerBlendMode = SDL_BLENDMODE_INVALID;
     };
 
 } // namespace Squidl::Renderers
@@ -0,0 +1,99 @@
+// include/Squidl/renderers/ShapeAtlas.h
+#pragma once
+
+#include "Squidl/SquidlConfig.h"        // For SQUIDL_API
+#include "Squidl/renderers/QuadBatch.h" // For QuadBatch
+#include "Squidl/utils/Color.h"         // For Squidl::Utils::Color
+#include "Squidl/utils/SkylinePacker.h" // For atlas layout
+#include <SDL.h>                        // For SDL_Renderer, SDL_Texture
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+namespace Squidl::Renderers {
+
+    /**
+     * @brief Counters describing the state of a ShapeAtlas.
+     * @ingroup Renderers
+     */
+    struct SQUIDL_API ShapeAtlasStats {
+        std::size_t shapes = 0;     // Cached (radius, thickness) entries
+        std::size_t rasterized = 0; // Shapes rendered since the last reset
+        std::size_t drawn = 0;      // Shapes drawn from the atlas
+        std::size_t rejected = 0;   // Shapes the atlas could not hold
+    };
+
+    /**
+     * @brief Cache of anti-aliased rounded rect textures drawn as nine-slices.
+     * @ingroup Renderers
+     * A rounded rect of radius r looks the same at any size except for its
+     * straight edges, so one (2r+1)x(2r+1) cell per (radius, thickness) is
+     * enough: the four r x r corners are drawn as they are and the middle
+     * row and column are stretched. Cells are rasterized once on the CPU
+     * from the signed distance to the shape (white, with coverage in
+     * alpha) into a single atlas texture. Drawing adds nine textured quads
+     * tinted by the vertex color to a QuadBatch. Circles are rounded rects
+     * whose radius is half their size.
+     *
+     * The atlas also holds a white texel, which it hands to the QuadBatch
+     * for solid shapes, so solid and rounded shapes share one texture and
+     * stay in the same batch.
+     */
+    class SQUIDL_API ShapeAtlas {
+      public:
+        static constexpr int DefaultPageSize = 256;
+        // Larger corners are left to tessellation
+        static constexpr int MaxRadius = 48;
+
+        /**
+         * @brief Constructor.
+         * @param renderer The SDL_Renderer the atlas is created for. Not
+         * owned.
+         * @param batch The batch shapes are drawn into. Not owned, must
+         * outlive the atlas.
+         * @param pageSize Width and height of the atlas texture.
+         */
+        ShapeAtlas(SDL_Renderer *renderer, QuadBatch &batch,
+                   int pageSize = DefaultPageSize);
+        ~ShapeAtlas();
+
+        ShapeAtlas(const ShapeAtlas &) = delete;
+        ShapeAtlas &operator=(const ShapeAtlas &) = delete;
+
+        /**
+         * @brief Draws a rounded rect into the batch.
+         * @param rect The rectangle in target coordinates.
+         * @param radius Corner radius, clamped to half of the smaller side.
+         * @param thickness Outline width, 0 for a filled shape.
+         * @param color The shape color.
+         * @return false if the shape is not cached (too large, or the atlas
+         * is full); the caller draws it some other way.
+         */
+        bool draw(const SDL_Rect &rect, int radius, int thickness,
+                  Squidl::Utils::Color color);
+
+        /**
+         * @brief Destroys the atlas texture and every cached shape.
+         */
+        void clear();
+
+        const ShapeAtlasStats &getStats() const { return m_stats; }
+        void resetCounters();
+
+      private:
+        bool createPage();
+        const SDL_Rect *findOrRasterize(int radius, int thickness);
+
+        SDL_Renderer *m_sdlRenderer; // Not owned
+        QuadBatch &m_batch;
+        int m_pageSize;
+        SDL_Texture *m_texture = nullptr;
+        Squidl::Utils::SkylinePacker m_packer;
+        bool m_full = false; // Warned that the atlas ran out of space
+        // Cell of each (radius << 16 | thickness)
+        std::unordered_map<Uint32, SDL_Rect> m_cells;
+        std::vector<Uint32> m_pixels; // Scratch for rasterization
+        ShapeAtlasStats m_stats;
+    };
+
+} // namespace Squidl::Renderers
@@ -0,0 +1,143 @@
+// include/Squidl/renderers/TextTextureCache.h
+#pragma once
+
+#include "Squidl/SquidlConfig.h" // For SQUIDL_API
+#include "Squidl/utils/Color.h"  // For Squidl::Utils::Color
+#include <SDL.h>                 // For SDL_Renderer, SDL_Texture
+#include <SDL_ttf.h>             // For TTF_Font
+#include <cstddef>
+#include <list>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace Squidl::Renderers {
+
+    /**
+     * @brief Counters describing the state of a TextTextureCache.
+     * @ingroup Renderers
+     */
+    struct SQUIDL_API TextCacheStats {
+        std::size_t hits = 0;      // Lookups served from the cache
+        std::size_t misses = 0;    // Lookups that had to rasterize the text
+        std::size_t evictions = 0; // Entries dropped to stay within limits
+        std::size_t entries = 0;   // Textures currently held
+        std::size_t bytes = 0;     // Estimated memory held by those textures
+    };
+
+    /**
+     * @brief Bounded LRU cache of rasterized text textures.
+     * @ingroup Renderers
+     * Keeps the SDL_Texture produced for a (font, text, color, style) run
+     * between frames, so a static screen rasterizes and uploads its text only
+     * once. When either the entry limit or the memory budget is exceeded, the
+     * least recently used textures are destroyed first.
+     *
+     * @note The cache does not own the fonts it is keyed by. Call removeFont()
+     * before closing a TTF_Font, otherwise a new font allocated at the same
+     * address could be served stale textures.
+     */
+    class SQUIDL_API TextTextureCache {
+      public:
+        static constexpr std::size_t DefaultMemoryBudget = 16 * 1024 * 1024;
+        static constexpr std::size_t DefaultMaxEntries = 2048;
+
+        /**
+         * @brief Constructor.
+         * @param renderer The SDL_Renderer textures are created for. Not owned.
+         * @param memoryBudget Upper bound (in bytes) for cached texture memory.
+         * @param maxEntries Upper bound for the number of cached textures.
+         */
+        explicit TextTextureCache(SDL_Renderer *renderer,
+                                  std::size_t memoryBudget = DefaultMemoryBudget,
+                                  std::size_t maxEntries = DefaultMaxEntries);
+        ~TextTextureCache();
+
+        TextTextureCache(const TextTextureCache &) = delete;
+        TextTextureCache &operator=(const TextTextureCache &) = delete;
+
+        /**
+         * @brief Returns the texture for a text run, rasterizing it on a miss.
+         *
+         * @param font The font to render with.
+         * @param text The UTF-8 text.
+         * @param color The text color.
+         * @param outW Receives the texture width (may be nullptr).
+         * @param outH Receives the texture height (may be nullptr).
+         * @return The cached texture, or nullptr if rendering failed. The
+         * texture stays owned by the cache and is valid until the next call
+         * to acquire(), removeFont() or clear().
+         */
+        SDL_Texture *acquire(TTF_Font *font, const std::string &text,
+                             Squidl::Utils::Color color, int *outW = nullptr,
+                             int *outH = nullptr);
+
+        /**
+         * @brief Destroys every cached texture rendered with the given font.
+         */
+        void removeFont(TTF_Font *font);
+
+        /**
+         * @brief Destroys every cached texture.
+         */
+        void clear();
+
+        void setMemoryBudget(std::size_t bytes);
+        std::size_t getMemoryBudget() const { return m_memoryBudget; }
+
+        void setMaxEntries(std::size_t count);
+        std::size_t getMaxEntries() const { return m_maxEntries; }
+
+        const TextCacheStats &getStats() const { return m_stats; }
+
+        /**
+         * @brief Resets the hit/miss/eviction counters (entries and bytes are
+         * left untouched).
+         */
+        void resetCounters();
+
+      private:
+        struct KeyView {
+            TTF_Font *font;
+            int style;
+            Uint32 color;
+            std::string_view text;
+
+            bool operator==(const KeyView &other) const {
+                return font == other.font && style == other.style &&
+                       color == other.color && text == other.text;
+            }
+        };
+
+        struct KeyHash {
+            std::size_t operator()(const KeyView &key) const;
+        };
+
+        struct Entry {
+            TTF_Font *font;
+            int style;
+            Uint32 color;
+            std::string text; // Owns the characters the index key points to
+            SDL_Texture *texture;
+            int w, h;
+            std::size_t bytes;
+        };
+
+        using EntryList = std::list<Entry>;
+
+        void trim();
+        void evictLeastRecent();
+        void destroyEntry(EntryList::iterator it);
+
+        SDL_Renderer *m_sdlRenderer; // Not owned
+        std::size_t m_memoryBudget;
+        std::size_t m_maxEntries;
+
+        // Front of the list is the most recently used entry
+        EntryList m_entries;
+        std::unordered_map<KeyView, EntryList::iterator, KeyHash> m_index;
+
+        TextCacheStats m_stats;
+    };
+
+} // namespace Squidl::Renderers
@@ -0,0 +1,118 @@
+// include/Squidl/renderers/TextureAtlas.h
+#pragma once
+
+#include "Squidl/SquidlConfig.h"        // For SQUIDL_API
+#include "Squidl/utils/SkylinePacker.h" // For atlas page layout
+#include <SDL.h>                        // For SDL_Renderer, SDL_Texture
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Squidl::Renderers {
+
+    /**
+     * @brief Part of an atlas page holding one image. Pass texture and
+     * &rect as the texture and srcRect of IRenderer::drawTexture().
+     * @ingroup Renderers
+     */
+    struct SQUIDL_API AtlasRegion {
+        SDL_Texture *texture = nullptr; // Atlas page, owned by the atlas
+        SDL_Rect rect{0, 0, 0, 0};
+
+        explicit operator bool() const { return texture != nullptr; }
+    };
+
+    /**
+     * @brief Counters describing the state of a TextureAtlas.
+     * @ingroup Renderers
+     */
+    struct SQUIDL_API TextureAtlasStats {
+        std::size_t images = 0;   // Images stored in the atlas
+        std::size_t pages = 0;    // Atlas textures allocated
+        std::size_t rejected = 0; // Images that could not be added
+        float occupancy = 0.0f;   // Covered fraction of all pages
+    };
+
+    /**
+     * @brief Packs small images (icons, UI sprites) into a few large
+     * textures.
+     * @ingroup Renderers
+     * Images are placed with a SkylinePacker; a page that is full starts a
+     * new one. Each image is surrounded by a copy of its edge pixels, so
+     * linear filtering at the region border never samples a neighbour.
+     *
+     * Regions of one page share a texture, so SDL2Renderer batches
+     * consecutive drawTexture() calls from it into a single draw call.
+     *
+     * @note Pages are destroyed with the atlas, which therefore has to go
+     * before the SDL_Renderer, and no element may draw a region after it.
+     */
+    class SQUIDL_API TextureAtlas {
+      public:
+        static constexpr int DefaultPageSize = 1024;
+
+        /**
+         * @brief Constructor.
+         * @param renderer The SDL_Renderer pages are created for. Not owned.
+         * @param pageSize Width and height of each atlas page texture.
+         */
+        explicit TextureAtlas(SDL_Renderer *renderer,
+                              int pageSize = DefaultPageSize);
+        ~TextureAtlas();
+
+        TextureAtlas(const TextureAtlas &) = delete;
+        TextureAtlas &operator=(const TextureAtlas &) = delete;
+
+        /**
+         * @brief Copies an image into the atlas.
+         * @param name Key of the image; adding a name again returns the
+         * region stored first.
+         * @param surface The pixels. Not owned, may be freed afterwards.
+         * @return The region, or an empty one if the image is larger than a
+         * page or could not be converted or uploaded.
+         */
+        AtlasRegion add(const std::string &name, SDL_Surface *surface);
+
+        /**
+         * @brief Loads an image file with IMG_Load and adds it under its
+         * path.
+         */
+        AtlasRegion addFromFile(const std::string &path);
+
+        /**
+         * @brief Loads an image from a stream (e.g. ResourceManager::openRW)
+         * and adds it. The stream is always closed.
+         */
+        AtlasRegion addFromRW(const std::string &name, SDL_RWops *rw);
+
+        /**
+         * @brief Returns the region of an image added before, or an empty
+         * one.
+         */
+        AtlasRegion find(const std::string &name) const;
+
+        /**
+         * @brief Destroys every page and forgets every region.
+         */
+        void clear();
+
+        TextureAtlasStats getStats() const;
+
+      private:
+        struct Page {
+            SDL_Texture *texture = nullptr;
+            Squidl::Utils::SkylinePacker packer;
+        };
+
+        bool addPage();
+
+        SDL_Renderer *m_sdlRenderer; // Not owned
+        int m_pageSize;
+        std::vector<Page> m_pages;
+        std::unordered_map<std::string, AtlasRegion> m_regions;
+        std::vector<Uint32> m_pixels; // Scratch for the padded image
+        std::size_t m_rejected = 0;
+    };
+
+} // namespace Squidl::Renderers
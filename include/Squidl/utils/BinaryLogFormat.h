@@ -0,0 +1,80 @@
+// include/Squidl/utils/BinaryLogFormat.h
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+
+namespace Squidl::Utils::BinaryLog {
+
+    /**
+     * @file BinaryLogFormat.h
+     * @brief Раскладка двоичного файла лога (BinaryLogSink, SquidlLogDecode).
+     *
+     * Файл имеет фиксированный размер и состоит из трёх частей:
+     *
+     *   [FileHeader][таблица мест вызова][кольцо записей]
+     *
+     * Таблица мест вызова дописывается при первой встрече каждого
+     * LogLocation::id: LocationEntry, затем путь к файлу, выравнивание до 4.
+     * Если таблица заполнена, записи хранят только id.
+     *
+     * Кольцо записей: RecordHeader, затем аргументы в кодировке LogArgs,
+     * выравнивание до 8. Запись, не помещающаяся до конца кольца, пишется с
+     * его начала (хвост помечается RecordHeader с size == 0, если для него
+     * есть место). После переполнения самые старые записи затираются;
+     * декодер ищет первую целую запись после writeOffset по RecordMagic.
+     * Записи больше половины кольца не пишутся, а учитываются в
+     * droppedCount.
+     *
+     * Все числа в порядке байтов машины (little-endian на поддерживаемых
+     * платформах).
+     */
+
+    constexpr char FileMagic[8] = {'S', 'Q', 'L', 'O', 'G', 'B', 'N', '1'};
+    constexpr std::uint32_t FormatVersion = 2;
+    constexpr std::uint32_t RecordMagic = 0x52514C53u; // "SLQR"
+    constexpr std::uint32_t RecordAlignment = 8;
+
+    struct FileHeader {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t headerSize;
+        std::uint64_t fileSize;
+        std::uint64_t locationsOffset;
+        std::uint64_t locationsSize;
+        std::uint64_t locationsUsed;
+        std::uint64_t ringOffset;
+        std::uint64_t ringSize;
+        std::uint64_t writeOffset;  // Смещение следующей записи в кольце
+        std::uint64_t wrapCount;    // Сколько раз кольцо начиналось заново
+        std::uint64_t recordCount;  // Всего записано (включая затёртые)
+        std::uint64_t droppedCount; // Отброшено как слишком большие
+    };
+
+    struct LocationEntry {
+        std::uint32_t id;
+        std::uint32_t line;
+        std::uint32_t fileLength; // Длина пути, байты следуют сразу за ним
+    };
+
+    struct RecordHeader {
+        std::uint32_t magic; // RecordMagic
+        std::uint32_t size;  // Полный размер с выравниванием; 0 - конец
+                             // кольца, продолжение с его начала
+        std::uint64_t timestampNs; // Наносекунды от эпохи Unix
+        std::uint32_t locationId;
+        std::uint32_t thread;
+        std::uint32_t argsSize;
+        std::uint8_t level; // LogLevel
+        std::uint8_t reserved[3];
+    };
+
+    static_assert(std::is_trivially_copyable_v<FileHeader>);
+    static_assert(sizeof(RecordHeader) % RecordAlignment == 0);
+
+    constexpr std::uint64_t alignUp(std::uint64_t value,
+                                    std::uint64_t alignment) {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+} // namespace Squidl::Utils::BinaryLog
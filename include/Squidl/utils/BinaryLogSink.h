@@ -0,0 +1,54 @@
+// include/Squidl/utils/BinaryLogSink.h
+#pragma once
+
+#include "Squidl/SquidlConfig.h"         // Для SQUIDL_API
+#include "Squidl/utils/BinaryLogFormat.h" // Для BinaryLog::FileHeader
+#include "Squidl/utils/LogSink.h"         // Для LogSink
+#include "Squidl/utils/MappedFile.h"      // Для MappedFile
+#include <cstddef>
+#include <string>
+#include <unordered_set>
+
+namespace Squidl::Utils {
+
+    /**
+     * @brief Структурированный двоичный лог в отображённом в память файле.
+     * @ingroup Utils
+     * Записи фиксированной раскладки (время, уровень, id места вызова,
+     * аргументы LogArgs) копируются в кольцо внутри файла постоянного
+     * размера без форматирования в текст и без системных вызовов на запись;
+     * страницы сбрасывает ОС, flush() лишь планирует запись. При
+     * переполнении затираются самые старые записи, поэтому файл не растёт и
+     * не изнашивает флеш-память сверх своего размера.
+     *
+     * Формат описан в BinaryLogFormat.h, читать файл - утилитой
+     * tools/SquidlLogDecode.
+     */
+    class SQUIDL_API BinaryLogSink : public LogSink {
+      public:
+        /**
+         * @param path Путь к файлу (перезаписывается).
+         * @param fileSize Полный размер файла.
+         * @param locationsSize Размер таблицы мест вызова внутри файла.
+         */
+        explicit BinaryLogSink(const std::string &path,
+                               std::size_t fileSize = 4u << 20,
+                               std::size_t locationsSize = 64u << 10);
+        ~BinaryLogSink() override;
+
+        bool isOpen() const { return m_header != nullptr; }
+
+        void write(const LogRecord &record) override;
+        void flush() override;
+
+      private:
+        void writeLocation(const LogLocation &location);
+
+        MappedFile m_file;
+        BinaryLog::FileHeader *m_header = nullptr;
+        std::uint8_t *m_locations = nullptr;
+        std::uint8_t *m_ring = nullptr;
+        std::unordered_set<std::uint32_t> m_knownLocations;
+    };
+
+} // namespace Squidl::Utils
@@ -41,6 +41,12 @@ namespace Squidl::Utils {
                          static_cast<Uint8>(std::fmax(0.0f, new_b)), a);
         }
 
+        bool operator==(const Color &other) const {
+            return r == other.r && g == other.g && b == other.b &&
+                   a == other.a;
+        }
+        bool operator!=(const Color &other) const { return !(*this == other); }
+
         // Conversion operator to SDL_Color
         operator SDL_Color() const { return {r, g, b, a}; }
 
@@ -0,0 +1,186 @@
+// include/Squidl/utils/LogArgs.h
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>  // Для std::snprintf
+#include <cstring> // Для std::memcpy
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace Squidl::Utils {
+
+    /**
+     * @brief Тип аргумента в двоичной записи лога.
+     * @ingroup Utils
+     */
+    enum class LogArgType : std::uint8_t {
+        Int = 1,    // int64
+        UInt = 2,   // uint64
+        Float = 3,  // double
+        Bool = 4,   // uint8
+        Char = 5,   // char
+        String = 6, // uint32 длина + байты
+        Pointer = 7 // uint64
+    };
+
+    /**
+     * @brief Двоичное кодирование аргументов сообщения лога.
+     * @ingroup Utils
+     * Аргументы `SQUIDL_LOG_* << a << b` не форматируются в месте вызова, а
+     * дописываются в буфер как тег типа и значение (в порядке байтов
+     * машины, little-endian на поддерживаемых платформах). Текст собирается
+     * позже приёмником - в асинхронном режиме в фоновом потоке - или не
+     * собирается вовсе (BinaryLogSink). Типы без прямого кодирования
+     * форматируются через operator<< и сохраняются строкой.
+     *
+     * Заголовок самодостаточен и используется утилитой SquidlLogDecode.
+     */
+    struct LogArgs {
+        using Buffer = std::vector<std::uint8_t>;
+
+        template <typename T> static void append(Buffer &out, const T &value) {
+            using U = std::decay_t<T>;
+            if constexpr (std::is_same_v<U, bool>) {
+                appendTagged(out, LogArgType::Bool,
+                             static_cast<std::uint8_t>(value ? 1 : 0));
+            } else if constexpr (std::is_same_v<U, char> ||
+                                 std::is_same_v<U, signed char> ||
+                                 std::is_same_v<U, unsigned char>) {
+                // std::ostream тоже выводит (u)int8_t как символ
+                appendTagged(out, LogArgType::Char, static_cast<char>(value));
+            } else if constexpr (std::is_integral_v<U> && std::is_signed_v<U>) {
+                appendTagged(out, LogArgType::Int,
+                             static_cast<std::int64_t>(value));
+            } else if constexpr (std::is_integral_v<U>) {
+                appendTagged(out, LogArgType::UInt,
+                             static_cast<std::uint64_t>(value));
+            } else if constexpr (std::is_floating_point_v<U>) {
+                appendTagged(out, LogArgType::Float,
+                             static_cast<double>(value));
+            } else if constexpr (std::is_array_v<T> &&
+                                 std::is_same_v<std::remove_cv_t<
+                                                    std::remove_extent_t<T>>,
+                                                char>) {
+                appendString(out, std::string_view(value)); // Литерал
+            } else if constexpr (std::is_same_v<U, const char *> ||
+                                 std::is_same_v<U, char *>) {
+                appendString(out, value ? std::string_view(value)
+                                        : std::string_view("(null)"));
+            } else if constexpr (std::is_convertible_v<const U &,
+                                                       std::string_view>) {
+                appendString(out, std::string_view(value));
+            } else if constexpr (std::is_pointer_v<U>) {
+                appendTagged(out, LogArgType::Pointer,
+                             static_cast<std::uint64_t>(
+                                 reinterpret_cast<std::uintptr_t>(value)));
+            } else {
+                std::ostringstream os;
+                os << value;
+                appendString(out, os.str());
+            }
+        }
+
+        static void appendString(Buffer &out, std::string_view s) {
+            const auto length = static_cast<std::uint32_t>(s.size());
+            appendTagged(out, LogArgType::String, length);
+            out.insert(out.end(), s.begin(), s.end());
+        }
+
+        /**
+         * @brief Дописывает аргументы из data в текстовом виде (как их
+         * вывел бы std::ostream с настройками по умолчанию).
+         * @return false, если буфер повреждён (остаток пропускается).
+         */
+        static bool format(const std::uint8_t *data, std::size_t size,
+                           std::string &out) {
+            std::size_t pos = 0;
+            char number[64];
+            while (pos < size) {
+                const auto type = static_cast<LogArgType>(data[pos++]);
+                switch (type) {
+                case LogArgType::Int: {
+                    std::int64_t v;
+                    if (!read(data, size, pos, v))
+                        return false;
+                    out += std::to_string(v);
+                    break;
+                }
+                case LogArgType::UInt: {
+                    std::uint64_t v;
+                    if (!read(data, size, pos, v))
+                        return false;
+                    out += std::to_string(v);
+                    break;
+                }
+                case LogArgType::Float: {
+                    double v;
+                    if (!read(data, size, pos, v))
+                        return false;
+                    std::snprintf(number, sizeof(number), "%g", v);
+                    out += number;
+                    break;
+                }
+                case LogArgType::Bool: {
+                    std::uint8_t v;
+                    if (!read(data, size, pos, v))
+                        return false;
+                    out += v ? '1' : '0';
+                    break;
+                }
+                case LogArgType::Char: {
+                    char v;
+                    if (!read(data, size, pos, v))
+                        return false;
+                    out += v;
+                    break;
+                }
+                case LogArgType::String: {
+                    std::uint32_t length;
+                    if (!read(data, size, pos, length) || size - pos < length)
+                        return false;
+                    out.append(reinterpret_cast<const char *>(data + pos),
+                               length);
+                    pos += length;
+                    break;
+                }
+                case LogArgType::Pointer: {
+                    std::uint64_t v;
+                    if (!read(data, size, pos, v))
+                        return false;
+                    std::snprintf(number, sizeof(number), "0x%llx",
+                                  static_cast<unsigned long long>(v));
+                    out += number;
+                    break;
+                }
+                default:
+                    return false;
+                }
+            }
+            return true;
+        }
+
+      private:
+        template <typename V>
+        static void appendTagged(Buffer &out, LogArgType type, V value) {
+            const std::size_t at = out.size();
+            out.resize(at + 1 + sizeof(V));
+            out[at] = static_cast<std::uint8_t>(type);
+            std::memcpy(out.data() + at + 1, &value, sizeof(V));
+        }
+
+        template <typename V>
+        static bool read(const std::uint8_t *data, std::size_t size,
+                         std::size_t &pos, V &value) {
+            if (size - pos < sizeof(V))
+                return false;
+            std::memcpy(&value, data + pos, sizeof(V));
+            pos += sizeof(V);
+            return true;
+        }
+    };
+
+} // namespace Squidl::Utils
@@ -0,0 +1,161 @@
+// include/Squidl/utils/LogSink.h
+#pragma once
+
+#include "Squidl/SquidlConfig.h" // Для SQUIDL_API
+#include "Squidl/utils/LogArgs.h"  // Для LogArgs
+#include <chrono>                // Для std::chrono
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+namespace Squidl::Utils {
+
+    // Внутри пространства имен Squidl::Utils
+    namespace ConsoleColors {
+        const std::string RESET = "\033[0m";
+        const std::string RED = "\033[31m";
+        const std::string GREEN = "\033[32m";
+        const std::string YELLOW = "\033[33m";
+        const std::string BLUE = "\033[34m";
+        const std::string CYAN = "\033[36m";
+        const std::string MAGENTA = "\033[35m";
+        const std::string BRIGHT_RED = "\033[91m";
+        const std::string BRIGHT_YELLOW = "\033[93m";
+    } // namespace ConsoleColors
+
+    /**
+     * @brief Уровни логирования.
+     * @ingroup Utils
+     */
+    enum class LogLevel { Debug, Info, Warning, Error, Fatal };
+
+    /**
+     * @brief Стабильный идентификатор места вызова (FNV-1a от "файл:строка").
+     * Вычисляется при компиляции макросами SQUIDL_LOG_*.
+     */
+    constexpr std::uint32_t logLocationId(const char *file, int line) {
+        std::uint32_t hash = 2166136261u;
+        for (; *file; ++file)
+            hash = (hash ^ static_cast<std::uint8_t>(*file)) * 16777619u;
+        hash = (hash ^ static_cast<std::uint8_t>(':')) * 16777619u;
+        for (int i = 0; i < 4; ++i) {
+            hash = (hash ^ static_cast<std::uint8_t>(line & 0xFF)) * 16777619u;
+            line >>= 8;
+        }
+        return hash;
+    }
+
+    /**
+     * @brief Место вызова SQUIDL_LOG_*.
+     * @ingroup Utils
+     */
+    struct LogLocation {
+        const char *file = nullptr; // Строковый литерал __FILE__
+        int line = 0;
+        std::uint32_t id = 0; // 0 - место неизвестно
+    };
+
+    /**
+     * @brief Одна запись лога.
+     * @ingroup Utils
+     * Запись создаётся в потоке, вызвавшем логирование, а форматируется
+     * (время, уровень, цвет, сами аргументы) уже приёмником - в асинхронном
+     * режиме в фоновом потоке.
+     */
+    struct LogRecord {
+        LogLevel level = LogLevel::Info;
+        std::chrono::system_clock::time_point time;
+        std::uint32_t thread = 0; // Короткий номер потока, начиная с 1
+        LogLocation location;
+        LogArgs::Buffer args; // Аргументы, закодированные LogArgs
+
+        // Текст сообщения, собранный из аргументов
+        std::string formatMessage() const {
+            std::string text;
+            LogArgs::format(args.data(), args.size(), text);
+            return text;
+        }
+    };
+
+    /**
+     * @brief Приёмник записей лога.
+     * @ingroup Utils
+     * Logger вызывает write() под собственной блокировкой, поэтому приёмнику
+     * не нужна своя синхронизация.
+     */
+    class SQUIDL_API LogSink {
+      public:
+        virtual ~LogSink() = default;
+
+        virtual void write(const LogRecord &record) = 0;
+        virtual void flush() {}
+
+        // "2025-01-31 12:00:00"
+        static std::string formatTime(std::chrono::system_clock::time_point t);
+        static const char *levelToString(LogLevel level);
+    };
+
+    /**
+     * @brief Цветной вывод в консоль (std::cout) - поведение по умолчанию.
+     * @ingroup Utils
+     */
+    class SQUIDL_API ConsoleLogSink : public LogSink {
+      public:
+        explicit ConsoleLogSink(bool colored = true) : m_colored(colored) {}
+
+        void write(const LogRecord &record) override;
+        void flush() override;
+
+      private:
+        bool m_colored;
+    };
+
+    /**
+     * @brief Запись лога в текстовый файл.
+     * @ingroup Utils
+     */
+    class SQUIDL_API FileLogSink : public LogSink {
+      public:
+        /**
+         * @param path Путь к файлу.
+         * @param append Дописывать в существующий файл, а не перезаписывать.
+         */
+        explicit FileLogSink(const std::string &path, bool append = true);
+
+        bool isOpen() const { return m_file.is_open(); }
+
+        void write(const LogRecord &record) override;
+        void flush() override;
+
+      protected:
+        // Записывает одну строку, возвращает её длину в байтах
+        std::size_t writeLine(const LogRecord &record);
+
+        std::string m_path;
+        std::ofstream m_file;
+    };
+
+    /**
+     * @brief Файл лога с ротацией по размеру.
+     * @ingroup Utils
+     * Когда файл превышает maxBytes, он переименовывается в path.1 (старые
+     * копии сдвигаются до path.<maxFiles>, самая старая удаляется), и запись
+     * продолжается в новый файл.
+     */
+    class SQUIDL_API RotatingFileLogSink : public FileLogSink {
+      public:
+        RotatingFileLogSink(const std::string &path, std::size_t maxBytes,
+                            std::size_t maxFiles);
+
+        void write(const LogRecord &record) override;
+
+      private:
+        void rotate();
+
+        std::size_t m_maxBytes;
+        std::size_t m_maxFiles;
+        std::size_t m_size = 0;
+    };
+
+} // namespace Squidl::Utils
@@ -1,84 +1,105 @@
 // include/Squidl/utils/Logger.h
 #pragma once
 
-#include "Squidl/SquidlConfig.h" // Для SQUIDL_API
-#include <chrono>                // Для std::chrono
-#include <iomanip>               // Для std::put_time
-#include <iostream>
+#include "Squidl/SquidlConfig.h"  // Для SQUIDL_API
+#include "Squidl/utils/LogSink.h" // Для LogLevel, LogRecord, LogSink
+#include <atomic> // Для std::atomic
+#include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <sstream>
 #include <string>
+#include <type_traits> // Для std::integral_constant
 
 namespace Squidl::Utils {
 
-    // Внутри пространства имен Squidl::Utils
-    namespace ConsoleColors {
-        const std::string RESET = "\033[0m";
-        const std::string RED = "\033[31m";
-        const std::string GREEN = "\033[32m";
-        const std::string YELLOW = "\033[33m";
-        const std::string BLUE = "\033[34m";
-        const std::string CYAN = "\033[36m";
-        const std::string MAGENTA = "\033[35m";
-        const std::string BRIGHT_RED = "\033[91m";
-        const std::string BRIGHT_YELLOW = "\033[93m";
-    } // namespace ConsoleColors
+    /**
+     * @brief Что делать с записью, когда очередь асинхронного лога полна.
+     * @ingroup Utils
+     */
+    enum class LogOverflowPolicy {
+        Block,      // Ждать освобождения места (лог не теряется)
+        DropNewest, // Отбросить новую запись
+        DropOldest  // Вытеснить самую старую запись из очереди
+    };
 
     /**
-     * @brief Уровни логирования.
+     * @brief Настройки асинхронного режима логирования.
      * @ingroup Utils
      */
-    enum class LogLevel { Debug, Info, Warning, Error, Fatal };
+    struct LogAsyncOptions {
+        std::size_t capacity = 8192; // Округляется до степени двойки
+        LogOverflowPolicy overflow = LogOverflowPolicy::DropNewest;
+    };
 
     // --- Предварительное объявление класса Logger ---
-    // Правильный синтаксис предварительного объявления внутри пространства имен
-    class Logger; // <--- ИСПРАВЛЕНО: УБРАНО "Squidl::Utils::"
+    class Logger;
 
-    // --- Вспомогательный класс для добавления std::endl в конце ---
+    // --- Вспомогательный класс для потоковой записи одного сообщения ---
+    // Собирает аргументы (LogArgs, без форматирования в текст) и в
+    // деструкторе передаёт запись в Logger::submit. Отфильтрованные по
+    // уровню сообщения ничего не делают
     class SQUIDL_API LogStreamProxy {
       public:
-        // Объявляем конструктор и деструктор, но определяем их out-of-line
-        LogStreamProxy(std::ostream &os, LogLevel level);
+        explicit LogStreamProxy(LogLevel level,
+                                const LogLocation &location = {});
         ~LogStreamProxy();
 
+        LogStreamProxy(const LogStreamProxy &) = delete;
+        LogStreamProxy &operator=(const LogStreamProxy &) = delete;
+
         // Перегрузка оператора <<, чтобы можно было писать в прокси
         template <typename T> LogStreamProxy &operator<<(const T &value) {
-            if (!m_os.fail()) { // Пишем только если поток не в состоянии ошибки
-                m_os << value;
+            if (m_enabled) {
+                LogArgs::append(m_args, value);
             }
             return *this;
         }
 
-        // Перегрузка для манипуляторов потока, таких как std::flush
-        LogStreamProxy &operator<<(std::ostream &(*manip)(std::ostream &)) {
-            if (!m_os.fail()) {
-                m_os << manip;
-            }
+        // Манипуляторы потока (std::endl, std::flush) игнорируются: каждое
+        // сообщение и так пишется отдельной строкой
+        LogStreamProxy &operator<<(std::ostream &(*)(std::ostream &)) {
             return *this;
         }
 
       private:
-        std::ostream &m_os;
         LogLevel m_level;
+        bool m_enabled;
+        LogLocation m_location;
+        LogArgs::Buffer m_args;
     };
 
     /**
-     * @brief Простая утилита для логирования сообщений в консоль.
+     * @brief Утилита для логирования сообщений.
      * @ingroup Utils
+     * Сообщения передаются приёмникам (LogSink); по умолчанию это цветной
+     * вывод в консоль. В синхронном режиме запись форматируется и пишется в
+     * вызывающем потоке. В асинхронном режиме (enableAsync) запись лишь
+     * кладётся в lock-free очередь (много производителей, один потребитель),
+     * а форматирует и пишет её фоновый поток, поэтому логирование не
+     * задерживает кадр.
      */
     class SQUIDL_API Logger {
-        // --- ОБЪЯВЛЯЕМ LogStreamProxy ДРУЖЕСТВЕННЫМ КЛАССОМ ---
-        // Это дает LogStreamProxy доступ к приватным членам Logger, таким как
-        // s_currentLogLevel
-        friend class LogStreamProxy; // <--- ДОБАВЛЕНО
-
       public:
         // Устанавливает минимальный уровень для вывода сообщений
-        static void setLogLevel(LogLevel level) { s_currentLogLevel = level; }
+        static void setLogLevel(LogLevel level) {
+            s_currentLogLevel.store(level, std::memory_order_relaxed);
+        }
 
-        static LogLevel getLogLevel() { return s_currentLogLevel; }
+        static LogLevel getLogLevel() {
+            return s_currentLogLevel.load(std::memory_order_relaxed);
+        }
+
+        // Уровень не вырезан на этапе компиляции (SQUIDL_MIN_LOG_LEVEL)
+        static constexpr bool isCompiledIn(LogLevel level) {
+            return static_cast<int>(level) >= SQUIDL_MIN_LOG_LEVEL;
+        }
 
-        // Методы для логирования сообщений разных уровней (теперь используют
-        // Stream)
+        static bool isEnabled(LogLevel level) {
+            return isCompiledIn(level) && level >= getLogLevel();
+        }
+
+        // Методы для логирования сообщений разных уровней
         static void Debug(const std::string &message) {
             log(LogLevel::Debug, message);
         }
@@ -96,132 +117,87 @@ namespace Squidl::Utils {
         }
 
         // Метод, возвращающий прокси-объект для потоковой записи
-        static LogStreamProxy Stream(LogLevel level);
+        static LogStreamProxy Stream(LogLevel level,
+                                     const LogLocation &location = {}) {
+            return LogStreamProxy(level, location);
+        }
 
-        // Эти функции должны быть доступны для LogStreamProxy и других
-        // внутренних нужд
-        static std::string getTimestamp();
-        static std::string levelToString(LogLevel level);
+        // ------------------------------ Приёмники -------------------------
+        /**
+         * @brief Добавляет приёмник. Пока не добавлен ни один, используется
+         * ConsoleLogSink.
+         */
+        static void addSink(std::shared_ptr<LogSink> sink);
+        static void removeSink(const std::shared_ptr<LogSink> &sink);
+        static void clearSinks();
+
+        // ------------------------- Асинхронный режим ----------------------
+        /**
+         * @brief Запускает фоновый поток записи.
+         * Повторный вызов перезапускает поток с новыми настройками (записи
+         * из старой очереди предварительно дописываются).
+         */
+        static void enableAsync(const LogAsyncOptions &options = {});
+
+        /**
+         * @brief Дописывает очередь и останавливает фоновый поток;
+         * дальше запись идёт синхронно.
+         */
+        static void disableAsync();
+        static bool isAsync();
+
+        /**
+         * @brief Ждёт, пока все поставленные записи будут записаны, и
+         * сбрасывает буферы приёмников. Fatal-сообщения делают это сами.
+         */
+        static void flush();
+
+        /**
+         * @brief Количество записей, потерянных из-за переполнения очереди.
+         */
+        static std::uint64_t getDroppedCount();
+
+        /**
+         * @brief Передаёт готовую запись приёмникам (напрямую или через
+         * очередь).
+         */
+        static void submit(LogRecord &&record);
 
       private:
-        // s_currentLogLevel теперь доступен LogStreamProxy благодаря
-        // friend-объявлению
-        static LogLevel s_currentLogLevel;
-        static std::ostringstream
-            s_nullStream; // Поток для отфильтрованных сообщений
-
-        // Внутренний метод log, который теперь также использует
-        // Stream/LogStreamProxy
-        static void log(LogLevel level, const std::string &message);
-    };
-
-    // --- Реализация статических членов Logger и методов LogStreamProxy
-    // (ОПРЕДЕЛЕНИЯ ПОСЛЕ КЛАССА Logger) ---
-
-    // Инициализация статических членов Logger (должны быть определены после
-    // класса Logger)
-    inline LogLevel Logger::s_currentLogLevel =
-        LogLevel::Info; // По умолчанию Info
-    inline std::ostringstream
-        Logger::s_nullStream; // Инициализируем пустой поток
-
-    // Реализация статических вспомогательных функций Logger
-    inline std::string Logger::getTimestamp() {
-        auto now = std::chrono::system_clock::now();
-        auto in_time_t = std::chrono::system_clock::to_time_t(now);
-        std::stringstream ss;
-        ss << std::put_time(std::localtime(&in_time_t), "%Y-%m-%d %H:%M:%S");
-        return ss.str();
-    }
-
-    inline std::string Logger::levelToString(LogLevel level) {
-        switch (level) {
-        case LogLevel::Debug:
-            return "DEBUG";
-        case LogLevel::Info:
-            return "INFO";
-        case LogLevel::Warning:
-            return "WARNING";
-        case LogLevel::Error:
-            return "ERROR";
-        case LogLevel::Fatal:
-            return "FATAL";
-        default:
-            return "UNKNOWN";
-        }
-    }
+        // Читается и из фоновых потоков, поэтому атомарный
+        static std::atomic<LogLevel> s_currentLogLevel;
 
-    // Реализация метода log класса Logger
-    inline void Logger::log(LogLevel level, const std::string &message) {
-        if (level >= s_currentLogLevel) {
-            Logger::Stream(level) << message;
-        }
-    }
-
-    // Реализация метода Stream класса Logger
-    inline LogStreamProxy Logger::Stream(LogLevel level) {
-        if (level < s_currentLogLevel) {
-            s_nullStream.str("");
-            return LogStreamProxy(s_nullStream, level);
-        }
-        return LogStreamProxy(std::cout, level);
-    }
-
-    // --- ОПРЕДЕЛЕНИЕ МЕТОДОВ LogStreamProxy ---
-    // Эти методы должны быть определены ПОСЛЕ класса Logger, чтобы он был
-    // известен
-
-    // В LogStreamProxy::LogStreamProxy (конструктор)
-    inline LogStreamProxy::LogStreamProxy(std::ostream &os, LogLevel level)
-        : m_os(os), m_level(level) {
-        if (m_level < Logger::s_currentLogLevel) {
-            m_os.setstate(std::ios_base::badbit);
-        } else {
-            // Выбор цвета в зависимости от уровня
-            std::string colorCode = ConsoleColors::RESET;
-            switch (m_level) {
-            case LogLevel::Debug:
-                colorCode = ConsoleColors::CYAN;
-                break;
-            case LogLevel::Info:
-                colorCode = ConsoleColors::GREEN;
-                break;
-            case LogLevel::Warning:
-                colorCode = ConsoleColors::YELLOW;
-                break;
-            case LogLevel::Error:
-                colorCode = ConsoleColors::RED;
-                break;
-            case LogLevel::Fatal:
-                colorCode = ConsoleColors::BRIGHT_RED;
-                break;
-            default:
-                break;
+        static void log(LogLevel level, const std::string &message) {
+            if (isEnabled(level)) {
+                Logger::Stream(level) << message;
             }
-            m_os << colorCode; // Устанавливаем цвет
-            m_os << "[" << Logger::getTimestamp() << "] ["
-                 << Logger::levelToString(m_level) << "] ";
         }
-    }
+    };
 
-    // В LogStreamProxy::~LogStreamProxy (деструктор)
-    inline LogStreamProxy::~LogStreamProxy() {
-        if (!m_os.fail()) {
-            m_os << ConsoleColors::RESET
-                 << std::endl; // Сбрасываем цвет и добавляем перенос строки
-        }
-    }
+    // Инициализация статических членов Logger
+    inline std::atomic<LogLevel> Logger::s_currentLogLevel{
+        LogLevel::Info}; // По умолчанию Info
 
 } // namespace Squidl::Utils
 
-// Макросы для удобного логирования (их не нужно менять!)
-#define SQUIDL_LOG_DEBUG                                                       \
-    Squidl::Utils::Logger::Stream(Squidl::Utils::LogLevel::Debug)
-#define SQUIDL_LOG_INFO                                                        \
-    Squidl::Utils::Logger::Stream(Squidl::Utils::LogLevel::Info)
-#define SQUIDL_LOG_WARNING                                                     \
-    Squidl::Utils::Logger::Stream(Squidl::Utils::LogLevel::Warning)
-#define SQUIDL_LOG_ERROR                                                       \
-    Squidl::Utils::Logger::Stream(Squidl::Utils::LogLevel::Error)
-#define SQUIDL_LOG_FATAL                                                       \
-    Squidl::Utils::Logger::Stream(Squidl::Utils::LogLevel::Fatal)
\ No newline at end of file
+// Макросы для удобного логирования.
+// Оператор вида `SQUIDL_LOG_INFO << a << b;` раскрывается в if/else: уровни
+// ниже SQUIDL_MIN_LOG_LEVEL отбрасываются компилятором целиком, а
+// отфильтрованные во время выполнения не вычисляют аргументы << вовсе.
+// Конструкция безопасна внутри if/else без фигурных скобок
+#define SQUIDL_LOG_AT(level)                                                   \
+    if constexpr (!Squidl::Utils::Logger::isCompiledIn(level)) {               \
+    } else if (!Squidl::Utils::Logger::isEnabled(level)) {                     \
+    } else                                                                     \
+        Squidl::Utils::Logger::Stream(                                         \
+            level, Squidl::Utils::LogLocation{                                 \
+                       __FILE__, __LINE__,                                     \
+                       std::integral_constant<                                 \
+                           std::uint32_t, Squidl::Utils::logLocationId(        \
+                                              __FILE__, __LINE__)>::value})
+
+#define SQUIDL_LOG_DEBUG SQUIDL_LOG_AT(Squidl::Utils::LogLevel::Debug)
+#define SQUIDL_LOG_INFO SQUIDL_LOG_AT(Squidl::Utils::LogLevel::Info)
+#define SQUIDL_LOG_WARNING SQUIDL_LOG_AT(Squidl::Utils::LogLevel::Warning)
+#define SQUIDL_LOG_ERROR SQUIDL_LOG_AT(Squidl::Utils::LogLevel::Error)
+#define SQUIDL_LOG_FATAL SQUIDL_LOG_AT(Squidl::Utils::LogLevel::Fatal)
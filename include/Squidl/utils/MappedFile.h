@@ -0,0 +1,73 @@
+// include/Squidl/utils/MappedFile.h
+#pragma once
+
+#include "Squidl/SquidlConfig.h" // For SQUIDL_API
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace Squidl::Utils {
+
+    /**
+     * @brief A file mapped into memory (mmap / MapViewOfFile).
+     * @ingroup Utils
+     * The whole file is mapped at once. Failures are reported by the return
+     * value and getError() instead of the logger, because the logger's own
+     * sinks use this class.
+     */
+    class SQUIDL_API MappedFile {
+      public:
+        MappedFile() = default;
+        ~MappedFile();
+
+        MappedFile(const MappedFile &) = delete;
+        MappedFile &operator=(const MappedFile &) = delete;
+        MappedFile(MappedFile &&other) noexcept;
+        MappedFile &operator=(MappedFile &&other) noexcept;
+
+        /**
+         * @brief Maps an existing file read-only.
+         */
+        bool openRead(const std::string &path);
+
+        /**
+         * @brief Creates (or truncates) a file of the given size and maps it
+         * read-write. The new contents are zero.
+         */
+        bool create(const std::string &path, std::size_t size);
+
+        void close();
+
+        /**
+         * @brief Writes modified pages back to the file.
+         * @param synchronous Wait for the write to finish; otherwise only
+         * schedule it.
+         */
+        bool flush(bool synchronous = true);
+
+        bool isOpen() const { return m_data != nullptr; }
+        bool isWritable() const { return m_writable; }
+        std::size_t size() const { return m_size; }
+        const std::uint8_t *data() const { return m_data; }
+        // nullptr for read-only mappings
+        std::uint8_t *writableData() { return m_writable ? m_data : nullptr; }
+        const std::string &getPath() const { return m_path; }
+        const std::string &getError() const { return m_error; }
+
+      private:
+        bool fail(const std::string &what);
+
+        std::uint8_t *m_data = nullptr;
+        std::size_t m_size = 0;
+        bool m_writable = false;
+        std::string m_path;
+        std::string m_error;
+#ifdef _WIN32
+        void *m_file = nullptr;    // HANDLE
+        void *m_mapping = nullptr; // HANDLE
+#else
+        int m_fd = -1;
+#endif
+    };
+
+} // namespace Squidl::Utils
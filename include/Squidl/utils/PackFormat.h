@@ -0,0 +1,58 @@
+// include/Squidl/utils/PackFormat.h
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+
+namespace Squidl::Utils::Pack {
+
+    /**
+     * @file PackFormat.h
+     * @brief Раскладка архива ресурсов (SquidlPack, ResourceManager).
+     *
+     *   [FileHeader][индекс][данные файлов]
+     *
+     * Индекс: для каждого файла IndexEntry, затем путь в UTF-8 без нуля в
+     * конце, выравнивание до IndexAlignment. Пути относительные, с '/' в
+     * качестве разделителя, отсортированы по возрастанию.
+     *
+     * Данные каждого файла начинаются с границы DataAlignment, чтобы
+     * отображённые в память ресурсы можно было читать напрямую, без
+     * копирования.
+     *
+     * Все числа в порядке байтов машины (little-endian на поддерживаемых
+     * платформах).
+     */
+
+    constexpr char FileMagic[8] = {'S', 'Q', 'P', 'A', 'C', 'K', '0', '1'};
+    constexpr std::uint32_t FormatVersion = 1;
+    constexpr std::uint32_t IndexAlignment = 8;
+    constexpr std::uint32_t DataAlignment = 64;
+
+    struct FileHeader {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t headerSize;
+        std::uint64_t fileSize;
+        std::uint64_t entryCount;
+        std::uint64_t indexOffset;
+        std::uint64_t indexSize;
+    };
+
+    struct IndexEntry {
+        std::uint64_t offset; // От начала архива
+        std::uint64_t size;
+        std::uint32_t pathLength; // Байты пути следуют сразу за записью
+        std::uint32_t reserved;
+    };
+
+    static_assert(std::is_trivially_copyable_v<FileHeader>);
+    static_assert(sizeof(FileHeader) % IndexAlignment == 0);
+    static_assert(sizeof(IndexEntry) % IndexAlignment == 0);
+
+    constexpr std::uint64_t alignUp(std::uint64_t value,
+                                    std::uint64_t alignment) {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+} // namespace Squidl::Utils::Pack
@@ -0,0 +1,128 @@
+// include/Squidl/utils/Profiler.h
+#pragma once
+
+#include "Squidl/SquidlConfig.h" // For SQUIDL_API, SQUIDL_PROFILER_ENABLED
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Squidl::Utils {
+
+    /**
+     * @brief One finished profiling zone.
+     * @ingroup Utils
+     */
+    struct ProfileEvent {
+        const char *name = nullptr;   // Static string, never freed
+        const void *object = nullptr; // Element/renderer the zone ran for
+        std::uint64_t startNs = 0;    // Since Profiler::now() epoch
+        std::uint64_t durationNs = 0;
+        std::uint32_t thread = 0; // Small per-thread id, starts at 1
+    };
+
+    /**
+     * @brief Frame profiler collecting scoped timing zones.
+     * @ingroup Utils
+     * Zones are timed with std::chrono::steady_clock (nanoseconds) and stored
+     * in a fixed-size lock-free ring buffer; when it is full the oldest
+     * events are overwritten. Recording is off by default: a disabled zone
+     * costs one relaxed atomic load. The buffer can be dumped as Chrome
+     * trace-event JSON (chrome://tracing, Perfetto) where every zone keeps
+     * the address of the element it ran for, so time can be attributed to a
+     * particular widget.
+     *
+     * Zones are placed with SQUIDL_PROFILE_ZONE / SQUIDL_PROFILE_ZONE_OBJ.
+     * Building with SQUIDL_PROFILER_ENABLED=0 removes them entirely.
+     */
+    class SQUIDL_API Profiler {
+      public:
+        static void setEnabled(bool enabled) {
+            s_enabled.store(enabled, std::memory_order_relaxed);
+        }
+        static bool isEnabled() {
+            return s_enabled.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Resizes the ring buffer and drops recorded events.
+         * @param events Capacity, rounded up to a power of two.
+         * @note Must not be called while zones are being recorded.
+         */
+        static void setCapacity(std::size_t events);
+        static std::size_t getCapacity();
+
+        /**
+         * @brief Nanoseconds since the profiler epoch (first use).
+         */
+        static std::uint64_t now();
+
+        static void record(const char *name, const void *object,
+                           std::uint64_t startNs, std::uint64_t endNs);
+
+        /**
+         * @brief Copies the events currently in the buffer, oldest first.
+         * Slots being written at the moment of the call are skipped.
+         */
+        static std::vector<ProfileEvent> snapshot();
+
+        /**
+         * @brief Number of events lost to ring buffer overwrites.
+         */
+        static std::uint64_t getDroppedCount();
+
+        static void clear();
+
+        /**
+         * @brief Writes the buffer as Chrome trace-event JSON.
+         * @return false if the file could not be written.
+         */
+        static bool writeChromeTrace(const std::string &path);
+
+      private:
+        static std::atomic<bool> s_enabled;
+    };
+
+    /**
+     * @brief RAII zone: records the time between construction and
+     * destruction.
+     * @ingroup Utils
+     */
+    class ProfileZone {
+      public:
+        explicit ProfileZone(const char *name, const void *object = nullptr)
+            : m_name(name), m_object(object), m_active(Profiler::isEnabled()),
+              m_start(m_active ? Profiler::now() : 0) {}
+        ~ProfileZone() {
+            if (m_active)
+                Profiler::record(m_name, m_object, m_start, Profiler::now());
+        }
+        ProfileZone(const ProfileZone &) = delete;
+        ProfileZone &operator=(const ProfileZone &) = delete;
+
+      private:
+        const char *m_name;
+        const void *m_object;
+        bool m_active;
+        std::uint64_t m_start;
+    };
+
+} // namespace Squidl::Utils
+
+#define SQUIDL_PROFILE_CONCAT_INNER(a, b) a##b
+#define SQUIDL_PROFILE_CONCAT(a, b) SQUIDL_PROFILE_CONCAT_INNER(a, b)
+
+#if SQUIDL_PROFILER_ENABLED
+// Times the rest of the enclosing scope. name must be a string literal
+#define SQUIDL_PROFILE_ZONE(name)                                              \
+    Squidl::Utils::ProfileZone SQUIDL_PROFILE_CONCAT(squidlProfileZone_,       \
+                                                     __LINE__)(name)
+// Same, attributed to an object (usually this)
+#define SQUIDL_PROFILE_ZONE_OBJ(name, object)                                  \
+    Squidl::Utils::ProfileZone SQUIDL_PROFILE_CONCAT(squidlProfileZone_,       \
+                                                     __LINE__)(name, object)
+#else
+#define SQUIDL_PROFILE_ZONE(name) ((void)0)
+#define SQUIDL_PROFILE_ZONE_OBJ(name, object) ((void)0)
+#endif
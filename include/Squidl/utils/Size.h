@@ -0,0 +1,25 @@
+// include/Squidl/utils/Size.h
+#pragma once
+
+#include "Squidl/SquidlConfig.h" // Для SQUIDL_API
+
+namespace Squidl::Utils {
+    /**
+     * @brief Размер элемента (ширина и высота) без позиции.
+     * @ingroup Utils
+     */
+    struct SQUIDL_API Size {
+        int w, h;
+
+        // Конструкторы
+        Size() : w(0), h(0) {}
+        Size(int _w, int _h) : w(_w), h(_h) {}
+
+        bool operator==(const Size &other) const {
+            return w == other.w && h == other.h;
+        }
+        bool operator!=(const Size &other) const { return !(*this == other); }
+
+        bool isEmpty() const { return w <= 0 || h <= 0; }
+    };
+} // namespace Squidl::Utils
@@ -0,0 +1,61 @@
+// include/Squidl/utils/SkylinePacker.h
+#pragma once
+
+#include "Squidl/SquidlConfig.h" // For SQUIDL_API
+#include "Squidl/utils/UIRect.h" // For Squidl::Utils::UIRect
+#include <vector>
+
+namespace Squidl::Utils {
+
+    /**
+     * @brief Packs rectangles into a fixed-size area (skyline bottom-left).
+     * @ingroup Utils
+     * Keeps the upper outline ("skyline") of everything placed so far and
+     * puts each new rectangle at the lowest position it fits in. Used to lay
+     * out atlas textures; rectangles cannot be removed individually, only the
+     * whole area can be reset.
+     */
+    class SQUIDL_API SkylinePacker {
+      public:
+        SkylinePacker(int width = 0, int height = 0);
+
+        /**
+         * @brief Clears the area and resizes it.
+         */
+        void reset(int width, int height);
+
+        /**
+         * @brief Finds a place for a rectangle of the given size.
+         * @param w Width of the rectangle.
+         * @param h Height of the rectangle.
+         * @param out Receives the placed rectangle on success.
+         * @return false if the rectangle does not fit anywhere.
+         */
+        bool insert(int w, int h, UIRect &out);
+
+        int getWidth() const { return m_width; }
+        int getHeight() const { return m_height; }
+
+        /**
+         * @brief Returns the fraction of the area covered by placed
+         * rectangles (0.0f - 1.0f).
+         */
+        float getOccupancy() const;
+
+      private:
+        struct Segment {
+            int x, y, w;
+        };
+
+        // Returns the y coordinate a w*h rectangle would get when its left
+        // edge is aligned with segment 'index', or -1 if it does not fit.
+        int fitAt(std::size_t index, int w, int h) const;
+        void addSegment(std::size_t index, const UIRect &placed);
+
+        int m_width = 0;
+        int m_height = 0;
+        long long m_usedArea = 0;
+        std::vector<Segment> m_skyline;
+    };
+
+} // namespace Squidl::Utils
@@ -4,6 +4,7 @@
 #include "Point.h"               // For Squidl::Utils::Point
 #include "Squidl/SquidlConfig.h" // For SQUIDL_API
 #include <SDL.h>                 // For SDL_Rect
+#include <algorithm>             // For std::min, std::max
 
 namespace Squidl::Utils {
 
@@ -31,6 +32,46 @@ namespace Squidl::Utils {
 
         bool contains(Point p) const { return contains(p.x, p.y); }
 
+        bool operator==(const UIRect &other) const {
+            return x == other.x && y == other.y && w == other.w &&
+                   h == other.h;
+        }
+        bool operator!=(const UIRect &other) const { return !(*this == other); }
+
+        // Check if the rectangle has no area
+        bool isEmpty() const { return w <= 0 || h <= 0; }
+
+        // Check if two rectangles overlap
+        bool intersects(const UIRect &other) const {
+            return !isEmpty() && !other.isEmpty() && x < other.x + other.w &&
+                   other.x < x + w && y < other.y + other.h &&
+                   other.y < y + h;
+        }
+
+        // Get the overlapping area (empty if the rectangles do not overlap)
+        UIRect intersection(const UIRect &other) const {
+            const int left = std::max(x, other.x);
+            const int top = std::max(y, other.y);
+            const int right = std::min(x + w, other.x + other.w);
+            const int bottom = std::min(y + h, other.y + other.h);
+            if (right <= left || bottom <= top)
+                return UIRect();
+            return UIRect(left, top, right - left, bottom - top);
+        }
+
+        // Get the smallest rectangle containing both (empty ones are ignored)
+        UIRect united(const UIRect &other) const {
+            if (isEmpty())
+                return other;
+            if (other.isEmpty())
+                return *this;
+            const int left = std::min(x, other.x);
+            const int top = std::min(y, other.y);
+            const int right = std::max(x + w, other.x + other.w);
+            const int bottom = std::max(y + h, other.y + other.h);
+            return UIRect(left, top, right - left, bottom - top);
+        }
+
         // Get top-left point
         Point getPosition() const { return {x, y}; }
 
@@ -36,12 +36,20 @@ int main() {
         SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED);
     SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
 
-    // Load font
-    TTF_Font *font = TTF_OpenFont("assets/Roboto-Regular.ttf", 18);
-    if (!font) {
+    // Assets come from the archive built by the SquidlAssets target; paths
+    // it does not contain are read as loose files
+    ResourceManager resources;
+    resources.mount("assets.sqpk");
+
+    // Load font. Further sizes of the same file share its mapping
+    FontManager fonts;
+    fonts.setResourceManager(&resources);
+    FontHandle fontHandle = fonts.load("assets/Roboto-Regular.ttf", 18);
+    if (!fontHandle) {
         std::cerr << "Failed to load font: " << TTF_GetError() << "\n";
         return 1;
     }
+    TTF_Font *font = fontHandle.get();
 
     Squidl::Utils::Logger::setLogLevel(Squidl::Utils::LogLevel::Debug);
 
@@ -59,14 +67,24 @@ int main() {
     UIContext ctx;     // Create UI context with default constructor
     ctx.setSize(w, h); // Set initial size
 
+    // Images are decoded in the background and uploaded by processUploads()
+    TextureManager textures(renderer);
+    textures.setResourceManager(&resources);
+    textures.setMipmaps(true); // Small backdrops draw downscaled levels
+
     auto backdrop = std::make_shared<Backdrop>();
     backdrop->setRect({0, 0, w, h});
     backdrop->setBorderless(true);
-    backdrop->setTextureFromFile(renderer, "assets/green-bkg.jpg");
+    backdrop->setTextureFromFile(textures, "assets/green-bkg.jpg");
     SQUIDL_LOG_INFO << u8"Контекст Создан.";
     // --- IRenderer setup ---
-    std::unique_ptr<Squidl::Core::IRenderer> uiRenderer =
+    auto sdl2Renderer =
         std::make_unique<Squidl::Renderers::SDL2Renderer>(renderer);
+    // Evicted fonts must not stay in the renderer's text caches
+    fonts.setEvictCallback(
+        [r = sdl2Renderer.get()](TTF_Font *f) { r->purgeFont(f); });
+    std::unique_ptr<Squidl::Core::IRenderer> uiRenderer =
+        std::move(sdl2Renderer);
 
     // --- Main Layout (Vertical Box Layout to hold other layouts) ---
 
@@ -252,18 +270,29 @@ int main() {
             }
         }
 
+        // Upload decoded images within a small slice of the frame
+        textures.processUploads();
+
         // Clear screen using UIRenderer
         uiRenderer->clearScreen(Color(20, 20, 20, 255));
         uiRenderer->render(backdrop, ctx); // Render backdrop
         // Render all UI elements through UIRenderer
         uiRenderer->render(mainLayout,
                            ctx); // Render the main layout and its children
+        // Submit batched shapes before presenting
+        uiRenderer->flush();
 
         SDL_RenderPresent(renderer);
     }
 
     // Clean up resources
-    TTF_CloseFont(font);
+    // The renderer releases its cached textures, so it has to go before the
+    // SDL_Renderer they belong to.
+    backdrop.reset(); // Releases its texture
+    fontHandle.reset();
+    fonts.evictUnused(); // Closes the font while the renderer can purge it
+    fonts.setEvictCallback(nullptr);
+    uiRenderer.reset();
     SDL_DestroyRenderer(renderer);
     SDL_DestroyWindow(window);
     TTF_Quit();
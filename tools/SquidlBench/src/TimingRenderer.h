@@ -0,0 +1,111 @@
+// tools/SquidlBench/src/TimingRenderer.h
+#pragma once
+
+#include "Squidl/core/IRenderer.h"
+#include <chrono>
+#include <cstddef>
+
+namespace SquidlBench {
+
+    /**
+     * @brief IRenderer decorator that forwards every call to the real
+     * renderer and accumulates the time spent inside drawText().
+     *
+     * Text rasterisation is usually the dominant part of a frame, so the
+     * benchmark reports it separately from the rest of the draw phase.
+     */
+    class TimingRenderer : public Squidl::Core::IRenderer {
+      public:
+        using Clock = std::chrono::steady_clock;
+
+        explicit TimingRenderer(Squidl::Core::IRenderer &target)
+            : m_target(target) {}
+
+        void beginFrame() {
+            m_textTime = Clock::duration::zero();
+            m_textCalls = 0;
+            m_drawCalls = 0;
+        }
+        Clock::duration getTextTime() const { return m_textTime; }
+        std::size_t getTextCalls() const { return m_textCalls; }
+        std::size_t getDrawCalls() const { return m_drawCalls; }
+
+        void render(std::shared_ptr<Squidl::Base::UIElement> rootElement,
+                    Squidl::Core::UIContext &ctx) override {
+            m_target.render(rootElement, ctx);
+        }
+        void setDrawColor(Squidl::Utils::Color color) override {
+            m_target.setDrawColor(color);
+        }
+        void clearScreen(Squidl::Utils::Color color) override {
+            m_target.clearScreen(color);
+        }
+        void drawLine(int x1, int y1, int x2, int y2,
+                      Squidl::Utils::Color color) override {
+            ++m_drawCalls;
+            m_target.drawLine(x1, y1, x2, y2, color);
+        }
+        void drawFilledRect(const Squidl::Utils::UIRect &rect,
+                            Squidl::Utils::Color color) override {
+            ++m_drawCalls;
+            m_target.drawFilledRect(rect, color);
+        }
+        void fillRoundedRect(const Squidl::Utils::UIRect &rect, int radius,
+                             Squidl::Utils::Color color) override {
+            ++m_drawCalls;
+            m_target.fillRoundedRect(rect, radius, color);
+        }
+        void drawRoundedRect(const Squidl::Utils::UIRect &rect, int radius,
+                             Squidl::Utils::Color color) override {
+            ++m_drawCalls;
+            m_target.drawRoundedRect(rect, radius, color);
+        }
+        void drawOutlineRect(const Squidl::Utils::UIRect &rect,
+                             Squidl::Utils::Color color) override {
+            ++m_drawCalls;
+            m_target.drawOutlineRect(rect, color);
+        }
+        void drawTexture(SDL_Texture *texture, const SDL_Rect *srcRect,
+                         const SDL_Rect *destRect,
+                         float opacity = 1.0f) override {
+            ++m_drawCalls;
+            m_target.drawTexture(texture, srcRect, destRect, opacity);
+        }
+        void drawText(TTF_Font *font, const std::string &text,
+                      Squidl::Utils::Color color,
+                      const Squidl::Utils::UIRect &destRect) override {
+            ++m_drawCalls;
+            ++m_textCalls;
+            const auto start = Clock::now();
+            m_target.drawText(font, text, color, destRect);
+            m_textTime += Clock::now() - start;
+        }
+        void setClipRect(const Squidl::Utils::UIRect &rect) override {
+            m_target.setClipRect(rect);
+        }
+        void resetClipRect() override { m_target.resetClipRect(); }
+        void pushClipRect(const Squidl::Utils::UIRect &rect) override {
+            m_target.pushClipRect(rect);
+        }
+        void popClipRect() override { m_target.popClipRect(); }
+        bool isRectVisible(const Squidl::Utils::UIRect &rect) const override {
+            return m_target.isRectVisible(rect);
+        }
+        SDL_Texture *createLayerTexture(int w, int h) override {
+            return m_target.createLayerTexture(w, h);
+        }
+        bool beginLayer(SDL_Texture *texture,
+                        const Squidl::Utils::UIRect &area) override {
+            return m_target.beginLayer(texture, area);
+        }
+        void endLayer() override { m_target.endLayer(); }
+        void flush() override { m_target.flush(); }
+
+      private:
+        Squidl::Core::IRenderer &m_target;
+        Clock::duration m_textTime = Clock::duration::zero();
+        std::size_t m_textCalls = 0;
+        std::size_t m_drawCalls = 0;
+    };
+
+} // namespace SquidlBench
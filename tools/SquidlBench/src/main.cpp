@@ -0,0 +1,587 @@
+// tools/SquidlBench/src/main.cpp
+//
+// Headless benchmark for the Squidl UI library.
+//
+// Builds synthetic element trees and drives them through layout, event
+// dispatch and drawing without a window: SDL runs on the dummy video driver
+// and draws through SDL_CreateSoftwareRenderer into an offscreen surface.
+// Per-phase timings (mean/p50/p95) and allocations per frame are printed at
+// the end, so regressions can be compared between builds.
+//
+// Usage:
+//   SquidlBench [--labels N] [--depth D] [--fanout C] [--inputs K] [--rows R]
+//               [--frames F] [--warmup W] [--size WxH] [--font path]
+//               [--scene all|labels|flat|nested|layered|inputs|virtual|scroll|
+//                        icons]
+//               [--trace out.json] [--alloc heap|arena]
+//
+// --alloc arena builds the scenes inside an ElementArena (see
+// Squidl/core/ElementArena.h) instead of allocating every element with
+// make_shared; the build time and allocation count are printed either way.
+//
+// --trace records profiler zones for the measured frames and writes them as
+// Chrome trace-event JSON.
+#include <SDL.h>
+#include <SDL_ttf.h>
+#include <algorithm> // For std::sort
+#include <atomic>    // For the allocation counter
+#include <chrono>    // For std::chrono::steady_clock
+#include <cmath>     // For std::sqrt
+#include <cstdio>    // For std::printf
+#include <cstdlib>   // For std::malloc, std::atoi
+#include <cstring>   // For std::strcmp
+#include <functional> // For std::function
+#include <iostream>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "Squidl/Squidl.h"
+#include "TimingRenderer.h"
+
+using namespace Squidl::Core;
+using namespace Squidl::Elements;
+using namespace Squidl::Layouts;
+using namespace Squidl::Utils;
+
+// ---------------------------------------------------------------------------
+// Allocation counting. Replacing the global operator new is the only
+// portable way to see allocations made inside the library.
+// ---------------------------------------------------------------------------
+namespace {
+    std::atomic<std::size_t> g_allocations{0};
+}
+
+void *operator new(std::size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void *p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    return std::malloc(size ? size : 1);
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+void operator delete(void *p, const std::nothrow_t &) noexcept {
+    std::free(p);
+}
+
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+
+    struct Options {
+        int labels = 1000;
+        int depth = 4;
+        int fanout = 3;
+        int inputs = 32;
+        int rows = 100000; // Items in the "virtual" scene
+        int frames = 300;
+        int warmup = 30;
+        int width = 1280;
+        int height = 720;
+        std::string font = "assets/Roboto-Regular.ttf";
+        std::string scene = "all";
+        std::string trace; // Chrome trace output, empty to disable
+        bool arena = false; // Build scenes in an ElementArena
+    };
+
+    bool parseArgs(int argc, char **argv, Options &opts) {
+        for (int i = 1; i < argc; ++i) {
+            const char *arg = argv[i];
+            const char *value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+            if (!value) {
+                std::cerr << "Missing value for " << arg << "\n";
+                return false;
+            }
+            if (!std::strcmp(arg, "--labels"))
+                opts.labels = std::atoi(value);
+            else if (!std::strcmp(arg, "--depth"))
+                opts.depth = std::atoi(value);
+            else if (!std::strcmp(arg, "--fanout"))
+                opts.fanout = std::atoi(value);
+            else if (!std::strcmp(arg, "--inputs"))
+                opts.inputs = std::atoi(value);
+            else if (!std::strcmp(arg, "--rows"))
+                opts.rows = std::atoi(value);
+            else if (!std::strcmp(arg, "--frames"))
+                opts.frames = std::atoi(value);
+            else if (!std::strcmp(arg, "--warmup"))
+                opts.warmup = std::atoi(value);
+            else if (!std::strcmp(arg, "--size")) {
+                if (std::sscanf(value, "%dx%d", &opts.width, &opts.height) !=
+                    2) {
+                    std::cerr << "Bad --size, expected WxH\n";
+                    return false;
+                }
+            } else if (!std::strcmp(arg, "--font"))
+                opts.font = value;
+            else if (!std::strcmp(arg, "--scene"))
+                opts.scene = value;
+            else if (!std::strcmp(arg, "--trace"))
+                opts.trace = value;
+            else if (!std::strcmp(arg, "--alloc")) {
+                if (!std::strcmp(value, "arena"))
+                    opts.arena = true;
+                else if (!std::strcmp(value, "heap"))
+                    opts.arena = false;
+                else {
+                    std::cerr << "Bad --alloc, expected heap or arena\n";
+                    return false;
+                }
+            }
+            else {
+                std::cerr << "Unknown option " << arg << "\n";
+                return false;
+            }
+            ++i;
+        }
+        if (opts.frames <= 0 || opts.width <= 0 || opts.height <= 0) {
+            std::cerr << "--frames and --size must be positive\n";
+            return false;
+        }
+        return true;
+    }
+
+    // ------------------------------------------------------------------
+    // Scene builders
+    // ------------------------------------------------------------------
+    struct Scene {
+        std::string name;
+        std::shared_ptr<Layout> root;
+        std::vector<std::shared_ptr<Input>> inputs;
+        std::size_t elementCount = 0;
+        // Per-frame input such as scrolling, run in the events phase
+        std::function<void(int frame)> animate;
+        // Alternate the viewport width every frame; cached layers would be
+        // redrawn on every resize
+        bool resizes = true;
+    };
+
+    std::size_t countElements(const std::shared_ptr<Squidl::Base::UIElement> &e) {
+        std::size_t n = 1;
+        if (auto layout = std::dynamic_pointer_cast<Layout>(e)) {
+            for (const auto &child : layout->getChildren())
+                n += countElements(child);
+        } else if (auto flat = std::dynamic_pointer_cast<FlatView>(e)) {
+            n += flat->getStore().size();
+        }
+        return n;
+    }
+
+    Scene buildLabels(int count, TTF_Font *font) {
+        const int columns =
+            std::max(1, static_cast<int>(std::sqrt(static_cast<double>(count))));
+        auto grid = makeElement<GridLayout>(columns, 2, 2);
+        grid->setFont(font);
+        for (int i = 0; i < count; ++i) {
+            grid->add(makeElement<Label>("Label " + std::to_string(i), 0, 0,
+                                         0, 0, font));
+        }
+        return {"labels", grid, {}, 0, {}};
+    }
+
+    // Same cell count as "labels", stored in a FlatView instead of a tree
+    Scene buildFlat(int count, TTF_Font *font) {
+        const int columns =
+            std::max(1, static_cast<int>(std::sqrt(static_cast<double>(count))));
+        auto box = makeElement<VBoxLayout>(0);
+        box->setFont(font);
+        auto view = makeElement<FlatView>(0, 0, 0, 0, font);
+        view->setManagedByChilds(true);
+        ElementStore &store = view->getStore();
+        store.reserve(static_cast<std::size_t>(count));
+        for (int i = 0; i < count; ++i) {
+            const ElementId id = store.add(InvalidElementId, {});
+            store.setText(id, "Label " + std::to_string(i));
+            store.setTextColor(id, {255, 255, 255, 255});
+        }
+        if (count > 0)
+            store.arrangeGrid(0, static_cast<std::size_t>(count), columns,
+                              {80, 20}, 2);
+        box->add(view);
+        return {"flat", box, {}, 0, {}};
+    }
+
+    std::shared_ptr<Layout> makeNestedLayout(int level) {
+        switch (level % 3) {
+        case 0:
+            return makeElement<VBoxLayout>(2);
+        case 1:
+            return makeElement<HBoxLayout>(2);
+        default:
+            return makeElement<GridLayout>(2, 2, 2);
+        }
+    }
+
+    void fillNested(const std::shared_ptr<Layout> &parent, int level,
+                    int depth, int fanout, TTF_Font *font, int &serial) {
+        for (int i = 0; i < fanout; ++i) {
+            if (level + 1 < depth) {
+                auto child = makeNestedLayout(level + 1);
+                parent->add(child);
+                fillNested(child, level + 1, depth, fanout, font, serial);
+            } else if (serial++ % 2 == 0) {
+                parent->add(makeElement<Label>(
+                    "Item " + std::to_string(serial), 0, 0, 0, 0, font));
+            } else {
+                parent->add(makeElement<Button>(
+                    "Button " + std::to_string(serial), 0, 0, 90, 24, font));
+            }
+        }
+    }
+
+    Scene buildNested(int depth, int fanout, TTF_Font *font) {
+        auto root = makeNestedLayout(0);
+        root->setFont(font);
+        int serial = 0;
+        fillNested(root, 0, std::max(1, depth), std::max(1, fanout), font,
+                   serial);
+        return {"nested", root, {}, 0, {}};
+    }
+
+    // Same tree as "nested" with every top-level panel cached in a layer
+    Scene buildLayered(int depth, int fanout, TTF_Font *font) {
+        Scene scene = buildNested(depth, fanout, font);
+        scene.name = "layered";
+        scene.resizes = false;
+        for (const auto &panel : scene.root->getChildren())
+            panel->setCachedLayer(true);
+        return scene;
+    }
+
+    Scene buildInputs(int count, TTF_Font *font) {
+        auto box = makeElement<VBoxLayout>(2);
+        box->setFont(font);
+        Scene scene{"inputs", box, {}, 0, {}};
+        for (int i = 0; i < count; ++i) {
+            auto input = makeElement<Input>(
+                "Input " + std::to_string(i), 0, 0, 240, 24, font);
+            box->add(input);
+            scene.inputs.push_back(input);
+        }
+        return scene;
+    }
+
+    // A list far larger than the viewport; only visible rows get widgets
+    Scene buildVirtual(int rows, TTF_Font *font) {
+        auto list = makeElement<VirtualListLayout>(20, 1, 0);
+        list->setFont(font);
+        list->setDataSource(
+            [font] { return makeElement<Label>("", 0, 0, 0, 0, font); },
+            [](Squidl::Base::UIElement &item, std::size_t index) {
+                static_cast<Label &>(item).setText("Row " +
+                                                   std::to_string(index));
+            });
+        list->setItemCount(static_cast<std::size_t>(std::max(0, rows)));
+        auto animate = [list](int frame) {
+            const int range = list->getMaxScrollOffset() + 1;
+            list->setScrollOffset((frame * 97) % range);
+        };
+        return {"virtual", list, {}, 0, animate};
+    }
+
+    // A regular stack of labels inside a ScrollView, scrolled every frame
+    Scene buildScroll(int count, TTF_Font *font) {
+        auto view = makeElement<ScrollView>(1, 0);
+        view->setFont(font);
+        view->setKineticScrolling(false);
+        for (int i = 0; i < count; ++i) {
+            view->add(makeElement<Label>("Row " + std::to_string(i), 0, 0, 0, 0,
+                                         font));
+        }
+        auto animate = [view](int frame) {
+            const int range = view->getMaxScrollOffset().y + 1;
+            view->setScrollOffset({0, (frame * 97) % range});
+        };
+        return {"scroll", view, {}, 0, animate};
+    }
+
+    // Toolbar-like grid of small images, all regions of one atlas page
+    Scene buildIcons(int count, Squidl::Renderers::TextureAtlas &atlas) {
+        constexpr int IconKinds = 64;
+        constexpr int IconSize = 24;
+        std::vector<Squidl::Renderers::AtlasRegion> icons;
+        SDL_Surface *pixels = SDL_CreateRGBSurfaceWithFormat(
+            0, IconSize, IconSize, 32, SDL_PIXELFORMAT_ARGB8888);
+        for (int i = 0; pixels && i < IconKinds; ++i) {
+            const Uint32 hue = static_cast<Uint32>(i) * 0x3A5F17u;
+            SDL_FillRect(pixels, nullptr, 0xFF000000u | (hue & 0xFFFFFFu));
+            const SDL_Rect inner{4 + i % 8, 4 + i / 8, 12, 12};
+            SDL_FillRect(pixels, &inner, 0xFFFFFFFFu);
+            icons.push_back(atlas.add("icon" + std::to_string(i), pixels));
+        }
+        if (pixels)
+            SDL_FreeSurface(pixels);
+
+        const int columns =
+            std::max(1, static_cast<int>(std::sqrt(static_cast<double>(count))));
+        auto grid = makeElement<GridLayout>(columns, 2, 2);
+        for (int i = 0; i < count; ++i) {
+            auto icon = makeElement<Backdrop>();
+            icon->setBorderless(true);
+            icon->setBackgroundColor({0, 0, 0, 0});
+            icon->setRect({0, 0, IconSize, IconSize});
+            if (!icons.empty() && icons[i % icons.size()]) {
+                const auto &region = icons[i % icons.size()];
+                icon->setTextureRegion(region.texture, region.rect);
+            }
+            grid->add(icon);
+        }
+        return {"icons", grid, {}, 0, {}};
+    }
+
+    // Registers the tree the same way UIManager::addUIElement does
+    void addListeners(EventDispatcher &dispatcher,
+                      const std::shared_ptr<Squidl::Base::UIElement> &e) {
+        dispatcher.addListener(e);
+        if (auto layout = std::dynamic_pointer_cast<Layout>(e)) {
+            for (const auto &child : layout->getChildren())
+                addListeners(dispatcher, child);
+        }
+    }
+
+    // ------------------------------------------------------------------
+    // Statistics
+    // ------------------------------------------------------------------
+    struct Series {
+        std::vector<double> samples; // Milliseconds
+
+        void add(Clock::duration d) {
+            samples.push_back(
+                std::chrono::duration<double, std::milli>(d).count());
+        }
+    };
+
+    void printSeries(const char *phase, Series series) {
+        if (series.samples.empty())
+            return;
+        double sum = 0.0;
+        for (double s : series.samples)
+            sum += s;
+        std::sort(series.samples.begin(), series.samples.end());
+        const auto at = [&](double q) {
+            const std::size_t idx = static_cast<std::size_t>(
+                q * static_cast<double>(series.samples.size() - 1) + 0.5);
+            return series.samples[idx];
+        };
+        std::printf("  %-8s mean %8.3f ms   p50 %8.3f ms   p95 %8.3f ms\n",
+                    phase, sum / series.samples.size(), at(0.50), at(0.95));
+    }
+
+    // ------------------------------------------------------------------
+    // Frame loop
+    // ------------------------------------------------------------------
+    void runScene(Scene &scene, const Options &opts, SDL_Renderer *sdlRenderer,
+                  UIContext &ctx) {
+        scene.elementCount = countElements(scene.root);
+
+        Squidl::Renderers::SDL2Renderer backend(sdlRenderer);
+        SquidlBench::TimingRenderer renderer(backend);
+        EventDispatcher dispatcher;
+        addListeners(dispatcher, scene.root);
+
+        Series layout, events, draw, text;
+        std::size_t allocations = 0;
+        std::size_t drawCalls = 0;
+        std::size_t textCalls = 0;
+        const Color clearColor(20, 20, 20, 255);
+        const int total = opts.warmup + opts.frames;
+        std::size_t batchStart = 0;
+        const int W = opts.width;
+        const int H = opts.height;
+
+        for (int frame = 0; frame < total; ++frame) {
+            const bool measured = frame >= opts.warmup;
+            if (!opts.trace.empty())
+                Profiler::setEnabled(measured);
+            if (frame == opts.warmup)
+                batchStart = backend.getQuadBatch().getStats().drawCalls;
+            const std::size_t allocStart = g_allocations.load();
+            ctx.beginFrame();
+
+            // Layout: alternate the viewport width so every frame has real
+            // arrangement work, as during an interactive window resize
+            auto t0 = Clock::now();
+            scene.root->measure();
+            scene.root->setRect({0, 0, W - (scene.resizes ? frame & 1 : 0), H});
+            auto t1 = Clock::now();
+
+            // Events: a sweep of mouse moves across the viewport, plus text
+            // typed into a rotating focused Input
+            for (int i = 0; i < 16; ++i) {
+                const int x = ((frame * 16 + i) * 37) % W;
+                const int y = ((frame * 16 + i) * 23) % H;
+                ctx.mouseX = x;
+                ctx.mouseY = y;
+                MouseEvent move(MouseEventType::Moved, x, y);
+                dispatcher.dispatchEvent(move);
+            }
+            if (scene.animate)
+                scene.animate(frame);
+            if (!scene.inputs.empty()) {
+                dispatcher.setFocus(
+                    scene.inputs[frame % scene.inputs.size()]);
+                TextInputEvent typed("x");
+                dispatcher.dispatchEvent(typed);
+                if (frame % 8 == 7) {
+                    KeyboardEvent back(SDL_SCANCODE_BACKSPACE, KMOD_NONE,
+                                       true);
+                    dispatcher.dispatchEvent(back);
+                }
+            }
+            auto t2 = Clock::now();
+
+            // Draw: the full tree through the timing decorator
+            renderer.beginFrame();
+            renderer.clearScreen(clearColor);
+            scene.root->draw(ctx, renderer);
+            renderer.flush();
+            SDL_RenderPresent(sdlRenderer);
+            auto t3 = Clock::now();
+
+            if (measured) {
+                layout.add(t1 - t0);
+                events.add(t2 - t1);
+                // Text is reported on its own, the draw phase excludes it
+                draw.add((t3 - t2) - renderer.getTextTime());
+                text.add(renderer.getTextTime());
+                drawCalls += renderer.getDrawCalls();
+                textCalls += renderer.getTextCalls();
+                allocations += g_allocations.load() - allocStart;
+            }
+        }
+
+        const double frames = static_cast<double>(opts.frames);
+        std::printf("\n[%s] %zu elements, %d frames (%d warm-up), %dx%d\n",
+                    scene.name.c_str(), scene.elementCount, opts.frames,
+                    opts.warmup, W, H);
+        printSeries("layout", layout);
+        printSeries("events", events);
+        printSeries("draw", draw);
+        printSeries("text", text);
+        const std::size_t batches =
+            backend.getQuadBatch().getStats().drawCalls - batchStart;
+        std::printf("  draw calls/frame %.1f (%.1f shape batches), text "
+                    "calls/frame %.1f, allocations/frame %.1f\n",
+                    drawCalls / frames, batches / frames, textCalls / frames,
+                    allocations / frames);
+    }
+
+} // namespace
+
+int main(int argc, char **argv) {
+    Options opts;
+    if (!parseArgs(argc, argv, opts))
+        return 1;
+
+    // No window is ever shown; the dummy driver makes the benchmark usable
+    // on CI machines without a display
+    SDL_SetHint(SDL_HINT_VIDEODRIVER, "dummy");
+    if (SDL_Init(SDL_INIT_VIDEO) != 0) {
+        std::cerr << "SDL_Init failed: " << SDL_GetError() << "\n";
+        return 1;
+    }
+    if (TTF_Init() != 0) {
+        std::cerr << "TTF_Init failed: " << TTF_GetError() << "\n";
+        SDL_Quit();
+        return 1;
+    }
+
+    SDL_Surface *surface = SDL_CreateRGBSurfaceWithFormat(
+        0, opts.width, opts.height, 32, SDL_PIXELFORMAT_ARGB8888);
+    SDL_Renderer *sdlRenderer =
+        surface ? SDL_CreateSoftwareRenderer(surface) : nullptr;
+    if (!sdlRenderer) {
+        std::cerr << "Failed to create software renderer: " << SDL_GetError()
+                  << "\n";
+        if (surface)
+            SDL_FreeSurface(surface);
+        TTF_Quit();
+        SDL_Quit();
+        return 1;
+    }
+    SDL_SetRenderDrawBlendMode(sdlRenderer, SDL_BLENDMODE_BLEND);
+
+    TTF_Font *font = TTF_OpenFont(opts.font.c_str(), 16);
+    if (!font) {
+        std::cerr << "Failed to load font: " << TTF_GetError() << "\n";
+        SDL_DestroyRenderer(sdlRenderer);
+        SDL_FreeSurface(surface);
+        TTF_Quit();
+        SDL_Quit();
+        return 1;
+    }
+
+    // Element logging would dominate the event phase
+    Logger::setLogLevel(LogLevel::Error);
+
+    UIContext ctx;
+    ctx.setSize(opts.width, opts.height);
+
+    std::printf("SquidlBench: software renderer, %dx%d\n", opts.width,
+                opts.height);
+    {
+        // Builders use makeElement, so the scope decides where elements go
+        auto arena = ElementArena::create();
+        std::unique_ptr<ElementArena::Scope> arenaScope;
+        if (opts.arena)
+            arenaScope = std::make_unique<ElementArena::Scope>(*arena);
+        // Declared before the scenes so their icons go first
+        Squidl::Renderers::TextureAtlas atlas(sdlRenderer);
+        const std::size_t buildAllocs = g_allocations.load();
+        const auto buildStart = Clock::now();
+
+        std::vector<Scene> scenes;
+        if (opts.scene == "all" || opts.scene == "labels")
+            scenes.push_back(buildLabels(opts.labels, font));
+        if (opts.scene == "all" || opts.scene == "flat")
+            scenes.push_back(buildFlat(opts.labels, font));
+        if (opts.scene == "all" || opts.scene == "nested")
+            scenes.push_back(buildNested(opts.depth, opts.fanout, font));
+        if (opts.scene == "all" || opts.scene == "layered")
+            scenes.push_back(buildLayered(opts.depth, opts.fanout, font));
+        if (opts.scene == "all" || opts.scene == "inputs")
+            scenes.push_back(buildInputs(opts.inputs, font));
+        if (opts.scene == "all" || opts.scene == "virtual")
+            scenes.push_back(buildVirtual(opts.rows, font));
+        if (opts.scene == "all" || opts.scene == "scroll")
+            scenes.push_back(buildScroll(opts.labels, font));
+        if (opts.scene == "all" || opts.scene == "icons")
+            scenes.push_back(buildIcons(opts.labels, atlas));
+        if (scenes.empty()) {
+            std::cerr << "Unknown scene " << opts.scene << "\n";
+        }
+        arenaScope.reset();
+        std::printf(
+            "build (%s): %.3f ms, %zu allocations\n",
+            opts.arena ? "arena" : "heap",
+            std::chrono::duration<double, std::milli>(Clock::now() - buildStart)
+                .count(),
+            g_allocations.load() - buildAllocs);
+        if (opts.arena)
+            std::printf("arena: %zu blocks, %zu KiB reserved, %zu KiB in use\n",
+                        arena->getBlockCount(),
+                        arena->getBytesReserved() / 1024,
+                        arena->getBytesInUse() / 1024);
+        if (!opts.trace.empty())
+            Profiler::setCapacity(std::size_t(1) << 20);
+        for (auto &scene : scenes)
+            runScene(scene, opts, sdlRenderer, ctx);
+        Profiler::setEnabled(false);
+        if (!opts.trace.empty() && !Profiler::writeChromeTrace(opts.trace))
+            std::cerr << "Failed to write trace " << opts.trace << "\n";
+    } // Elements may own textures; release them before the renderer
+
+    TTF_CloseFont(font);
+    SDL_DestroyRenderer(sdlRenderer);
+    SDL_FreeSurface(surface);
+    TTF_Quit();
+    SDL_Quit();
+    return 0;
+}
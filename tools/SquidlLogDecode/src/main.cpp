@@ -0,0 +1,228 @@
+// tools/SquidlLogDecode/src/main.cpp
+//
+// Decodes a binary log written by Squidl::Utils::BinaryLogSink into text.
+//
+// Usage:
+//   SquidlLogDecode <file> [--min-level DEBUG|INFO|WARNING|ERROR|FATAL]
+//                   [--no-location]
+//
+// Only the format headers are used, so the tool does not depend on SDL or
+// the Squidl library itself.
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Squidl/utils/BinaryLogFormat.h"
+#include "Squidl/utils/LogArgs.h"
+
+using namespace Squidl::Utils;
+using namespace Squidl::Utils::BinaryLog;
+
+namespace {
+
+    const char *const LevelNames[] = {"DEBUG", "INFO", "WARNING", "ERROR",
+                                      "FATAL"};
+    constexpr int LevelCount = 5;
+
+    struct Location {
+        std::string file;
+        std::uint32_t line = 0;
+    };
+
+    struct Options {
+        std::string path;
+        int minLevel = 0;
+        bool showLocation = true;
+    };
+
+    bool parseArgs(int argc, char **argv, Options &opts) {
+        for (int i = 1; i < argc; ++i) {
+            const std::string arg = argv[i];
+            if (arg == "--no-location") {
+                opts.showLocation = false;
+            } else if (arg == "--min-level" && i + 1 < argc) {
+                const std::string level = argv[++i];
+                opts.minLevel = -1;
+                for (int l = 0; l < LevelCount; ++l) {
+                    if (level == LevelNames[l])
+                        opts.minLevel = l;
+                }
+                if (opts.minLevel < 0) {
+                    std::cerr << "Unknown level " << level << "\n";
+                    return false;
+                }
+            } else if (opts.path.empty() && arg[0] != '-') {
+                opts.path = arg;
+            } else {
+                std::cerr << "Unknown option " << arg << "\n";
+                return false;
+            }
+        }
+        if (opts.path.empty()) {
+            std::cerr << "Usage: SquidlLogDecode <file> [--min-level LEVEL] "
+                         "[--no-location]\n";
+            return false;
+        }
+        return true;
+    }
+
+    std::string formatTimestamp(std::uint64_t ns) {
+        const std::time_t seconds = static_cast<std::time_t>(ns / 1000000000u);
+        const unsigned millis =
+            static_cast<unsigned>((ns / 1000000u) % 1000u);
+        std::tm tm{};
+#ifdef _WIN32
+        localtime_s(&tm, &seconds);
+#else
+        localtime_r(&seconds, &tm);
+#endif
+        char buffer[40];
+        const std::size_t n =
+            std::strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S", &tm);
+        std::snprintf(buffer + n, sizeof(buffer) - n, ".%03u", millis);
+        return buffer;
+    }
+
+    std::unordered_map<std::uint32_t, Location>
+    readLocations(const std::vector<std::uint8_t> &file,
+                  const FileHeader &header) {
+        std::unordered_map<std::uint32_t, Location> locations;
+        const std::uint8_t *table = file.data() + header.locationsOffset;
+        std::uint64_t pos = 0;
+        while (pos + sizeof(LocationEntry) <= header.locationsUsed) {
+            LocationEntry entry;
+            std::memcpy(&entry, table + pos, sizeof(entry));
+            if (pos + sizeof(entry) + entry.fileLength > header.locationsUsed)
+                break;
+            Location &loc = locations[entry.id];
+            loc.file.assign(
+                reinterpret_cast<const char *>(table + pos + sizeof(entry)),
+                entry.fileLength);
+            loc.line = entry.line;
+            pos += alignUp(sizeof(entry) + entry.fileLength, 4);
+        }
+        return locations;
+    }
+
+    bool readRecord(const std::uint8_t *ring, std::uint64_t ringSize,
+                    std::uint64_t offset, RecordHeader &out) {
+        if (offset + sizeof(RecordHeader) > ringSize)
+            return false;
+        std::memcpy(&out, ring + offset, sizeof(out));
+        if (out.magic != RecordMagic)
+            return false;
+        if (out.size == 0)
+            return true; // End-of-ring marker
+        return out.size % RecordAlignment == 0 &&
+               out.size >= sizeof(RecordHeader) + out.argsSize &&
+               offset + out.size <= ringSize && out.level < LevelCount;
+    }
+
+} // namespace
+
+int main(int argc, char **argv) {
+    Options opts;
+    if (!parseArgs(argc, argv, opts))
+        return 1;
+
+    std::ifstream in(opts.path, std::ios::binary);
+    if (!in) {
+        std::cerr << "Failed to open " << opts.path << "\n";
+        return 1;
+    }
+    const std::vector<std::uint8_t> file(
+        (std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+    FileHeader header;
+    if (file.size() < sizeof(header)) {
+        std::cerr << "Not a Squidl binary log: file too small\n";
+        return 1;
+    }
+    std::memcpy(&header, file.data(), sizeof(header));
+    if (std::memcmp(header.magic, FileMagic, sizeof(FileMagic)) != 0) {
+        std::cerr << "Not a Squidl binary log: bad magic\n";
+        return 1;
+    }
+    if (header.version != FormatVersion) {
+        std::cerr << "Unsupported format version " << header.version << "\n";
+        return 1;
+    }
+    if (header.locationsOffset + header.locationsSize > file.size() ||
+        header.locationsUsed > header.locationsSize ||
+        header.ringOffset + header.ringSize > file.size() ||
+        header.writeOffset > header.ringSize) {
+        std::cerr << "Corrupt header\n";
+        return 1;
+    }
+
+    const auto locations = readLocations(file, header);
+    const std::uint8_t *ring = file.data() + header.ringOffset;
+
+    std::uint64_t printed = 0;
+    std::uint64_t decoded = 0;
+    std::string line;
+    auto decodeRange = [&](std::uint64_t begin, std::uint64_t end,
+                           bool resync) {
+        std::uint64_t offset = begin;
+        RecordHeader record;
+        // Right after the write position the oldest record may have been
+        // partly overwritten: skip ahead to the first intact one
+        if (resync) {
+            while (offset < end &&
+                   !readRecord(ring, header.ringSize, offset, record))
+                offset += RecordAlignment;
+        }
+        while (offset < end &&
+               readRecord(ring, header.ringSize, offset, record)) {
+            if (record.size == 0)
+                break;
+            ++decoded;
+            if (record.level >= opts.minLevel) {
+                line.clear();
+                line += '[';
+                line += formatTimestamp(record.timestampNs);
+                line += "] [";
+                line += LevelNames[record.level];
+                line += "] [T";
+                line += std::to_string(record.thread);
+                line += "] ";
+                if (opts.showLocation && record.locationId != 0) {
+                    auto it = locations.find(record.locationId);
+                    if (it != locations.end()) {
+                        line += it->second.file;
+                        line += ':';
+                        line += std::to_string(it->second.line);
+                    } else {
+                        char id[16];
+                        std::snprintf(id, sizeof(id), "#%08x",
+                                      record.locationId);
+                        line += id;
+                    }
+                    line += ": ";
+                }
+                if (!LogArgs::format(ring + offset + sizeof(RecordHeader),
+                                     record.argsSize, line))
+                    line += " <corrupt arguments>";
+                std::cout << line << '\n';
+                ++printed;
+            }
+            offset += record.size;
+        }
+    };
+
+    if (header.wrapCount > 0)
+        decodeRange(header.writeOffset, header.ringSize, true);
+    decodeRange(0, header.writeOffset, false);
+
+    std::cerr << decoded << " records decoded (" << printed << " shown), "
+              << header.recordCount << " written, " << header.droppedCount
+              << " dropped as too large, " << header.wrapCount << " wraps\n";
+    return 0;
+}
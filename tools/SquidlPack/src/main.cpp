@@ -0,0 +1,178 @@
+// tools/SquidlPack/src/main.cpp
+//
+// Packs a directory of assets into a single archive for
+// Squidl::Managers::ResourceManager.
+//
+// Usage:
+//   SquidlPack <directory> <output> [--prefix PREFIX]
+//
+// Every regular file under the directory is stored under its relative path
+// with '/' separators, preceded by PREFIX (e.g. "assets/" so the archive
+// serves the same paths as the loose files). Only the format header is
+// used, so the tool does not depend on SDL or the Squidl library itself.
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "Squidl/utils/PackFormat.h"
+
+using namespace Squidl::Utils::Pack;
+namespace fs = std::filesystem;
+
+namespace {
+
+    struct Options {
+        std::string directory;
+        std::string output;
+        std::string prefix;
+    };
+
+    struct Asset {
+        fs::path source;
+        std::string path; // Stored path
+        std::uint64_t size = 0;
+        std::uint64_t offset = 0;
+    };
+
+    bool parseArgs(int argc, char **argv, Options &opts) {
+        for (int i = 1; i < argc; ++i) {
+            const std::string arg = argv[i];
+            if (arg == "--prefix" && i + 1 < argc) {
+                opts.prefix = argv[++i];
+            } else if (opts.directory.empty() && arg[0] != '-') {
+                opts.directory = arg;
+            } else if (opts.output.empty() && arg[0] != '-') {
+                opts.output = arg;
+            } else {
+                std::cerr << "Unknown option " << arg << "\n";
+                return false;
+            }
+        }
+        if (opts.directory.empty() || opts.output.empty()) {
+            std::cerr << "Usage: SquidlPack <directory> <output> "
+                         "[--prefix PREFIX]\n";
+            return false;
+        }
+        return true;
+    }
+
+    bool collect(const Options &opts, std::vector<Asset> &assets) {
+        std::error_code ec;
+        fs::recursive_directory_iterator it(opts.directory, ec);
+        if (ec) {
+            std::cerr << "Failed to read " << opts.directory << ": "
+                      << ec.message() << "\n";
+            return false;
+        }
+        const fs::path output = fs::weakly_canonical(opts.output, ec);
+        for (const fs::directory_entry &entry : it) {
+            if (!entry.is_regular_file())
+                continue;
+            // The archive may be written into the directory it packs
+            if (fs::weakly_canonical(entry.path(), ec) == output)
+                continue;
+            Asset asset;
+            asset.source = entry.path();
+            asset.path =
+                opts.prefix +
+                entry.path().lexically_relative(opts.directory).generic_string();
+            asset.size = entry.file_size();
+            assets.push_back(std::move(asset));
+        }
+        // A stable order keeps archives reproducible
+        std::sort(assets.begin(), assets.end(),
+                  [](const Asset &a, const Asset &b) { return a.path < b.path; });
+        return true;
+    }
+
+    void writePadding(std::ofstream &out, std::uint64_t from,
+                      std::uint64_t to) {
+        static const char zeros[DataAlignment] = {};
+        while (from < to) {
+            const std::uint64_t n =
+                std::min<std::uint64_t>(to - from, sizeof(zeros));
+            out.write(zeros, static_cast<std::streamsize>(n));
+            from += n;
+        }
+    }
+
+} // namespace
+
+int main(int argc, char **argv) {
+    Options opts;
+    if (!parseArgs(argc, argv, opts))
+        return 1;
+
+    std::vector<Asset> assets;
+    if (!collect(opts, assets))
+        return 1;
+
+    // Lay out the index first, then the aligned file data
+    std::uint64_t indexSize = 0;
+    for (const Asset &asset : assets)
+        indexSize += alignUp(sizeof(IndexEntry) + asset.path.size(),
+                             IndexAlignment);
+    std::uint64_t offset =
+        alignUp(sizeof(FileHeader) + indexSize, DataAlignment);
+    for (Asset &asset : assets) {
+        asset.offset = offset;
+        offset = alignUp(offset + asset.size, DataAlignment);
+    }
+
+    FileHeader header{};
+    std::memcpy(header.magic, FileMagic, sizeof(FileMagic));
+    header.version = FormatVersion;
+    header.headerSize = sizeof(FileHeader);
+    header.fileSize = offset;
+    header.entryCount = assets.size();
+    header.indexOffset = sizeof(FileHeader);
+    header.indexSize = indexSize;
+
+    std::ofstream out(opts.output, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        std::cerr << "Failed to create " << opts.output << "\n";
+        return 1;
+    }
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    std::uint64_t written = sizeof(header);
+    for (const Asset &asset : assets) {
+        IndexEntry entry{};
+        entry.offset = asset.offset;
+        entry.size = asset.size;
+        entry.pathLength = static_cast<std::uint32_t>(asset.path.size());
+        out.write(reinterpret_cast<const char *>(&entry), sizeof(entry));
+        out.write(asset.path.data(),
+                  static_cast<std::streamsize>(asset.path.size()));
+        const std::uint64_t end = written + sizeof(entry) + asset.path.size();
+        writePadding(out, end, alignUp(end, IndexAlignment));
+        written = alignUp(end, IndexAlignment);
+    }
+
+    for (const Asset &asset : assets) {
+        writePadding(out, written, asset.offset);
+        std::ifstream in(asset.source, std::ios::binary);
+        const std::vector<char> data((std::istreambuf_iterator<char>(in)),
+                                     std::istreambuf_iterator<char>());
+        if (!in || data.size() != asset.size) {
+            std::cerr << "Failed to read " << asset.source.string() << "\n";
+            return 1;
+        }
+        out.write(data.data(), static_cast<std::streamsize>(data.size()));
+        written = asset.offset + asset.size;
+    }
+    writePadding(out, written, header.fileSize);
+
+    if (!out) {
+        std::cerr << "Failed to write " << opts.output << "\n";
+        return 1;
+    }
+    std::cout << "Packed " << assets.size() << " files into " << opts.output
+              << " (" << header.fileSize << " bytes)\n";
+    return 0;
+}